@@ -0,0 +1,173 @@
+use std::thread;
+
+use criterion::{criterion_group, criterion_main, BenchmarkId, Criterion, Throughput};
+use duckdb::types::{TimeUnit, Value, ValueRef};
+use duckdb::{params, Connection};
+use rust_decimal::Decimal;
+
+const ROWS: u64 = 1_000_000;
+
+// Appending row by row makes a call into DuckDB for every value, appending
+// columns copies a vector of values at a time into a data chunk.
+fn bench_numeric(c: &mut Criterion) {
+    let db = Connection::open_in_memory().unwrap();
+    db.execute_batch("CREATE TABLE t(a BIGINT, b DOUBLE, c INTEGER)")
+        .unwrap();
+    let a: Vec<i64> = (0..ROWS as i64).collect();
+    let b: Vec<f64> = a.iter().map(|&i| i as f64 / 2.0).collect();
+    let nullable: Vec<Option<i32>> = a
+        .iter()
+        .map(|&i| if i % 10 == 0 { None } else { Some(i as i32) })
+        .collect();
+
+    let mut group = c.benchmark_group("append_numeric");
+    group.throughput(Throughput::Elements(ROWS));
+    group.sample_size(10);
+    group.bench_function("append_rows", |bencher| {
+        bencher.iter(|| {
+            db.execute_batch("DELETE FROM t").unwrap();
+            let mut app = db.appender("t").unwrap();
+            for i in 0..ROWS as usize {
+                app.append_row(params![a[i], b[i], nullable[i]]).unwrap();
+            }
+        })
+    });
+    group.bench_function("append_columns", |bencher| {
+        bencher.iter(|| {
+            db.execute_batch("DELETE FROM t").unwrap();
+            let mut app = db.appender("t").unwrap();
+            app.append_columns(&[&a, &b, &nullable]).unwrap();
+        })
+    });
+    group.finish();
+}
+
+// Strings up to 12 bytes are inlined in the vector, longer ones are copied to
+// its string heap unless they are borrowed: cover both.
+fn bench_strings(c: &mut Criterion) {
+    let db = Connection::open_in_memory().unwrap();
+    db.execute_batch("CREATE TABLE t(id BIGINT, short VARCHAR, long VARCHAR)")
+        .unwrap();
+    let ids: Vec<i64> = (0..ROWS as i64).collect();
+    let short: Vec<String> = ids.iter().map(|i| format!("k{}", i)).collect();
+    let long: Vec<Option<String>> = ids
+        .iter()
+        .map(|i| {
+            if i % 10 == 0 {
+                None
+            } else {
+                Some(format!("a longer value for row {}", i))
+            }
+        })
+        .collect();
+
+    let mut group = c.benchmark_group("append_strings");
+    group.throughput(Throughput::Elements(ROWS));
+    group.sample_size(10);
+    group.bench_function("append_rows", |bencher| {
+        bencher.iter(|| {
+            db.execute_batch("DELETE FROM t").unwrap();
+            let mut app = db.appender("t").unwrap();
+            for i in 0..ROWS as usize {
+                app.append_row(params![ids[i], short[i], long[i]]).unwrap();
+            }
+        })
+    });
+    group.bench_function("append_rows_borrowed", |bencher| {
+        bencher.iter(|| {
+            db.execute_batch("DELETE FROM t").unwrap();
+            let mut app = db.appender("t").unwrap();
+            app.append_rows_borrowed((0..ROWS as usize).map(|i| {
+                [
+                    ValueRef::BigInt(ids[i]),
+                    ValueRef::from(short[i].as_str()),
+                    long[i].as_deref().map_or(ValueRef::Null, ValueRef::from),
+                ]
+            }))
+            .unwrap();
+        })
+    });
+    group.bench_function("append_columns", |bencher| {
+        bencher.iter(|| {
+            db.execute_batch("DELETE FROM t").unwrap();
+            let mut app = db.appender("t").unwrap();
+            app.append_columns(&[&ids, &short, &long]).unwrap();
+        })
+    });
+    group.finish();
+}
+
+// Timestamps and decimals appended as strings are parsed by DuckDB for every
+// row, native values are stored as they are or cast without parsing.
+fn bench_temporal(c: &mut Criterion) {
+    let db = Connection::open_in_memory().unwrap();
+    db.execute_batch("CREATE TABLE t(ts TIMESTAMP, amount DECIMAL(18, 2))")
+        .unwrap();
+    let millis: Vec<i64> = (0..ROWS as i64).map(|i| 1_649_519_797_000 + i).collect();
+    let amounts: Vec<Decimal> = (0..ROWS as i64).map(|i| Decimal::new(i, 2)).collect();
+    let ts_strings: Vec<String> = db
+        .prepare("SELECT epoch_ms(1649519797000 + range)::VARCHAR FROM range(?)")
+        .unwrap()
+        .query_map([ROWS as i64], |row| row.get(0))
+        .unwrap()
+        .collect::<Result<_, _>>()
+        .unwrap();
+    let amount_strings: Vec<String> = amounts.iter().map(|d| d.to_string()).collect();
+
+    let mut group = c.benchmark_group("append_temporal");
+    group.throughput(Throughput::Elements(ROWS));
+    group.sample_size(10);
+    group.bench_function("strings", |bencher| {
+        bencher.iter(|| {
+            db.execute_batch("DELETE FROM t").unwrap();
+            let mut app = db.appender("t").unwrap();
+            for i in 0..ROWS as usize {
+                app.append_row(params![ts_strings[i], amount_strings[i]]).unwrap();
+            }
+        })
+    });
+    group.bench_function("native", |bencher| {
+        bencher.iter(|| {
+            db.execute_batch("DELETE FROM t").unwrap();
+            let mut app = db.appender("t").unwrap();
+            for i in 0..ROWS as usize {
+                let ts = Value::Timestamp(TimeUnit::Millisecond, millis[i]);
+                app.append_row(params![ts, amounts[i]]).unwrap();
+            }
+        })
+    });
+    group.finish();
+}
+
+// Every thread fills its own local appender, only the commit appends to the
+// table: ingest should scale with the number of threads.
+fn bench_parallel(c: &mut Criterion) {
+    let db = Connection::open_in_memory().unwrap();
+    db.execute_batch("CREATE TABLE t(id BIGINT, name VARCHAR)").unwrap();
+    let ids: Vec<i64> = (0..ROWS as i64 * 4).collect();
+    let names: Vec<String> = ids.iter().map(|i| format!("name of row {}", i)).collect();
+
+    let mut group = c.benchmark_group("append_parallel");
+    group.throughput(Throughput::Elements(ids.len() as u64));
+    group.sample_size(10);
+    for threads in [1usize, 2, 4, 8] {
+        group.bench_with_input(BenchmarkId::from_parameter(threads), &threads, |bencher, &threads| {
+            let part = ids.len() / threads;
+            bencher.iter(|| {
+                db.execute_batch("DELETE FROM t").unwrap();
+                let parallel = db.parallel_appender("t").unwrap();
+                thread::scope(|s| {
+                    for (ids, names) in ids.chunks(part).zip(names.chunks(part)) {
+                        let mut app = parallel.appender().unwrap();
+                        s.spawn(move || app.append_columns(&[&ids, &names]).unwrap());
+                    }
+                });
+                parallel.commit().unwrap();
+            })
+        });
+    }
+    group.finish();
+}
+
+criterion_group!(benches, bench_numeric, bench_strings, bench_temporal, bench_parallel);
+criterion_main!(benches);
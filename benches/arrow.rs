@@ -0,0 +1,67 @@
+use arrow::array::{Array, Int64Array};
+use criterion::{black_box, criterion_group, criterion_main, BenchmarkId, Criterion, Throughput};
+use duckdb::Connection;
+
+const ROWS: u64 = 4_000_000;
+
+// Bigger batches trade memory for fewer round trips through the Arrow export
+// and fewer arrays for the consumer to walk.
+fn bench_batch_size(c: &mut Criterion) {
+    let db = Connection::open_in_memory().unwrap();
+    let sql = format!("SELECT i FROM range(0, {}) t(i)", ROWS);
+
+    let mut group = c.benchmark_group("arrow_batch_size");
+    group.throughput(Throughput::Elements(ROWS));
+    group.sample_size(10);
+    for batch_size in [1024usize, 16 * 1024, 64 * 1024, 1024 * 1024] {
+        group.bench_with_input(
+            BenchmarkId::from_parameter(batch_size),
+            &batch_size,
+            |b, &batch_size| {
+                let mut stmt = db.prepare(&sql).unwrap();
+                stmt.set_arrow_batch_size(batch_size);
+                b.iter(|| {
+                    let mut sum = 0i64;
+                    for rb in stmt.query_arrow([]).unwrap() {
+                        let column = rb.column(0).as_any().downcast_ref::<Int64Array>().unwrap();
+                        sum += column.values().iter().sum::<i64>();
+                    }
+                    black_box(sum)
+                })
+            },
+        );
+    }
+    group.finish();
+}
+
+// The parallel export converts a materialized result on the DuckDB worker
+// threads, the plain one streams it through the calling thread.
+fn bench_parallel_export(c: &mut Criterion) {
+    let db = Connection::open_in_memory().unwrap();
+    let sql = format!("SELECT i, i * 2 AS j, i::VARCHAR AS s FROM range(0, {}) t(i)", ROWS);
+
+    let mut group = c.benchmark_group("arrow_export");
+    group.throughput(Throughput::Elements(ROWS));
+    group.sample_size(10);
+    group.bench_function("query_arrow", |b| {
+        let mut stmt = db.prepare(&sql).unwrap();
+        stmt.set_arrow_batch_size(64 * 1024);
+        b.iter(|| black_box(stmt.query_arrow([]).unwrap().map(|rb| rb.num_rows()).sum::<usize>()))
+    });
+    group.bench_function("query_arrow_parallel", |b| {
+        let mut stmt = db.prepare(&sql).unwrap();
+        stmt.set_arrow_batch_size(64 * 1024);
+        b.iter(|| {
+            black_box(
+                stmt.query_arrow_parallel([])
+                    .unwrap()
+                    .map(|rb| rb.num_rows())
+                    .sum::<usize>(),
+            )
+        })
+    });
+    group.finish();
+}
+
+criterion_group!(benches, bench_batch_size, bench_parallel_export);
+criterion_main!(benches);
@@ -0,0 +1,109 @@
+use arrow::array::{Array, Int64Array};
+use criterion::{black_box, criterion_group, criterion_main, Criterion, Throughput};
+use duckdb::{ColumnHandle, Connection};
+
+const ROWS: u64 = 1_000_000;
+
+// Reading row by row should only add a small constant over reading whole
+// batches: the per-batch work is amortized over the vector size.
+fn bench_rows(c: &mut Criterion) {
+    let db = Connection::open_in_memory().unwrap();
+    let sql = format!("SELECT i FROM range(0, {}) t(i)", ROWS);
+
+    let mut group = c.benchmark_group("rows");
+    group.throughput(Throughput::Elements(ROWS));
+    group.bench_function("row_at_a_time", |b| {
+        let mut stmt = db.prepare(&sql).unwrap();
+        b.iter(|| {
+            let mut rows = stmt.query([]).unwrap();
+            let mut sum = 0i64;
+            while let Some(row) = rows.next().unwrap() {
+                sum += row.get::<_, i64>(0).unwrap();
+            }
+            black_box(sum)
+        })
+    });
+    group.bench_function("query_columns", |b| {
+        let mut stmt = db.prepare(&sql).unwrap();
+        b.iter(|| {
+            let (values,): (Vec<i64>,) = stmt.query_columns([]).unwrap();
+            black_box(values.iter().sum::<i64>())
+        })
+    });
+    group.bench_function("record_batch", |b| {
+        let mut stmt = db.prepare(&sql).unwrap();
+        b.iter(|| {
+            let mut sum = 0i64;
+            for rb in stmt.query_arrow([]).unwrap() {
+                let column = rb.column(0).as_any().downcast_ref::<Int64Array>().unwrap();
+                sum += column.values().iter().sum::<i64>();
+            }
+            black_box(sum)
+        })
+    });
+    group.finish();
+}
+
+const WIDE_ROWS: u64 = 100_000;
+const WIDE_COLUMNS: usize = 128;
+
+// Every cell of a wide scan goes through `Row::get`, so this is dominated by
+// the cost of resolving a column to its concrete array, and by the name lookup
+// when reading by name.
+fn bench_wide_scan(c: &mut Criterion) {
+    let db = Connection::open_in_memory().unwrap();
+    let columns: Vec<String> = (0..WIDE_COLUMNS).map(|i| format!("i + {} AS c{}", i, i)).collect();
+    let sql = format!("SELECT {} FROM range(0, {}) t(i)", columns.join(", "), WIDE_ROWS);
+
+    let mut group = c.benchmark_group("wide_scan");
+    group.throughput(Throughput::Elements(WIDE_ROWS * WIDE_COLUMNS as u64));
+    group.sample_size(10);
+    group.bench_function("get_i64", |b| {
+        let mut stmt = db.prepare(&sql).unwrap();
+        b.iter(|| {
+            let mut rows = stmt.query([]).unwrap();
+            let mut sum = 0i64;
+            while let Some(row) = rows.next().unwrap() {
+                for col in 0..WIDE_COLUMNS {
+                    sum += row.get::<_, i64>(col).unwrap();
+                }
+            }
+            black_box(sum)
+        })
+    });
+    let names: Vec<String> = (0..WIDE_COLUMNS).map(|i| format!("c{}", i)).collect();
+    group.bench_function("get_i64_by_name", |b| {
+        let mut stmt = db.prepare(&sql).unwrap();
+        b.iter(|| {
+            let mut rows = stmt.query([]).unwrap();
+            let mut sum = 0i64;
+            while let Some(row) = rows.next().unwrap() {
+                for name in &names {
+                    sum += row.get::<_, i64>(name.as_str()).unwrap();
+                }
+            }
+            black_box(sum)
+        })
+    });
+    group.bench_function("get_i64_by_handle", |b| {
+        let mut stmt = db.prepare(&sql).unwrap();
+        b.iter(|| {
+            let mut rows = stmt.query([]).unwrap();
+            let handles: Vec<ColumnHandle> = names
+                .iter()
+                .map(|name| rows.as_ref().unwrap().column_handle(name).unwrap())
+                .collect();
+            let mut sum = 0i64;
+            while let Some(row) = rows.next().unwrap() {
+                for handle in &handles {
+                    sum += row.get::<_, i64>(*handle).unwrap();
+                }
+            }
+            black_box(sum)
+        })
+    });
+    group.finish();
+}
+
+criterion_group!(benches, bench_rows, bench_wide_scan);
+criterion_main!(benches);
@@ -62,8 +62,10 @@ mod build_bundled {
         }
         println!("cargo:rerun-if-changed={}/duckdb.hpp", lib_name);
         println!("cargo:rerun-if-changed={}/duckdb.cpp", lib_name);
+        println!("cargo:rerun-if-changed={}/capi_ext.cpp", lib_name);
         let mut cfg = cc::Build::new();
         cfg.file(format!("{}/duckdb.cpp", lib_name))
+            .file(format!("{}/capi_ext.cpp", lib_name))
             .cpp(true)
             .flag_if_supported("-std=c++11")
             .flag_if_supported("-stdlib=libc++")
@@ -15677,6 +15677,95 @@ fn bindgen_test_layout_duckdb_blob() {
 }
 #[repr(C)]
 #[derive(Debug, Copy, Clone)]
+pub struct duckdb_appender_flush_stats {
+    pub flushes: idx_t,
+    pub rows: idx_t,
+    pub bytes: idx_t,
+    pub micros: idx_t,
+}
+#[test]
+fn bindgen_test_layout_duckdb_appender_flush_stats() {
+    assert_eq!(
+        ::std::mem::size_of::<duckdb_appender_flush_stats>(),
+        32usize,
+        concat!("Size of: ", stringify!(duckdb_appender_flush_stats))
+    );
+    assert_eq!(
+        ::std::mem::align_of::<duckdb_appender_flush_stats>(),
+        8usize,
+        concat!("Alignment of ", stringify!(duckdb_appender_flush_stats))
+    );
+    fn test_field_flushes() {
+        assert_eq!(
+            unsafe {
+                let uninit = ::std::mem::MaybeUninit::<duckdb_appender_flush_stats>::uninit();
+                let ptr = uninit.as_ptr();
+                ::std::ptr::addr_of!((*ptr).flushes) as usize - ptr as usize
+            },
+            0usize,
+            concat!(
+                "Offset of field: ",
+                stringify!(duckdb_appender_flush_stats),
+                "::",
+                stringify!(flushes)
+            )
+        );
+    }
+    test_field_flushes();
+    fn test_field_rows() {
+        assert_eq!(
+            unsafe {
+                let uninit = ::std::mem::MaybeUninit::<duckdb_appender_flush_stats>::uninit();
+                let ptr = uninit.as_ptr();
+                ::std::ptr::addr_of!((*ptr).rows) as usize - ptr as usize
+            },
+            8usize,
+            concat!(
+                "Offset of field: ",
+                stringify!(duckdb_appender_flush_stats),
+                "::",
+                stringify!(rows)
+            )
+        );
+    }
+    test_field_rows();
+    fn test_field_bytes() {
+        assert_eq!(
+            unsafe {
+                let uninit = ::std::mem::MaybeUninit::<duckdb_appender_flush_stats>::uninit();
+                let ptr = uninit.as_ptr();
+                ::std::ptr::addr_of!((*ptr).bytes) as usize - ptr as usize
+            },
+            16usize,
+            concat!(
+                "Offset of field: ",
+                stringify!(duckdb_appender_flush_stats),
+                "::",
+                stringify!(bytes)
+            )
+        );
+    }
+    test_field_bytes();
+    fn test_field_micros() {
+        assert_eq!(
+            unsafe {
+                let uninit = ::std::mem::MaybeUninit::<duckdb_appender_flush_stats>::uninit();
+                let ptr = uninit.as_ptr();
+                ::std::ptr::addr_of!((*ptr).micros) as usize - ptr as usize
+            },
+            24usize,
+            concat!(
+                "Offset of field: ",
+                stringify!(duckdb_appender_flush_stats),
+                "::",
+                stringify!(micros)
+            )
+        );
+    }
+    test_field_micros();
+}
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
 pub struct duckdb_column {
     pub __deprecated_data: *mut ::std::os::raw::c_void,
     pub __deprecated_nullmask: *mut bool,
@@ -15916,6 +16005,11 @@ pub type duckdb_arrow = *mut ::std::os::raw::c_void;
 pub type duckdb_config = *mut ::std::os::raw::c_void;
 pub type duckdb_arrow_schema = *mut ::std::os::raw::c_void;
 pub type duckdb_arrow_array = *mut ::std::os::raw::c_void;
+pub type duckdb_arrow_stream = *mut ::std::os::raw::c_void;
+pub type duckdb_parallel_appender = *mut ::std::os::raw::c_void;
+pub type duckdb_prepared_batch = *mut ::std::os::raw::c_void;
+pub type duckdb_input_stream = *mut ::std::os::raw::c_void;
+pub type duckdb_arrow_array_stream = *mut ::std::os::raw::c_void;
 pub type duckdb_logical_type = *mut ::std::os::raw::c_void;
 pub type duckdb_data_chunk = *mut ::std::os::raw::c_void;
 pub type duckdb_vector = *mut ::std::os::raw::c_void;
@@ -15927,6 +16021,23 @@ pub const duckdb_pending_state_DUCKDB_PENDING_RESULT_READY: duckdb_pending_state
 pub const duckdb_pending_state_DUCKDB_PENDING_RESULT_NOT_READY: duckdb_pending_state = 1;
 pub const duckdb_pending_state_DUCKDB_PENDING_ERROR: duckdb_pending_state = 2;
 pub type duckdb_pending_state = ::std::os::raw::c_uint;
+pub const duckdb_table_filter_type_DUCKDB_TABLE_FILTER_CONSTANT_COMPARISON: duckdb_table_filter_type = 0;
+pub const duckdb_table_filter_type_DUCKDB_TABLE_FILTER_IS_NULL: duckdb_table_filter_type = 1;
+pub const duckdb_table_filter_type_DUCKDB_TABLE_FILTER_IS_NOT_NULL: duckdb_table_filter_type = 2;
+pub const duckdb_table_filter_type_DUCKDB_TABLE_FILTER_CONJUNCTION_OR: duckdb_table_filter_type = 3;
+pub const duckdb_table_filter_type_DUCKDB_TABLE_FILTER_CONJUNCTION_AND: duckdb_table_filter_type = 4;
+pub type duckdb_table_filter_type = ::std::os::raw::c_uint;
+pub const duckdb_comparison_type_DUCKDB_COMPARE_INVALID: duckdb_comparison_type = 0;
+pub const duckdb_comparison_type_DUCKDB_COMPARE_EQUAL: duckdb_comparison_type = 1;
+pub const duckdb_comparison_type_DUCKDB_COMPARE_NOT_EQUAL: duckdb_comparison_type = 2;
+pub const duckdb_comparison_type_DUCKDB_COMPARE_LESS_THAN: duckdb_comparison_type = 3;
+pub const duckdb_comparison_type_DUCKDB_COMPARE_LESS_THAN_OR_EQUAL: duckdb_comparison_type = 4;
+pub const duckdb_comparison_type_DUCKDB_COMPARE_GREATER_THAN: duckdb_comparison_type = 5;
+pub const duckdb_comparison_type_DUCKDB_COMPARE_GREATER_THAN_OR_EQUAL: duckdb_comparison_type = 6;
+pub type duckdb_comparison_type = ::std::os::raw::c_uint;
+pub const duckdb_function_side_effects_DUCKDB_NO_SIDE_EFFECTS: duckdb_function_side_effects = 0;
+pub const duckdb_function_side_effects_DUCKDB_HAS_SIDE_EFFECTS: duckdb_function_side_effects = 1;
+pub type duckdb_function_side_effects = ::std::os::raw::c_uint;
 extern "C" {
     #[doc = "Creates a new database or opens an existing database file stored at the the given path."]
     #[doc = "If no path is given a new in-memory database is created instead."]
@@ -15976,6 +16087,33 @@ extern "C" {
     #[doc = " connection: The connection to close."]
     pub fn duckdb_disconnect(connection: *mut duckdb_connection);
 }
+extern "C" {
+    #[doc = "Interrupts the query that is currently running on the connection, if any. The query fails with an interrupt error"]
+    #[doc = "within one task of its execution, freeing the resources it holds."]
+    #[doc = ""]
+    #[doc = "This function can be called from any thread, while another thread is running the query."]
+    #[doc = ""]
+    #[doc = " connection: The connection to interrupt."]
+    pub fn duckdb_interrupt(connection: duckdb_connection);
+}
+extern "C" {
+    #[doc = "Enables tracking the progress of the queries run on the connection, see `duckdb_query_progress`. The progress is"]
+    #[doc = "not printed."]
+    #[doc = ""]
+    #[doc = " connection: The connection to track the progress of."]
+    pub fn duckdb_enable_query_progress(connection: duckdb_connection);
+}
+extern "C" {
+    #[doc = "Returns the progress of the query running on the connection as a percentage between 0 and 100, or of the last query"]
+    #[doc = "once it has finished. The progress is estimated from the sources of the query plan, and only updated as the query"]
+    #[doc = "runs its tasks."]
+    #[doc = ""]
+    #[doc = "This function can be called from any thread, while another thread is running the query."]
+    #[doc = ""]
+    #[doc = " connection: The connection to get the progress of."]
+    #[doc = " returns: The progress percentage, or -1 if progress tracking is not enabled."]
+    pub fn duckdb_query_progress(connection: duckdb_connection) -> f64;
+}
 extern "C" {
     #[doc = "Initializes an empty configuration object that can be used to provide start-up options for the DuckDB instance"]
     #[doc = "through `duckdb_open_ext`."]
@@ -16530,6 +16668,16 @@ extern "C" {
         val: duckdb_interval,
     ) -> duckdb_state;
 }
+extern "C" {
+    #[doc = "Binds a duckdb_decimal value to the prepared statement at the specified index."]
+    #[doc = ""]
+    #[doc = "The value has the width and scale of the decimal, and is cast to the type of the parameter."]
+    pub fn duckdb_bind_decimal(
+        prepared_statement: duckdb_prepared_statement,
+        param_idx: idx_t,
+        val: duckdb_decimal,
+    ) -> duckdb_state;
+}
 extern "C" {
     #[doc = "Binds a null-terminated varchar value to the prepared statement at the specified index."]
     pub fn duckdb_bind_varchar(
@@ -16643,6 +16791,42 @@ extern "C" {
         out_result: *mut duckdb_result,
     ) -> duckdb_state;
 }
+extern "C" {
+    #[doc = "Executes the prepared statement with the given bound parameters, and returns a pending result that produces a"]
+    #[doc = "streaming result when executed. A streaming result fetches its chunks lazily instead of materializing every row"]
+    #[doc = "up front."]
+    #[doc = ""]
+    #[doc = "Note that a streaming result keeps the connection busy: it is invalidated as soon as another query is run on the"]
+    #[doc = "same connection."]
+    #[doc = ""]
+    #[doc = "After calling `duckdb_pending_prepared_streaming`, the pending result should always be destroyed using"]
+    #[doc = "`duckdb_destroy_pending`, even if this function returns DuckDBError."]
+    #[doc = ""]
+    #[doc = " prepared_statement: The prepared statement to execute."]
+    #[doc = " out_result: The pending query result."]
+    #[doc = " returns: `DuckDBSuccess` on success or `DuckDBError` on failure."]
+    pub fn duckdb_pending_prepared_streaming(
+        prepared_statement: duckdb_prepared_statement,
+        out_result: *mut duckdb_pending_result,
+    ) -> duckdb_state;
+}
+extern "C" {
+    #[doc = "Fully execute a pending query result, returning the final query result as an arrow stream."]
+    #[doc = ""]
+    #[doc = "If the pending result was created with `duckdb_pending_prepared_streaming`, the rows are produced lazily by"]
+    #[doc = "`duckdb_arrow_stream_array`. Otherwise the result is materialized before this function returns."]
+    #[doc = ""]
+    #[doc = "Note that after calling `duckdb_execute_pending_arrow`, `duckdb_destroy_arrow_stream` must be called on the result"]
+    #[doc = "object even if the function returns DuckDBError. The pending result can be destroyed afterwards."]
+    #[doc = ""]
+    #[doc = " pending_result: The pending result to execute."]
+    #[doc = " out_result: The arrow stream result."]
+    #[doc = " returns: `DuckDBSuccess` on success or `DuckDBError` on failure."]
+    pub fn duckdb_execute_pending_arrow(
+        pending_result: duckdb_pending_result,
+        out_result: *mut duckdb_arrow_stream,
+    ) -> duckdb_state;
+}
 extern "C" {
     #[doc = "Destroys the value and de-allocates all memory allocated for that type."]
     #[doc = ""]
@@ -16686,6 +16870,13 @@ extern "C" {
     #[doc = " returns: The int64 value, or 0 if no conversion is possible"]
     pub fn duckdb_get_int64(value: duckdb_value) -> i64;
 }
+extern "C" {
+    #[doc = "Returns the type of the given value."]
+    #[doc = ""]
+    #[doc = " value: The value"]
+    #[doc = " returns: The type of the value. It is owned by the value and should not be destroyed."]
+    pub fn duckdb_get_value_type(value: duckdb_value) -> duckdb_logical_type;
+}
 extern "C" {
     #[doc = "Creates a `duckdb_logical_type` from a standard primitive type."]
     #[doc = "The resulting type should be destroyed with `duckdb_destroy_logical_type`."]
@@ -17029,11 +17220,22 @@ pub type duckdb_table_function = *mut ::std::os::raw::c_void;
 pub type duckdb_bind_info = *mut ::std::os::raw::c_void;
 pub type duckdb_init_info = *mut ::std::os::raw::c_void;
 pub type duckdb_function_info = *mut ::std::os::raw::c_void;
+pub type duckdb_table_filter = *mut ::std::os::raw::c_void;
 pub type duckdb_table_function_bind_t = ::std::option::Option<unsafe extern "C" fn(info: duckdb_bind_info)>;
 pub type duckdb_table_function_init_t = ::std::option::Option<unsafe extern "C" fn(info: duckdb_init_info)>;
 pub type duckdb_table_function_t =
     ::std::option::Option<unsafe extern "C" fn(info: duckdb_function_info, output: duckdb_data_chunk)>;
 pub type duckdb_delete_callback_t = ::std::option::Option<unsafe extern "C" fn(data: *mut ::std::os::raw::c_void)>;
+pub type duckdb_table_function_progress_t = ::std::option::Option<
+    unsafe extern "C" fn(bind_data: *mut ::std::os::raw::c_void, init_data: *mut ::std::os::raw::c_void) -> f64,
+>;
+pub type duckdb_table_function_batch_index_t = ::std::option::Option<
+    unsafe extern "C" fn(
+        bind_data: *mut ::std::os::raw::c_void,
+        init_data: *mut ::std::os::raw::c_void,
+        local_init_data: *mut ::std::os::raw::c_void,
+    ) -> idx_t,
+>;
 extern "C" {
     #[doc = "Creates a new empty table function."]
     #[doc = ""]
@@ -17116,6 +17318,46 @@ extern "C" {
     #[doc = " pushdown: True if the table function supports projection pushdown, false otherwise."]
     pub fn duckdb_table_function_supports_projection_pushdown(table_function: duckdb_table_function, pushdown: bool);
 }
+extern "C" {
+    #[doc = "Sets the progress function of the table function, which reports how much of its scan is done, e.g. in the progress bar."]
+    #[doc = ""]
+    #[doc = "It is called with the bind data and the init data of the scan, possibly while other threads run the main function,"]
+    #[doc = "and returns the percentage of the scan that is done, between 0 and 100, or a negative number if it is unknown."]
+    #[doc = ""]
+    #[doc = " table_function: The table function"]
+    #[doc = " progress: The progress function"]
+    pub fn duckdb_table_function_set_progress(
+        table_function: duckdb_table_function,
+        progress: duckdb_table_function_progress_t,
+    );
+}
+extern "C" {
+    #[doc = "Sets the batch index function of the table function, which makes its scan preserve the order of its rows even with"]
+    #[doc = "many threads, e.g. for a `LIMIT`."]
+    #[doc = ""]
+    #[doc = "The rows of the scan are split in batches, numbered in their order. It is called after every call of the main function"]
+    #[doc = "with the bind data, the init data and the thread-local init data of the thread, and returns the index of the batch the"]
+    #[doc = "rows just produced by the thread belong to. The batches a thread produces must be increasing."]
+    #[doc = ""]
+    #[doc = " table_function: The table function"]
+    #[doc = " batch_index: The batch index function"]
+    pub fn duckdb_table_function_set_batch_index(
+        table_function: duckdb_table_function,
+        batch_index: duckdb_table_function_batch_index_t,
+    );
+}
+extern "C" {
+    #[doc = "Sets whether or not the given table function supports filter pushdown."]
+    #[doc = ""]
+    #[doc = "If this is set to true, the system will provide the filters of the query on the columns of the function in the `init`"]
+    #[doc = "stage through the `duckdb_init_get_filter_count` and `duckdb_init_get_filter` functions, and will not apply them"]
+    #[doc = "itself: the function must then only produce the rows that pass them."]
+    #[doc = "If this is set to false (the default), the system will filter the rows the function produces."]
+    #[doc = ""]
+    #[doc = " table_function: The table function"]
+    #[doc = " pushdown: True if the table function supports filter pushdown, false otherwise."]
+    pub fn duckdb_table_function_supports_filter_pushdown(table_function: duckdb_table_function, pushdown: bool);
+}
 extern "C" {
     #[doc = "Register the table function object within the given connection."]
     #[doc = ""]
@@ -17245,6 +17487,71 @@ extern "C" {
     #[doc = " max_threads: The maximum amount of threads that can process this table function"]
     pub fn duckdb_init_set_max_threads(info: duckdb_init_info, max_threads: idx_t);
 }
+extern "C" {
+    #[doc = "Returns the number of columns with filters pushed down into the scan."]
+    #[doc = ""]
+    #[doc = "Only table functions that support filter pushdown get filters, see `duckdb_table_function_supports_filter_pushdown`."]
+    #[doc = ""]
+    #[doc = " info: The info object"]
+    #[doc = " returns: The number of columns with filters."]
+    pub fn duckdb_init_get_filter_count(info: duckdb_init_info) -> idx_t;
+}
+extern "C" {
+    #[doc = "Returns the filter of a column pushed down into the scan, the rows the function produces must pass all of them."]
+    #[doc = ""]
+    #[doc = "The filter is owned by the scan and valid during the `init` stage only."]
+    #[doc = ""]
+    #[doc = " info: The info object"]
+    #[doc = " filter_index: The index of the filter, between 0 and `duckdb_init_get_filter_count`."]
+    #[doc = " out_column_index: The index of the filtered column in the projected columns of `duckdb_init_get_column_index`."]
+    #[doc = " returns: The filter, or `nullptr` if the index is out of range."]
+    pub fn duckdb_init_get_filter(
+        info: duckdb_init_info,
+        filter_index: idx_t,
+        out_column_index: *mut idx_t,
+    ) -> duckdb_table_filter;
+}
+extern "C" {
+    #[doc = "Returns the type of the filter: a comparison with a constant, `IS NULL`, `IS NOT NULL`, or a conjunction of filters."]
+    #[doc = ""]
+    #[doc = " filter: The filter"]
+    #[doc = " returns: The type of the filter."]
+    pub fn duckdb_table_filter_get_type(filter: duckdb_table_filter) -> duckdb_table_filter_type;
+}
+extern "C" {
+    #[doc = "Returns the comparison of a `DUCKDB_TABLE_FILTER_CONSTANT_COMPARISON` filter, whose column is on the left side."]
+    #[doc = ""]
+    #[doc = " filter: The filter"]
+    #[doc = " returns: The comparison, or `DUCKDB_COMPARE_INVALID` for other filters."]
+    pub fn duckdb_table_filter_get_comparison(filter: duckdb_table_filter) -> duckdb_comparison_type;
+}
+extern "C" {
+    #[doc = "Returns the constant of a `DUCKDB_TABLE_FILTER_CONSTANT_COMPARISON` filter, of the type of the column."]
+    #[doc = ""]
+    #[doc = "The result must be destroyed with `duckdb_destroy_value`."]
+    #[doc = ""]
+    #[doc = " filter: The filter"]
+    #[doc = " returns: The constant, or `nullptr` for other filters."]
+    pub fn duckdb_table_filter_get_constant(filter: duckdb_table_filter) -> duckdb_value;
+}
+extern "C" {
+    #[doc = "Returns the number of child filters of a `DUCKDB_TABLE_FILTER_CONJUNCTION_OR` or `DUCKDB_TABLE_FILTER_CONJUNCTION_AND`"]
+    #[doc = "filter."]
+    #[doc = ""]
+    #[doc = " filter: The filter"]
+    #[doc = " returns: The number of child filters, or 0 for other filters."]
+    pub fn duckdb_table_filter_get_child_count(filter: duckdb_table_filter) -> idx_t;
+}
+extern "C" {
+    #[doc = "Returns a child filter of a `DUCKDB_TABLE_FILTER_CONJUNCTION_OR` or `DUCKDB_TABLE_FILTER_CONJUNCTION_AND` filter."]
+    #[doc = ""]
+    #[doc = "The child is owned by its parent filter."]
+    #[doc = ""]
+    #[doc = " filter: The filter"]
+    #[doc = " index: The index of the child, between 0 and `duckdb_table_filter_get_child_count`."]
+    #[doc = " returns: The child filter, or `nullptr` if the index is out of range."]
+    pub fn duckdb_table_filter_get_child(filter: duckdb_table_filter, index: idx_t) -> duckdb_table_filter;
+}
 extern "C" {
     #[doc = "Report that an error has occurred while calling init."]
     #[doc = ""]
@@ -17330,6 +17637,235 @@ extern "C" {
     #[doc = " parameter: The parameter to add."]
     pub fn duckdb_replacement_scan_add_parameter(info: duckdb_replacement_scan_info, parameter: duckdb_value);
 }
+pub type duckdb_arrow_scan = *mut ::std::os::raw::c_void;
+pub type duckdb_arrow_scan_info = *mut ::std::os::raw::c_void;
+pub type duckdb_arrow_scan_produce_t = ::std::option::Option<
+    unsafe extern "C" fn(
+        data: *mut ::std::os::raw::c_void,
+        info: duckdb_arrow_scan_info,
+        out_stream: duckdb_arrow_array_stream,
+    ) -> duckdb_state,
+>;
+pub type duckdb_arrow_scan_schema_t = ::std::option::Option<
+    unsafe extern "C" fn(data: *mut ::std::os::raw::c_void, out_schema: duckdb_arrow_schema) -> duckdb_state,
+>;
+extern "C" {
+    #[doc = "Creates an Arrow scan: Arrow data of the client scanned by `arrow_scan`, in parallel and without copying the buffers of"]
+    #[doc = "its arrays, see `duckdb_replacement_scan_set_arrow_scan`."]
+    #[doc = ""]
+    #[doc = "The client provides the data through two callbacks. `get_schema` writes the `ArrowSchema` of the data to `out_schema`."]
+    #[doc = "`produce` writes an `ArrowArrayStream` of the data to `out_stream`, once per scan: its arrays hold the columns and pass"]
+    #[doc = "the filters given by the info object, see `duckdb_arrow_scan_get_column_count` and `duckdb_arrow_scan_get_filter`."]
+    #[doc = "The streams are read by many threads, one array at a time."]
+    #[doc = ""]
+    #[doc = "The queries that bind the scan through `duckdb_replacement_scan_set_arrow_scan` keep it until they are destroyed. The"]
+    #[doc = "result must be destroyed with `duckdb_destroy_arrow_scan`."]
+    #[doc = ""]
+    #[doc = " data: The data passed to the callbacks."]
+    #[doc = " produce: The callback producing the stream of a scan."]
+    #[doc = " get_schema: The callback writing the schema of the data."]
+    #[doc = " destroy: The callback that will be called to destroy the data (if any)."]
+    #[doc = " returns: The Arrow scan."]
+    pub fn duckdb_create_arrow_scan(
+        data: *mut ::std::os::raw::c_void,
+        produce: duckdb_arrow_scan_produce_t,
+        get_schema: duckdb_arrow_scan_schema_t,
+        destroy: duckdb_delete_callback_t,
+    ) -> duckdb_arrow_scan;
+}
+extern "C" {
+    #[doc = "Destroys the Arrow scan, and de-allocates its data once no query references it."]
+    #[doc = ""]
+    #[doc = " scan: The Arrow scan to destroy."]
+    pub fn duckdb_destroy_arrow_scan(scan: *mut duckdb_arrow_scan);
+}
+extern "C" {
+    #[doc = "Replaces the table of the replacement scan by the Arrow scan. Call it in the replacement callback instead of"]
+    #[doc = "`duckdb_replacement_scan_set_function_name`."]
+    #[doc = ""]
+    #[doc = " info: The info object"]
+    #[doc = " scan: The Arrow scan."]
+    pub fn duckdb_replacement_scan_set_arrow_scan(info: duckdb_replacement_scan_info, scan: duckdb_arrow_scan);
+}
+extern "C" {
+    #[doc = "Returns the number of columns the stream of the scan must produce."]
+    #[doc = ""]
+    #[doc = "The stream produces all the columns of the schema when there are none."]
+    #[doc = ""]
+    #[doc = " info: The info object"]
+    #[doc = " returns: The number of columns."]
+    pub fn duckdb_arrow_scan_get_column_count(info: duckdb_arrow_scan_info) -> idx_t;
+}
+extern "C" {
+    #[doc = "Returns the name of a column the stream of the scan must produce, in the order of the children of its arrays."]
+    #[doc = ""]
+    #[doc = " info: The info object"]
+    #[doc = " index: The index of the column, between 0 and `duckdb_arrow_scan_get_column_count`."]
+    #[doc = " returns: The name of the column, or `nullptr` if the index is out of range."]
+    pub fn duckdb_arrow_scan_get_column_name(
+        info: duckdb_arrow_scan_info,
+        index: idx_t,
+    ) -> *const ::std::os::raw::c_char;
+}
+extern "C" {
+    #[doc = "Returns the number of columns with filters the rows of the stream of the scan must pass."]
+    #[doc = ""]
+    #[doc = " info: The info object"]
+    #[doc = " returns: The number of columns with filters."]
+    pub fn duckdb_arrow_scan_get_filter_count(info: duckdb_arrow_scan_info) -> idx_t;
+}
+extern "C" {
+    #[doc = "Returns the filter of a column the rows of the stream of the scan must pass, see `duckdb_table_filter_get_type`."]
+    #[doc = ""]
+    #[doc = "The filter is owned by the scan and valid during the `produce` callback only."]
+    #[doc = ""]
+    #[doc = " info: The info object"]
+    #[doc = " index: The index of the filter, between 0 and `duckdb_arrow_scan_get_filter_count`."]
+    #[doc = " out_column_name: The name of the filtered column, valid during the `produce` callback only."]
+    #[doc = " returns: The filter, or `nullptr` if the index is out of range."]
+    pub fn duckdb_arrow_scan_get_filter(
+        info: duckdb_arrow_scan_info,
+        index: idx_t,
+        out_column_name: *mut *const ::std::os::raw::c_char,
+    ) -> duckdb_table_filter;
+}
+extern "C" {
+    #[doc = "Sets the number of rows of the data, used for the progress of the scan."]
+    #[doc = ""]
+    #[doc = " info: The info object"]
+    #[doc = " row_count: The number of rows."]
+    pub fn duckdb_arrow_scan_set_row_count(info: duckdb_arrow_scan_info, row_count: idx_t);
+}
+extern "C" {
+    #[doc = "Report that an error has occurred in the `produce` callback, which then returns `DuckDBError`."]
+    #[doc = ""]
+    #[doc = " info: The info object"]
+    #[doc = " error: The error message"]
+    pub fn duckdb_arrow_scan_set_error(info: duckdb_arrow_scan_info, error: *const ::std::os::raw::c_char);
+}
+pub type duckdb_scalar_function = *mut ::std::os::raw::c_void;
+pub type duckdb_scalar_function_t = ::std::option::Option<
+    unsafe extern "C" fn(info: duckdb_function_info, input: duckdb_data_chunk, output: duckdb_vector),
+>;
+extern "C" {
+    #[doc = "Creates a new empty scalar function, which computes a whole chunk of rows at once."]
+    #[doc = ""]
+    #[doc = "The return value should be destroyed with `duckdb_destroy_scalar_function`."]
+    #[doc = ""]
+    #[doc = " returns: The scalar function object."]
+    pub fn duckdb_create_scalar_function() -> duckdb_scalar_function;
+}
+extern "C" {
+    #[doc = "Destroys the given scalar function object."]
+    #[doc = ""]
+    #[doc = " function: The scalar function to destroy"]
+    pub fn duckdb_destroy_scalar_function(function: *mut duckdb_scalar_function);
+}
+extern "C" {
+    #[doc = "Sets the name of the given scalar function."]
+    #[doc = ""]
+    #[doc = " function: The scalar function"]
+    #[doc = " name: The name of the scalar function"]
+    pub fn duckdb_scalar_function_set_name(function: duckdb_scalar_function, name: *const ::std::os::raw::c_char);
+}
+extern "C" {
+    #[doc = "Adds a parameter to the scalar function."]
+    #[doc = ""]
+    #[doc = " function: The scalar function"]
+    #[doc = " type: The type of the parameter to add."]
+    pub fn duckdb_scalar_function_add_parameter(function: duckdb_scalar_function, type_: duckdb_logical_type);
+}
+extern "C" {
+    #[doc = "Sets the return type of the scalar function."]
+    #[doc = ""]
+    #[doc = " function: The scalar function"]
+    #[doc = " type: The return type"]
+    pub fn duckdb_scalar_function_set_return_type(function: duckdb_scalar_function, type_: duckdb_logical_type);
+}
+extern "C" {
+    #[doc = "Assigns extra information to the scalar function that can be fetched during execution."]
+    #[doc = ""]
+    #[doc = " function: The scalar function"]
+    #[doc = " extra_info: The extra information"]
+    #[doc = " destroy: The callback that will be called to destroy the extra information (if any)"]
+    pub fn duckdb_scalar_function_set_extra_info(
+        function: duckdb_scalar_function,
+        extra_info: *mut ::std::os::raw::c_void,
+        destroy: duckdb_delete_callback_t,
+    );
+}
+extern "C" {
+    #[doc = "Sets the main function of the scalar function, called with chunks of arguments by many threads at once."]
+    #[doc = ""]
+    #[doc = "It writes the results of the `duckdb_data_chunk_get_size` rows of the input to the output vector. The input vectors"]
+    #[doc = "are flat, except for the constant ones, see `duckdb_vector_is_constant`; both can hold NULL values, see"]
+    #[doc = "`duckdb_vector_get_validity`."]
+    #[doc = ""]
+    #[doc = " function: The scalar function"]
+    #[doc = " execute: The function"]
+    pub fn duckdb_scalar_function_set_function(function: duckdb_scalar_function, execute: duckdb_scalar_function_t);
+}
+extern "C" {
+    #[doc = "Declares whether the scalar function has side effects, e.g. because it is random. Functions without side effects, the"]
+    #[doc = "default, are computed once for constant arguments and can be reordered by the optimizer."]
+    #[doc = ""]
+    #[doc = " function: The scalar function"]
+    #[doc = " side_effects: Whether the function has side effects"]
+    pub fn duckdb_scalar_function_set_side_effects(
+        function: duckdb_scalar_function,
+        side_effects: duckdb_function_side_effects,
+    );
+}
+extern "C" {
+    #[doc = "Register the scalar function object within the given connection."]
+    #[doc = ""]
+    #[doc = "The function requires at least a name, a return type and a function."]
+    #[doc = ""]
+    #[doc = "If the function is incomplete or a function with that name already exists, DuckDBError is returned, and the reason"]
+    #[doc = "can be retrieved with `duckdb_scalar_function_error`."]
+    #[doc = ""]
+    #[doc = " con: The connection to register it in."]
+    #[doc = " function: The function pointer"]
+    #[doc = " returns: Whether or not the registration was successful."]
+    pub fn duckdb_register_scalar_function(con: duckdb_connection, function: duckdb_scalar_function) -> duckdb_state;
+}
+extern "C" {
+    #[doc = "Returns the reason the last registration of the scalar function failed, or `nullptr` if there is none."]
+    #[doc = ""]
+    #[doc = "The error message should not be freed. It will be de-allocated when `duckdb_destroy_scalar_function` is called."]
+    #[doc = ""]
+    #[doc = " function: The scalar function to get the error from."]
+    #[doc = " returns: The error message, or `nullptr` if there is none."]
+    pub fn duckdb_scalar_function_error(function: duckdb_scalar_function) -> *const ::std::os::raw::c_char;
+}
+extern "C" {
+    #[doc = "Retrieves the extra info of the scalar function as set in `duckdb_scalar_function_set_extra_info`"]
+    #[doc = ""]
+    #[doc = " info: The info object"]
+    #[doc = " returns: The extra info"]
+    pub fn duckdb_scalar_function_get_extra_info(info: duckdb_function_info) -> *mut ::std::os::raw::c_void;
+}
+extern "C" {
+    #[doc = "Report that an error has occurred while executing the scalar function, which fails the query."]
+    #[doc = ""]
+    #[doc = " info: The info object"]
+    #[doc = " error: The error message"]
+    pub fn duckdb_scalar_function_set_error(info: duckdb_function_info, error: *const ::std::os::raw::c_char);
+}
+extern "C" {
+    #[doc = "Returns whether the vector is constant: its first row holds the value of all of its rows."]
+    #[doc = ""]
+    #[doc = " vector: The vector"]
+    #[doc = " returns: Whether the vector is constant"]
+    pub fn duckdb_vector_is_constant(vector: duckdb_vector) -> bool;
+}
+extern "C" {
+    #[doc = "Makes the vector constant: its first row is the value of all of its rows, e.g. for the output of a scalar function"]
+    #[doc = "whose input vectors are all constant."]
+    #[doc = ""]
+    #[doc = " vector: The vector"]
+    pub fn duckdb_vector_set_constant(vector: duckdb_vector);
+}
 extern "C" {
     #[doc = "Creates an appender object."]
     #[doc = ""]
@@ -17366,6 +17902,56 @@ extern "C" {
     #[doc = " returns: `DuckDBSuccess` on success or `DuckDBError` on failure."]
     pub fn duckdb_appender_flush(appender: duckdb_appender) -> duckdb_state;
 }
+extern "C" {
+    #[doc = "Creates an appender object that controls when its buffered rows are appended to the table, and keeps statistics of"]
+    #[doc = "its flushes."]
+    #[doc = ""]
+    #[doc = "By default the rows are appended whenever the appender flushes them, which it does every 100 vectors of rows. With"]
+    #[doc = "`manual_flush`, they are only appended by `duckdb_appender_flush_ext` or when the appender is destroyed, so the caller"]
+    #[doc = "decides how many rows are appended at once. With `background_flush`, the rows are appended by a background thread"]
+    #[doc = "while the next rows are buffered; an error of a background flush is returned by the next flush."]
+    #[doc = ""]
+    #[doc = "Note that the object must be destroyed with `duckdb_appender_destroy`."]
+    #[doc = ""]
+    #[doc = " connection: The connection context to create the appender in."]
+    #[doc = " schema: The schema of the table to append to, or `nullptr` for the default schema."]
+    #[doc = " table: The table name to append to."]
+    #[doc = " manual_flush: Whether the rows are only appended when flushed explicitly."]
+    #[doc = " background_flush: Whether the rows are appended by a background thread."]
+    #[doc = " out_appender: The resulting appender object."]
+    #[doc = " returns: `DuckDBSuccess` on success or `DuckDBError` on failure."]
+    pub fn duckdb_appender_create_ext(
+        connection: duckdb_connection,
+        schema: *const ::std::os::raw::c_char,
+        table: *const ::std::os::raw::c_char,
+        manual_flush: bool,
+        background_flush: bool,
+        out_appender: *mut duckdb_appender,
+    ) -> duckdb_state;
+}
+extern "C" {
+    #[doc = "Appends all the rows buffered by the appender to the table. With `wait`, waits until they are, including the rows of"]
+    #[doc = "a background flush; otherwise returns as soon as a background flush of the rows is started. Returns the statistics of"]
+    #[doc = "all the flushes of the appender that are done."]
+    #[doc = ""]
+    #[doc = "The appender does not size its rows: `bytes` is the size of the rows appended since the previous call, as counted by"]
+    #[doc = "the caller while appending them, and is added to the statistics once the rows are appended."]
+    #[doc = ""]
+    #[doc = "For appenders not created with `duckdb_appender_create_ext`, this is the same as `duckdb_appender_flush`, and the"]
+    #[doc = "statistics are zero."]
+    #[doc = ""]
+    #[doc = " appender: The appender to flush."]
+    #[doc = " wait: Whether to wait for a background flush to be done."]
+    #[doc = " bytes: The size of the rows appended since the previous call."]
+    #[doc = " out_stats: The statistics of the flushes of the appender, can be `nullptr`."]
+    #[doc = " returns: `DuckDBSuccess` on success or `DuckDBError` on failure."]
+    pub fn duckdb_appender_flush_ext(
+        appender: duckdb_appender,
+        wait: bool,
+        bytes: idx_t,
+        out_stats: *mut duckdb_appender_flush_stats,
+    ) -> duckdb_state;
+}
 extern "C" {
     #[doc = "Close the appender, flushing all intermediate state in the appender to the table and closing it for further appends."]
     #[doc = ""]
@@ -17458,6 +18044,10 @@ extern "C" {
     #[doc = "Append a duckdb_interval value to the appender."]
     pub fn duckdb_append_interval(appender: duckdb_appender, value: duckdb_interval) -> duckdb_state;
 }
+extern "C" {
+    #[doc = "Append a duckdb_decimal value to the appender, cast to the type of the column."]
+    pub fn duckdb_append_decimal(appender: duckdb_appender, value: duckdb_decimal) -> duckdb_state;
+}
 extern "C" {
     #[doc = "Append a varchar value to the appender."]
     pub fn duckdb_append_varchar(appender: duckdb_appender, val: *const ::std::os::raw::c_char) -> duckdb_state;
@@ -17478,10 +18068,271 @@ extern "C" {
         length: idx_t,
     ) -> duckdb_state;
 }
+extern "C" {
+    #[doc = "Append a varchar value to the appender without copying it: the appender references the string until it is copied to"]
+    #[doc = "the rows buffered by the appender, so it must stay valid until the next `duckdb_appender_release_borrowed`,"]
+    #[doc = "`duckdb_appender_flush`, `duckdb_appender_flush_ext` or `duckdb_appender_destroy`."]
+    #[doc = ""]
+    #[doc = "Only appenders created with `duckdb_appender_create_ext` reference the string, and only in `VARCHAR` columns: it is"]
+    #[doc = "copied and cast otherwise, like with `duckdb_append_varchar_length`."]
+    pub fn duckdb_append_varchar_borrowed(
+        appender: duckdb_appender,
+        val: *const ::std::os::raw::c_char,
+        length: idx_t,
+    ) -> duckdb_state;
+}
+extern "C" {
+    #[doc = "Append a blob value to the appender without copying it, see `duckdb_append_varchar_borrowed`. It is copied and cast"]
+    #[doc = "unless the column is a `BLOB` column."]
+    pub fn duckdb_append_blob_borrowed(
+        appender: duckdb_appender,
+        data: *const ::std::os::raw::c_void,
+        length: idx_t,
+    ) -> duckdb_state;
+}
+extern "C" {
+    #[doc = "Copy the values appended with `duckdb_append_varchar_borrowed` and `duckdb_append_blob_borrowed` to the rows buffered"]
+    #[doc = "by the appender, without flushing them to the table: they can be released once this returns. A row left incomplete by"]
+    #[doc = "a failed append is discarded."]
+    pub fn duckdb_appender_release_borrowed(appender: duckdb_appender) -> duckdb_state;
+}
 extern "C" {
     #[doc = "Append a NULL value to the appender (of any type)."]
     pub fn duckdb_append_null(appender: duckdb_appender) -> duckdb_state;
 }
+extern "C" {
+    #[doc = "Returns the number of columns of the table of the appender."]
+    #[doc = ""]
+    #[doc = " appender: The appender to get the column count from."]
+    #[doc = " returns: The number of columns, 0 if the appender is invalid."]
+    pub fn duckdb_appender_column_count(appender: duckdb_appender) -> idx_t;
+}
+extern "C" {
+    #[doc = "Returns the type of a column of the table of the appender, the data chunks passed to `duckdb_append_data_chunk` must"]
+    #[doc = "have these types."]
+    #[doc = ""]
+    #[doc = "The result must be destroyed with `duckdb_destroy_logical_type`."]
+    #[doc = ""]
+    #[doc = " appender: The appender to get the column type from."]
+    #[doc = " col_idx: The index of the column."]
+    #[doc = " returns: The logical type of the column, or NULL if the appender is invalid or the column is out of range."]
+    pub fn duckdb_appender_column_type(appender: duckdb_appender, col_idx: idx_t) -> duckdb_logical_type;
+}
+extern "C" {
+    #[doc = "Appends the rows of an Arrow record batch, exported as a struct array through the Arrow C data interface."]
+    #[doc = ""]
+    #[doc = "The struct must have one child per column of the table. Children of another type than their column are cast to it."]
+    #[doc = "Where the layouts of Arrow and DuckDB match the values are not converted, but the appender copies them still, so the"]
+    #[doc = "array may be released as soon as this function returns. The array is not released by this function."]
+    #[doc = ""]
+    #[doc = " appender: The appender to append to."]
+    #[doc = " schema: The schema of the struct array."]
+    #[doc = " array: The struct array to append."]
+    #[doc = " returns: The return state."]
+    pub fn duckdb_append_arrow_array(
+        appender: duckdb_appender,
+        schema: duckdb_arrow_schema,
+        array: duckdb_arrow_array,
+    ) -> duckdb_state;
+}
+extern "C" {
+    #[doc = "Creates a parallel appender, which collects the rows of any number of local appenders to append them to the table"]
+    #[doc = "at once with `duckdb_parallel_appender_commit`."]
+    #[doc = ""]
+    #[doc = "Every local appender can be used by its own thread, they don't take any lock of the table: they only hand their rows"]
+    #[doc = "over to the parallel appender when they are flushed. The rows are buffered in memory until they are committed."]
+    #[doc = ""]
+    #[doc = "Note that the object must be destroyed with `duckdb_parallel_appender_destroy`, even if the creation fails."]
+    #[doc = ""]
+    #[doc = " connection: The connection context to create the appender in."]
+    #[doc = " schema: The schema of the table to append to, or `nullptr` for the default schema."]
+    #[doc = " table: The table name to append to."]
+    #[doc = " out_appender: The resulting parallel appender object."]
+    #[doc = " returns: `DuckDBSuccess` on success or `DuckDBError` on failure."]
+    pub fn duckdb_parallel_appender_create(
+        connection: duckdb_connection,
+        schema: *const ::std::os::raw::c_char,
+        table: *const ::std::os::raw::c_char,
+        out_appender: *mut duckdb_parallel_appender,
+    ) -> duckdb_state;
+}
+extern "C" {
+    #[doc = "Creates a local appender of the parallel appender. It is used like any other appender, but its rows are only"]
+    #[doc = "appended to the table by `duckdb_parallel_appender_commit`."]
+    #[doc = ""]
+    #[doc = "The local appender must be destroyed with `duckdb_appender_destroy` before the parallel appender is committed or"]
+    #[doc = "destroyed, even if the creation fails."]
+    #[doc = ""]
+    #[doc = " appender: The parallel appender."]
+    #[doc = " out_appender: The resulting local appender."]
+    #[doc = " returns: `DuckDBSuccess` on success or `DuckDBError` on failure."]
+    pub fn duckdb_parallel_appender_local(
+        appender: duckdb_parallel_appender,
+        out_appender: *mut duckdb_appender,
+    ) -> duckdb_state;
+}
+extern "C" {
+    #[doc = "Appends the rows of all the local appenders of the parallel appender to the table, in one append. The local"]
+    #[doc = "appenders must have been destroyed before."]
+    #[doc = ""]
+    #[doc = " appender: The parallel appender."]
+    #[doc = " returns: `DuckDBSuccess` on success or `DuckDBError` on failure."]
+    pub fn duckdb_parallel_appender_commit(appender: duckdb_parallel_appender) -> duckdb_state;
+}
+extern "C" {
+    #[doc = "Returns the error message associated with the given parallel appender."]
+    #[doc = "If the appender has no error message, this returns `nullptr` instead."]
+    #[doc = ""]
+    #[doc = "The error message should not be freed. It will be de-allocated when `duckdb_parallel_appender_destroy` is called."]
+    #[doc = ""]
+    #[doc = " appender: The parallel appender to get the error from."]
+    #[doc = " returns: The error message, or `nullptr` if there is none."]
+    pub fn duckdb_parallel_appender_error(appender: duckdb_parallel_appender) -> *const ::std::os::raw::c_char;
+}
+extern "C" {
+    #[doc = "Destroys the parallel appender, discarding the rows that were not committed."]
+    #[doc = ""]
+    #[doc = " appender: The parallel appender to destroy."]
+    pub fn duckdb_parallel_appender_destroy(appender: *mut duckdb_parallel_appender);
+}
+extern "C" {
+    #[doc = "Creates a batch of rows of parameter values to execute a prepared statement with, once per row, with"]
+    #[doc = "`duckdb_prepared_batch_execute`."]
+    #[doc = ""]
+    #[doc = "Every column of the batch binds the parameter with the same index. The values are bound as they are, without"]
+    #[doc = "looking at the types the statement expects for its parameters."]
+    #[doc = ""]
+    #[doc = "Note that the object must be destroyed with `duckdb_prepared_batch_destroy`, even if the creation fails."]
+    #[doc = ""]
+    #[doc = " prepared_statement: The prepared statement to execute."]
+    #[doc = " out_batch: The resulting batch."]
+    #[doc = " returns: `DuckDBSuccess` on success or `DuckDBError` on failure."]
+    pub fn duckdb_prepared_batch_create(
+        prepared_statement: duckdb_prepared_statement,
+        out_batch: *mut duckdb_prepared_batch,
+    ) -> duckdb_state;
+}
+extern "C" {
+    #[doc = "Appends the rows of a data chunk to the batch. The chunk must have one column per parameter of the statement, and the"]
+    #[doc = "same column types as the chunks appended before."]
+    #[doc = ""]
+    #[doc = " batch: The batch to append to."]
+    #[doc = " chunk: The chunk of parameter values."]
+    #[doc = " returns: `DuckDBSuccess` on success or `DuckDBError` on failure."]
+    pub fn duckdb_prepared_batch_append_data_chunk(
+        batch: duckdb_prepared_batch,
+        chunk: duckdb_data_chunk,
+    ) -> duckdb_state;
+}
+extern "C" {
+    #[doc = "Appends the rows of an Arrow record batch, exported as a struct array through the Arrow C data interface, to the"]
+    #[doc = "batch. The struct array must have one column per parameter of the statement. Its columns are cast to the column types"]
+    #[doc = "of the chunks appended before, if any."]
+    #[doc = ""]
+    #[doc = "The schema and the array stay owned by the caller."]
+    #[doc = ""]
+    #[doc = " batch: The batch to append to."]
+    #[doc = " schema: The schema of the struct array."]
+    #[doc = " array: The struct array of parameter values."]
+    #[doc = " returns: `DuckDBSuccess` on success or `DuckDBError` on failure."]
+    pub fn duckdb_prepared_batch_append_arrow_array(
+        batch: duckdb_prepared_batch,
+        schema: duckdb_arrow_schema,
+        array: duckdb_arrow_array,
+    ) -> duckdb_state;
+}
+extern "C" {
+    #[doc = "Executes the prepared statement once per row of the batch, in one transaction."]
+    #[doc = ""]
+    #[doc = "An `INSERT ... VALUES (...)` statement with a single row of values inserts all the rows of the batch in a single"]
+    #[doc = "vectorized pass, as an `INSERT ... SELECT` from the batch. Other statements are executed row by row."]
+    #[doc = ""]
+    #[doc = " batch: The batch to execute."]
+    #[doc = " out_rows_changed: The total number of rows changed by the statement, can be `nullptr`."]
+    #[doc = " returns: `DuckDBSuccess` on success or `DuckDBError` on failure."]
+    pub fn duckdb_prepared_batch_execute(batch: duckdb_prepared_batch, out_rows_changed: *mut idx_t) -> duckdb_state;
+}
+extern "C" {
+    #[doc = "Returns the error message of the last failed call on the batch, or `nullptr` if there is none."]
+    #[doc = ""]
+    #[doc = "The error message should not be freed. It will be de-allocated when `duckdb_prepared_batch_destroy` is called."]
+    #[doc = ""]
+    #[doc = " batch: The batch to get the error from."]
+    #[doc = " returns: The error message, or `nullptr` if there is none."]
+    pub fn duckdb_prepared_batch_error(batch: duckdb_prepared_batch) -> *const ::std::os::raw::c_char;
+}
+extern "C" {
+    #[doc = "Destroys the batch, de-allocating all memory allocated for it."]
+    #[doc = ""]
+    #[doc = " batch: The batch to destroy."]
+    pub fn duckdb_prepared_batch_destroy(batch: *mut duckdb_prepared_batch);
+}
+extern "C" {
+    #[doc = "Creates an input stream: bytes written by the client while a query reads them as a file, e.g. with"]
+    #[doc = "`read_csv_auto(path)` or `COPY table FROM path`, where the path is the one returned by `duckdb_input_stream_path`."]
+    #[doc = ""]
+    #[doc = "The stream is read like a pipe, and can only be opened once. At most `window_size` written bytes are buffered"]
+    #[doc = "until the query reads them, `duckdb_input_stream_write` waits for the query in the meantime. The client thus writes"]
+    #[doc = "the stream from another thread than the one running the query."]
+    #[doc = ""]
+    #[doc = "The first `window_size` bytes read are kept, so that the query can read them again from the start, e.g. to"]
+    #[doc = "auto-detect the format of a CSV file."]
+    #[doc = ""]
+    #[doc = " connection: The connection whose database reads the stream."]
+    #[doc = " window_size: The maximum number of bytes buffered by the stream."]
+    #[doc = " out_stream: The resulting stream, or `nullptr` on failure."]
+    #[doc = " returns: `DuckDBSuccess` on success or `DuckDBError` on failure."]
+    pub fn duckdb_input_stream_create(
+        connection: duckdb_connection,
+        window_size: idx_t,
+        out_stream: *mut duckdb_input_stream,
+    ) -> duckdb_state;
+}
+extern "C" {
+    #[doc = "Returns the path under which the stream is read by queries."]
+    #[doc = ""]
+    #[doc = "The path should not be freed. It will be de-allocated when `duckdb_input_stream_destroy` is called."]
+    #[doc = ""]
+    #[doc = " stream: The input stream."]
+    #[doc = " returns: The path of the stream."]
+    pub fn duckdb_input_stream_path(stream: duckdb_input_stream) -> *const ::std::os::raw::c_char;
+}
+extern "C" {
+    #[doc = "Writes bytes to the stream, waiting while the window of the stream is full."]
+    #[doc = ""]
+    #[doc = "Fails once the stream is no longer read: the query is done with it, or the stream was stopped."]
+    #[doc = ""]
+    #[doc = " stream: The input stream."]
+    #[doc = " data: The bytes to write, copied by the stream."]
+    #[doc = " length: The number of bytes to write."]
+    #[doc = " returns: `DuckDBSuccess` on success or `DuckDBError` if the stream is no longer read."]
+    pub fn duckdb_input_stream_write(
+        stream: duckdb_input_stream,
+        data: *const ::std::os::raw::c_void,
+        length: idx_t,
+    ) -> duckdb_state;
+}
+extern "C" {
+    #[doc = "Ends the stream: the query reads the end of the stream once it has read the bytes written before."]
+    #[doc = ""]
+    #[doc = " stream: The input stream."]
+    #[doc = " error: If not `nullptr`, the query fails with this error instead of reading the end of the stream."]
+    pub fn duckdb_input_stream_close(stream: duckdb_input_stream, error: *const ::std::os::raw::c_char);
+}
+extern "C" {
+    #[doc = "Stops the stream: the writes no longer wait and fail, and so does a query still reading the stream."]
+    #[doc = ""]
+    #[doc = "Can be called from any thread, e.g. to release a thread waiting in `duckdb_input_stream_write` once the query is done."]
+    #[doc = ""]
+    #[doc = " stream: The input stream."]
+    pub fn duckdb_input_stream_stop(stream: duckdb_input_stream);
+}
+extern "C" {
+    #[doc = "Destroys the stream, stopping it first."]
+    #[doc = ""]
+    #[doc = " stream: The input stream to destroy."]
+    pub fn duckdb_input_stream_destroy(stream: *mut duckdb_input_stream);
+}
 extern "C" {
     #[doc = "Appends a pre-filled data chunk to the specified appender."]
     #[doc = ""]
@@ -17569,6 +18420,109 @@ extern "C" {
     #[doc = " result: The result to destroy."]
     pub fn duckdb_destroy_arrow(result: *mut duckdb_arrow);
 }
+extern "C" {
+    #[doc = "Fetch the internal arrow schema from the arrow stream result."]
+    #[doc = ""]
+    #[doc = " result: The result to fetch the schema from."]
+    #[doc = " out_schema: The output schema."]
+    #[doc = " returns: `DuckDBSuccess` on success or `DuckDBError` on failure."]
+    pub fn duckdb_arrow_stream_schema(
+        result: duckdb_arrow_stream,
+        out_schema: *mut duckdb_arrow_schema,
+    ) -> duckdb_state;
+}
+extern "C" {
+    #[doc = "Fetch the next chunk of the arrow stream result as an arrow array."]
+    #[doc = "If the result is exhausted, `out_array` is left untouched and `DuckDBSuccess` is returned."]
+    #[doc = ""]
+    #[doc = "The result must be destroyed with `duckdb_destroy_arrow_stream`."]
+    #[doc = ""]
+    #[doc = " result: The result to fetch the array from."]
+    #[doc = " out_array: The output array."]
+    #[doc = " returns: `DuckDBSuccess` on success or `DuckDBError` on failure."]
+    pub fn duckdb_arrow_stream_array(result: duckdb_arrow_stream, out_array: *mut duckdb_arrow_array) -> duckdb_state;
+}
+extern "C" {
+    #[doc = "Sets the maximum number of rows of the arrow arrays fetched from the arrow stream result, including through a stream"]
+    #[doc = "exported with `duckdb_arrow_stream_export`. Defaults to one vector (`duckdb_vector_size`)."]
+    #[doc = ""]
+    #[doc = "Larger batches amortize the per-array overhead of the consumer, at the cost of buffering more rows at once."]
+    #[doc = ""]
+    #[doc = " result: The result object."]
+    #[doc = " batch_size: The maximum number of rows per arrow array, must be at least 1."]
+    #[doc = " returns: `DuckDBSuccess` on success or `DuckDBError` on failure."]
+    pub fn duckdb_arrow_stream_set_batch_size(result: duckdb_arrow_stream, batch_size: idx_t) -> duckdb_state;
+}
+extern "C" {
+    #[doc = "Converts a materialized arrow stream result to arrow arrays on the threads of the database's task scheduler, instead"]
+    #[doc = "of one chunk at a time on the fetching thread. The arrays are still fetched in the order of the result."]
+    #[doc = ""]
+    #[doc = "Must be called before the first array is fetched. Fails if the result is a streaming result."]
+    #[doc = ""]
+    #[doc = " result: The result object, produced by executing `prepared_statement`."]
+    #[doc = " prepared_statement: The prepared statement the result was produced by."]
+    #[doc = " returns: `DuckDBSuccess` on success or `DuckDBError` on failure."]
+    pub fn duckdb_arrow_stream_set_parallel(
+        result: duckdb_arrow_stream,
+        prepared_statement: duckdb_prepared_statement,
+    ) -> duckdb_state;
+}
+extern "C" {
+    #[doc = "Returns the number of columns present in the arrow stream result."]
+    #[doc = ""]
+    #[doc = " result: The result object."]
+    #[doc = " returns: The number of columns present in the result object."]
+    pub fn duckdb_arrow_stream_column_count(result: duckdb_arrow_stream) -> idx_t;
+}
+extern "C" {
+    #[doc = "Returns the number of rows present in the arrow stream result. For a streaming result this is the number of rows"]
+    #[doc = "fetched so far."]
+    #[doc = ""]
+    #[doc = " result: The result object."]
+    #[doc = " returns: The number of rows present in the result object."]
+    pub fn duckdb_arrow_stream_row_count(result: duckdb_arrow_stream) -> idx_t;
+}
+extern "C" {
+    #[doc = "Returns the number of rows changed by the query stored in the arrow stream result. This is relevant only for"]
+    #[doc = "INSERT/UPDATE/DELETE queries. For other queries the rows_changed will be 0."]
+    #[doc = ""]
+    #[doc = " result: The result object."]
+    #[doc = " returns: The number of rows changed."]
+    pub fn duckdb_arrow_stream_rows_changed(result: duckdb_arrow_stream) -> idx_t;
+}
+extern "C" {
+    #[doc = "Returns the error message contained within the arrow stream result. The error is set if `duckdb_execute_pending_arrow`"]
+    #[doc = "or `duckdb_arrow_stream_array` returns `DuckDBError`."]
+    #[doc = ""]
+    #[doc = "The error message should not be freed. It will be de-allocated when `duckdb_destroy_arrow_stream` is called."]
+    #[doc = ""]
+    #[doc = " result: The result object to fetch the error from."]
+    #[doc = " returns: The error of the result."]
+    pub fn duckdb_arrow_stream_error(result: duckdb_arrow_stream) -> *const ::std::os::raw::c_char;
+}
+extern "C" {
+    #[doc = "Closes the arrow stream result and de-allocates all memory allocated for it."]
+    #[doc = ""]
+    #[doc = " result: The result to destroy."]
+    pub fn duckdb_destroy_arrow_stream(result: *mut duckdb_arrow_stream);
+}
+extern "C" {
+    #[doc = "Moves the arrow stream result into an Arrow C stream interface (`struct ArrowArrayStream`), so that it can be"]
+    #[doc = "consumed by any Arrow implementation: the schema is exchanged once, and every call to `get_next` hands out the next"]
+    #[doc = "chunk of the result."]
+    #[doc = ""]
+    #[doc = "The exported stream takes ownership of the result, which is set to NULL. It is released through the `release`"]
+    #[doc = "callback of the stream, `duckdb_destroy_arrow_stream` must not be called on it anymore."]
+    #[doc = "If this function returns DuckDBError, the result is left untouched."]
+    #[doc = ""]
+    #[doc = " result: The arrow stream result to export."]
+    #[doc = " out_stream: The `struct ArrowArrayStream` to initialize."]
+    #[doc = " returns: `DuckDBSuccess` on success or `DuckDBError` on failure."]
+    pub fn duckdb_arrow_stream_export(
+        result: *mut duckdb_arrow_stream,
+        out_stream: duckdb_arrow_array_stream,
+    ) -> duckdb_state;
+}
 pub type duckdb_task_state = *mut ::std::os::raw::c_void;
 extern "C" {
     #[doc = "Execute DuckDB tasks on this thread."]
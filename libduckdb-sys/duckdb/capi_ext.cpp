@@ -0,0 +1,2830 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// capi_ext.cpp
+//
+// Implementation of the C API extensions declared in duckdb.h that are not
+// (yet) part of the bundled amalgamation. Compiled alongside duckdb.cpp.
+//
+//===----------------------------------------------------------------------===//
+
+#include "duckdb.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <thread>
+
+namespace duckdb {
+
+// Not part of the public amalgamated header, mirrored from duckdb/common/arrow_converter.hpp
+struct ArrowConverter {
+	DUCKDB_API static void ToArrowSchema(ArrowSchema *out_schema, vector<LogicalType> &types, vector<string> &names,
+	                                     string &config_timezone);
+	DUCKDB_API static void ToArrowArray(DataChunk &input, ArrowArray *out_array);
+};
+
+// Not part of the public amalgamated header, mirrored from duckdb/planner/filter/constant_filter.hpp
+class ConstantFilter : public TableFilter {
+public:
+	ConstantFilter(ExpressionType comparison_type, Value constant);
+
+	//! The comparison type (e.g. COMPARE_EQUAL, COMPARE_GREATERTHAN, COMPARE_LESSTHAN, ...)
+	ExpressionType comparison_type;
+	//! The constant value to filter on
+	Value constant;
+
+public:
+	FilterPropagateResult CheckStatistics(BaseStatistics &stats) override;
+	string ToString(const string &column_name) override;
+	bool Equals(const TableFilter &other) const override;
+	void Serialize(FieldWriter &writer) const override;
+	static unique_ptr<TableFilter> Deserialize(FieldReader &source);
+};
+
+// Not part of the public amalgamated header, mirrored from duckdb/planner/filter/conjunction_filter.hpp
+class ConjunctionFilter : public TableFilter {
+public:
+	ConjunctionFilter(TableFilterType filter_type_p) : TableFilter(filter_type_p) {
+	}
+
+	virtual ~ConjunctionFilter() {
+	}
+
+	//! The filters of this conjunction
+	vector<unique_ptr<TableFilter>> child_filters;
+
+public:
+	virtual FilterPropagateResult CheckStatistics(BaseStatistics &stats) = 0;
+	virtual string ToString(const string &column_name) = 0;
+
+	virtual bool Equals(const TableFilter &other) const {
+		return TableFilter::Equals(other);
+	}
+};
+
+// Not part of the public amalgamated header, mirrored from duckdb/parser/parsed_expression_iterator.hpp
+class ParsedExpressionIterator {
+public:
+	static void EnumerateChildren(ParsedExpression &expr,
+	                              const std::function<void(unique_ptr<ParsedExpression> &child)> &callback);
+	static void EnumerateTableRefChildren(TableRef &ref,
+	                                      const std::function<void(unique_ptr<ParsedExpression> &child)> &callback);
+};
+
+// Not part of the public amalgamated header, mirrored from duckdb/parser/expression/constant_expression.hpp
+class ConstantExpression : public ParsedExpression {
+public:
+	//! The constant value referenced
+	Value value;
+};
+
+// Not part of the public amalgamated header, mirrored from duckdb/parser/expression/parameter_expression.hpp
+class ParameterExpression : public ParsedExpression {
+public:
+	idx_t parameter_nr;
+};
+
+// Not part of the public amalgamated header, mirrored from duckdb/parser/statement/insert_statement.hpp
+class InsertStatement : public SQLStatement {
+public:
+	//! The select statement to insert from
+	unique_ptr<SelectStatement> select_statement;
+	//! Column names to insert into
+	vector<string> columns;
+	//! Table name to insert to
+	string table;
+	//! Schema name to insert to
+	string schema;
+	//! keep track of optional returningList if statement contains a RETURNING keyword
+	vector<unique_ptr<ParsedExpression>> returning_list;
+};
+
+// Not part of the public amalgamated header, mirrored from duckdb/parser/query_node/select_node.hpp up to the
+// members used here
+class SelectNode : public QueryNode {
+public:
+	//! The projection list
+	vector<unique_ptr<ParsedExpression>> select_list;
+	//! The FROM clause
+	unique_ptr<TableRef> from_table;
+};
+
+// Not part of the public amalgamated header, mirrored from duckdb/parser/tableref/expressionlistref.hpp up to the
+// members used here
+class ExpressionListRef : public TableRef {
+public:
+	//! Value list, only used for VALUES statement
+	vector<vector<unique_ptr<ParsedExpression>>> values;
+};
+
+// Layout must match the wrappers in duckdb/main/capi_internal.hpp
+struct PreparedStatementWrapper {
+	unique_ptr<PreparedStatement> statement;
+	vector<Value> values;
+};
+
+struct PendingStatementWrapper {
+	unique_ptr<PendingQueryResult> statement;
+};
+
+struct AppenderWrapper {
+	unique_ptr<Appender> appender;
+	string error;
+};
+
+class ParallelAppend;
+
+struct ParallelAppenderWrapper {
+	unique_ptr<ParallelAppend> appender;
+	string error;
+};
+
+class PreparedBatch;
+
+struct PreparedBatchWrapper {
+	unique_ptr<PreparedBatch> batch;
+	string error;
+};
+
+class ParallelArrowExport;
+
+//! Converts one range of chunks of a materialized result to an arrow array
+class ArrowExportTask : public Task {
+public:
+	explicit ArrowExportTask(ParallelArrowExport &state) : state(state) {
+	}
+
+	TaskExecutionResult Execute(TaskExecutionMode mode) override;
+
+private:
+	ParallelArrowExport &state;
+};
+
+//! Converts the chunks of a materialized result to arrow arrays on the threads of the task scheduler, handing the
+//! arrays out in the order of the result
+class ParallelArrowExport {
+public:
+	ParallelArrowExport(ClientContext &context, ColumnDataCollection &collection, idx_t batch_size)
+	    : scheduler(TaskScheduler::GetScheduler(context)), producer(scheduler.CreateProducer()),
+	      collection(collection), chunks_per_array(MaxValue<idx_t>(batch_size / STANDARD_VECTOR_SIZE, 1)) {
+		// every task converts at most one array, never keep more than two arrays per thread around
+		max_in_flight = MaxValue<idx_t>(scheduler.NumberOfThreads(), 1) * 2;
+		// the scanned chunks are handed over to arrow, they must not point into the collection
+		collection.InitializeScan(scan_state, ColumnDataScanProperties::DISALLOW_ZERO_COPY);
+	}
+
+	~ParallelArrowExport() {
+		{
+			lock_guard<mutex> guard(lock);
+			cancelled = true;
+		}
+		// the tasks reference this state: run the ones that are still queued and wait for the running ones
+		unique_ptr<Task> task;
+		while (true) {
+			if (scheduler.GetTaskFromProducer(*producer, task)) {
+				task->Execute(TaskExecutionMode::PROCESS_ALL);
+				task.reset();
+				continue;
+			}
+			unique_lock<mutex> guard(lock);
+			if (scheduled == 0) {
+				break;
+			}
+			finished.wait(guard);
+		}
+		for (auto &entry : ready) {
+			if (entry.second.array.release) {
+				entry.second.array.release(&entry.second.array);
+			}
+		}
+	}
+
+	//! Fetches the next array of the result, leaving out untouched (and count 0) once all arrays have been fetched
+	bool Fetch(ArrowArray *out, idx_t &count, string &out_error) {
+		count = 0;
+		while (true) {
+			Schedule();
+			{
+				lock_guard<mutex> guard(lock);
+				if (!error.empty()) {
+					out_error = error;
+					return false;
+				}
+				auto entry = ready.find(next_output);
+				if (entry != ready.end()) {
+					*out = entry->second.array;
+					count = entry->second.count;
+					ready.erase(entry);
+					next_output++;
+					return true;
+				}
+				if (scan_done && next_output == next_claim) {
+					return true;
+				}
+			}
+			// help out instead of idling while the array we need is converted
+			unique_ptr<Task> task;
+			if (scheduler.GetTaskFromProducer(*producer, task)) {
+				task->Execute(TaskExecutionMode::PROCESS_ALL);
+				continue;
+			}
+			unique_lock<mutex> guard(lock);
+			if (scheduled > 0 && error.empty() && ready.find(next_output) == ready.end()) {
+				finished.wait(guard);
+			}
+		}
+	}
+
+	//! Claims the next range of chunks and converts it to an arrow array
+	void ConvertNext() {
+		struct ChunkIndex {
+			idx_t chunk_index;
+			idx_t segment_index;
+			idx_t row_index;
+		};
+		vector<ChunkIndex> chunks;
+		idx_t array_index;
+		{
+			lock_guard<mutex> guard(lock);
+			if (cancelled || scan_done) {
+				return;
+			}
+			ChunkIndex index;
+			while (chunks.size() < chunks_per_array &&
+			       collection.NextScanIndex(scan_state.scan_state, index.chunk_index, index.segment_index,
+			                                index.row_index)) {
+				chunks.push_back(index);
+			}
+			if (chunks.empty()) {
+				scan_done = true;
+				return;
+			}
+			array_index = next_claim++;
+		}
+
+		ConvertedArray converted;
+		string convert_error;
+		try {
+			ColumnDataLocalScanState local_state;
+			DataChunk chunk;
+			collection.InitializeScanChunk(chunk);
+			if (chunks.size() == 1) {
+				collection.ScanAtIndex(scan_state, local_state, chunk, chunks[0].chunk_index,
+				                       chunks[0].segment_index, chunks[0].row_index);
+				ArrowConverter::ToArrowArray(chunk, &converted.array);
+				converted.count = chunk.size();
+			} else {
+				DataChunk batch;
+				collection.InitializeScanChunk(batch);
+				for (auto &index : chunks) {
+					chunk.Reset();
+					collection.ScanAtIndex(scan_state, local_state, chunk, index.chunk_index, index.segment_index,
+					                       index.row_index);
+					batch.Append(chunk, true);
+				}
+				ArrowConverter::ToArrowArray(batch, &converted.array);
+				converted.count = batch.size();
+			}
+		} catch (std::exception &ex) {
+			convert_error = PreservedError(ex).Message();
+		}
+
+		lock_guard<mutex> guard(lock);
+		if (!convert_error.empty()) {
+			if (error.empty()) {
+				error = convert_error;
+			}
+			return;
+		}
+		ready[array_index] = converted;
+	}
+
+	void TaskFinished() {
+		lock_guard<mutex> guard(lock);
+		scheduled--;
+		finished.notify_all();
+	}
+
+private:
+	//! Tops up the scheduled tasks so that at most max_in_flight arrays are being converted or waiting to be fetched
+	void Schedule() {
+		idx_t count;
+		{
+			lock_guard<mutex> guard(lock);
+			idx_t in_flight = scheduled + ready.size();
+			if (scan_done || cancelled || in_flight >= max_in_flight) {
+				return;
+			}
+			count = max_in_flight - in_flight;
+			scheduled += count;
+		}
+		for (idx_t i = 0; i < count; i++) {
+			scheduler.ScheduleTask(*producer, make_unique<ArrowExportTask>(*this));
+		}
+	}
+
+	struct ConvertedArray {
+		ArrowArray array;
+		idx_t count = 0;
+	};
+
+	TaskScheduler &scheduler;
+	unique_ptr<ProducerToken> producer;
+	ColumnDataCollection &collection;
+	ColumnDataParallelScanState scan_state;
+	//! The amount of chunks converted into one arrow array
+	idx_t chunks_per_array;
+	idx_t max_in_flight;
+
+	mutex lock;
+	//! Signalled whenever a task finishes
+	std::condition_variable finished;
+	//! The index of the next array to claim chunks for, and of the next array to hand out
+	idx_t next_claim = 0;
+	idx_t next_output = 0;
+	//! The amount of tasks that are scheduled but not finished
+	idx_t scheduled = 0;
+	//! Whether all chunks have been claimed
+	bool scan_done = false;
+	//! Set on destruction, tasks that have not started yet do nothing
+	bool cancelled = false;
+	//! The converted arrays that have not been fetched yet, by array index
+	std::map<idx_t, ConvertedArray> ready;
+	string error;
+};
+
+TaskExecutionResult ArrowExportTask::Execute(TaskExecutionMode mode) {
+	state.ConvertNext();
+	state.TaskFinished();
+	return TaskExecutionResult::TASK_FINISHED;
+}
+
+struct ArrowStreamWrapper {
+	unique_ptr<QueryResult> result;
+	string error;
+	//! The amount of rows fetched so far
+	idx_t fetched_rows = 0;
+	//! Whether or not the final (empty) chunk has been fetched
+	bool exhausted = false;
+	//! The maximum amount of rows per fetched arrow array
+	idx_t batch_size = STANDARD_VECTOR_SIZE;
+	//! Set if a materialized result should be converted on the task scheduler threads
+	shared_ptr<ClientContext> parallel_context;
+	//! The parallel conversion, created on the first fetch (declared after result, it references its collection)
+	unique_ptr<ParallelArrowExport> parallel;
+};
+
+//! Fetches the next chunk of the result into out, leaving out untouched once the result is exhausted
+static bool FetchArrowChunk(ArrowStreamWrapper &wrapper, ArrowArray *out, string &error) {
+	if (wrapper.exhausted) {
+		return true;
+	}
+	idx_t count = 0;
+	if (wrapper.parallel_context) {
+		if (!wrapper.parallel) {
+			auto &collection = ((MaterializedQueryResult &)*wrapper.result).Collection();
+			wrapper.parallel = make_unique<ParallelArrowExport>(*wrapper.parallel_context, collection, wrapper.batch_size);
+		}
+		if (!wrapper.parallel->Fetch(out, count, error)) {
+			return false;
+		}
+	} else {
+		PreservedError fetch_error;
+		if (!ArrowUtil::TryFetchChunk(wrapper.result.get(), wrapper.batch_size, out, count, fetch_error)) {
+			error = fetch_error.Message();
+			return false;
+		}
+	}
+	if (count == 0) {
+		// a closed stream result throws on the next fetch: remember that we are done
+		wrapper.exhausted = true;
+	}
+	wrapper.fetched_rows += count;
+	return true;
+}
+
+//! The private data of an exported ArrowArrayStream
+struct ArrowStreamExport {
+	unique_ptr<ArrowStreamWrapper> stream;
+	string last_error;
+
+	static int GetSchema(struct ArrowArrayStream *stream, struct ArrowSchema *out) {
+		if (!stream->release) {
+			return -1;
+		}
+		auto data = (ArrowStreamExport *)stream->private_data;
+		auto &result = *data->stream->result;
+		try {
+			auto timezone_config = QueryResult::GetConfigTimezone(result);
+			ArrowConverter::ToArrowSchema(out, result.types, result.names, timezone_config);
+		} catch (std::exception &ex) {
+			data->last_error = PreservedError(ex).Message();
+			return -1;
+		}
+		return 0;
+	}
+
+	static int GetNext(struct ArrowArrayStream *stream, struct ArrowArray *out) {
+		if (!stream->release) {
+			return -1;
+		}
+		auto data = (ArrowStreamExport *)stream->private_data;
+		// a released array marks the end of the stream
+		out->release = nullptr;
+		if (!FetchArrowChunk(*data->stream, out, data->last_error)) {
+			return -1;
+		}
+		return 0;
+	}
+
+	static const char *GetLastError(struct ArrowArrayStream *stream) {
+		if (!stream->release) {
+			return "stream was released";
+		}
+		auto data = (ArrowStreamExport *)stream->private_data;
+		return data->last_error.c_str();
+	}
+
+	static void Release(struct ArrowArrayStream *stream) {
+		if (!stream->release) {
+			return;
+		}
+		stream->release = nullptr;
+		delete (ArrowStreamExport *)stream->private_data;
+	}
+};
+
+//! The type of the vectors holding the values of an arrow array of the given format
+static LogicalType ArrowFormatType(const string &format) {
+	if (format == "b") {
+		return LogicalType::BOOLEAN;
+	} else if (format == "c") {
+		return LogicalType::TINYINT;
+	} else if (format == "s") {
+		return LogicalType::SMALLINT;
+	} else if (format == "i") {
+		return LogicalType::INTEGER;
+	} else if (format == "l") {
+		return LogicalType::BIGINT;
+	} else if (format == "C") {
+		return LogicalType::UTINYINT;
+	} else if (format == "S") {
+		return LogicalType::USMALLINT;
+	} else if (format == "I") {
+		return LogicalType::UINTEGER;
+	} else if (format == "L") {
+		return LogicalType::UBIGINT;
+	} else if (format == "f") {
+		return LogicalType::FLOAT;
+	} else if (format == "g") {
+		return LogicalType::DOUBLE;
+	} else if (format == "u" || format == "U") {
+		return LogicalType::VARCHAR;
+	} else if (format == "z" || format == "Z") {
+		return LogicalType::BLOB;
+	} else if (format == "tdD") {
+		return LogicalType::DATE;
+	} else if (format == "ttu") {
+		return LogicalType::TIME;
+	} else if (format.rfind("tsu:", 0) == 0) {
+		// timestamps with a time zone are instants, like TIMESTAMP WITH TIME ZONE
+		return format.size() > 4 ? LogicalType::TIMESTAMP_TZ : LogicalType::TIMESTAMP;
+	} else if (format.rfind("tss:", 0) == 0) {
+		return LogicalType::TIMESTAMP_S;
+	} else if (format.rfind("tsm:", 0) == 0) {
+		return LogicalType::TIMESTAMP_MS;
+	} else if (format.rfind("tsn:", 0) == 0) {
+		return LogicalType::TIMESTAMP_NS;
+	}
+	throw NotImplementedException("Appending arrow arrays of format \"" + format + "\" is not supported");
+}
+
+//! Converts the rows of an arrow struct array (a record batch) to data chunks a vector at a time, to append them to an
+//! appender or a prepared batch. Where the layouts of arrow and DuckDB match, the vectors reference the arrow buffers
+//! instead of copying them: the chunks are copied when they are buffered anyway.
+class ArrowAppend {
+public:
+	ArrowAppend(ArrowSchema &schema, ArrowArray &array) : schema(schema), array(array) {
+	}
+
+	//! The types of the columns of the struct array
+	vector<LogicalType> SourceTypes() {
+		if (string(schema.format) != "+s") {
+			throw InvalidInputException("Arrow array to append must be a struct array");
+		}
+		vector<LogicalType> source_types;
+		for (idx_t col = 0; col < (idx_t)schema.n_children; col++) {
+			auto &child = *schema.children[col];
+			if (child.dictionary) {
+				throw NotImplementedException("Appending dictionary encoded arrow arrays is not supported");
+			}
+			source_types.push_back(ArrowFormatType(child.format));
+		}
+		return source_types;
+	}
+
+	void Append(BaseAppender &appender) {
+		Append(appender.GetTypes(), [&](DataChunk &chunk) { appender.AppendDataChunk(chunk); });
+	}
+
+	//! Convert the rows to chunks of the given types, casting the columns of other types
+	void Append(const vector<LogicalType> &types, const std::function<void(DataChunk &)> &sink) {
+		auto source_types = SourceTypes();
+		if (source_types.size() != types.size() || array.n_children != schema.n_children) {
+			throw InvalidInputException("Arrow array to append has " + to_string(schema.n_children) +
+			                            " columns, but " + to_string(types.size()) + " are expected");
+		}
+		if (array.null_count != 0 && array.buffers[0]) {
+			throw InvalidInputException("Arrow array to append has NULL rows");
+		}
+
+		DataChunk chunk;
+		chunk.Initialize(Allocator::DefaultAllocator(), types);
+		for (idx_t offset = 0; offset < (idx_t)array.length; offset += STANDARD_VECTOR_SIZE) {
+			auto count = MinValue<idx_t>(STANDARD_VECTOR_SIZE, array.length - offset);
+			chunk.Reset();
+			for (idx_t col = 0; col < types.size(); col++) {
+				auto &child = *array.children[col];
+				auto format = string(schema.children[col]->format);
+				auto row = array.offset + child.offset + offset;
+				if (source_types[col] == types[col]) {
+					ToVector(format, child, row, count, chunk.data[col]);
+					continue;
+				}
+				// the arrow values have another type than the column, cast them
+				Vector source(source_types[col], count);
+				ToVector(format, child, row, count, source);
+				string error;
+				if (!VectorOperations::TryCast(source, chunk.data[col], count, &error)) {
+					throw InvalidInputException(error);
+				}
+			}
+			chunk.SetCardinality(count);
+			sink(chunk);
+		}
+	}
+
+private:
+	//! Fill the first count rows of result with the values of the arrow array starting at row
+	static void ToVector(const string &format, ArrowArray &array, idx_t row, idx_t count, Vector &result) {
+		SetValidity(array, row, count, result);
+		switch (result.GetType().id()) {
+		case LogicalTypeId::BOOLEAN: {
+			// arrow packs booleans as bits
+			auto bits = (const uint8_t *)array.buffers[1];
+			auto data = FlatVector::GetData<bool>(result);
+			for (idx_t i = 0; i < count; i++) {
+				auto idx = row + i;
+				data[i] = (bits[idx / 8] >> (idx % 8)) & 1;
+			}
+			break;
+		}
+		case LogicalTypeId::VARCHAR:
+		case LogicalTypeId::BLOB:
+			if (format == "U" || format == "Z") {
+				ToStrings<int64_t>(array, row, count, result);
+			} else {
+				ToStrings<int32_t>(array, row, count, result);
+			}
+			break;
+		default:
+			// the values are laid out as in the vector
+			auto width = GetTypeIdSize(result.GetType().InternalType());
+			FlatVector::SetData(result, (data_ptr_t)array.buffers[1] + row * width);
+			break;
+		}
+	}
+
+	template <class OFFSET>
+	static void ToStrings(ArrowArray &array, idx_t row, idx_t count, Vector &result) {
+		auto offsets = (const OFFSET *)array.buffers[1];
+		auto chars = (const char *)array.buffers[2];
+		auto data = FlatVector::GetData<string_t>(result);
+		for (idx_t i = 0; i < count; i++) {
+			auto start = offsets[row + i];
+			auto length = offsets[row + i + 1] - start;
+			if ((uint64_t)length > NumericLimits<uint32_t>::Maximum()) {
+				throw InvalidInputException("Arrow string to append is too long");
+			}
+			// long strings point into the arrow buffer, until the appender copies them
+			data[i] = string_t(chars + start, length);
+		}
+	}
+
+	static void SetValidity(ArrowArray &array, idx_t row, idx_t count, Vector &result) {
+		if (array.null_count == 0 || !array.buffers[0]) {
+			return;
+		}
+		auto bits = (const uint8_t *)array.buffers[0];
+		auto &validity = FlatVector::Validity(result);
+		if (row % 64 == 0 && (uintptr_t)(bits + row / 8) % sizeof(validity_t) == 0) {
+			// on little endian machines, an aligned arrow bitmap has the layout of a validity mask
+			validity.Initialize((validity_t *)(bits + row / 8));
+			return;
+		}
+		for (idx_t i = 0; i < count; i++) {
+			auto idx = row + i;
+			if (!((bits[idx / 8] >> (idx % 8)) & 1)) {
+				validity.SetInvalid(i);
+			}
+		}
+	}
+
+	ArrowSchema &schema;
+	ArrowArray &array;
+};
+
+//! Appender that can append strings and blobs referencing the memory of the caller instead of copying them to its
+//! chunk: they are only copied once the chunk is flushed to the buffered rows, and must stay valid until then
+class BorrowingAppender : public Appender {
+public:
+	BorrowingAppender(Connection &con, const string &schema, const string &table) : Appender(con, schema, table) {
+	}
+
+	//! Append a string or blob that must outlive the current chunk, if the column has its type; other columns get a
+	//! copy cast to their type
+	void AppendBorrowed(LogicalTypeId type, const char *data, uint32_t length) {
+		if (column >= types.size()) {
+			throw InvalidInputException("Too many appends for chunk!");
+		}
+		auto &col = chunk.data[column];
+		if (col.GetType().id() != type) {
+			if (type == LogicalTypeId::BLOB) {
+				Append<Value>(Value::BLOB((const_data_ptr_t)data, length));
+			} else {
+				Append(data, length);
+			}
+			return;
+		}
+		FlatVector::GetData<string_t>(col)[chunk.size()] = string_t(data, length);
+		column++;
+	}
+
+	//! Copy the rows of the chunk to the buffered rows, after which no string or blob is borrowed any more. A row left
+	//! incomplete by a failed append is discarded, as it may reference released memory once completed.
+	void ReleaseBorrowed() {
+		column = 0;
+		FlushChunk();
+	}
+};
+
+class LocalAppender;
+
+//! Collects the rows of any number of local appenders, each used by its own thread, to append them to the table all
+//! at once: the local appenders only hand their buffered rows over when they flush, without taking any lock of the
+//! table
+class ParallelAppend {
+public:
+	ParallelAppend(Connection &con, string schema, string table)
+	    : con(con), schema(move(schema)), table(move(table)) {
+		description = con.TableInfo(this->schema, this->table);
+		if (!description) {
+			throw CatalogException("Table \"" + this->table + "\" could not be found");
+		}
+	}
+
+	unique_ptr<Appender> CreateLocalAppender();
+
+	void AddCollection(unique_ptr<ColumnDataCollection> collection) {
+		lock_guard<mutex> guard(lock);
+		collections.push_back(move(collection));
+	}
+
+	//! Append the rows of all local appenders to the table, they must have been closed before
+	void Commit() {
+		lock_guard<mutex> guard(lock);
+		if (collections.empty()) {
+			return;
+		}
+		// combining moves the segments of the collections, without copying the rows
+		auto &merged = *collections[0];
+		for (idx_t i = 1; i < collections.size(); i++) {
+			merged.Combine(*collections[i]);
+		}
+		con.Append(*description, merged);
+		collections.clear();
+	}
+
+private:
+	Connection &con;
+	string schema;
+	string table;
+	unique_ptr<TableDescription> description;
+	mutex lock;
+	vector<unique_ptr<ColumnDataCollection>> collections;
+};
+
+//! An appender that hands its rows over to a ParallelAppend instead of appending them to the table
+class LocalAppender : public BorrowingAppender {
+public:
+	LocalAppender(ParallelAppend &parallel, Connection &con, const string &schema, const string &table)
+	    : BorrowingAppender(con, schema, table), parallel(parallel) {
+	}
+
+	~LocalAppender() override {
+		// flush here: once the Appender destructor runs, flushing would append to the table directly
+		Destructor();
+	}
+
+protected:
+	void FlushInternal(ColumnDataCollection &buffered) override {
+		// the appender resets its collection after flushing, hand it over and leave a new one instead
+		parallel.AddCollection(move(collection));
+		collection = make_unique<ColumnDataCollection>(allocator, types);
+	}
+
+private:
+	ParallelAppend &parallel;
+};
+
+unique_ptr<Appender> ParallelAppend::CreateLocalAppender() {
+	return make_unique<LocalAppender>(*this, con, schema, table);
+}
+
+//! Appender that decides itself when its buffered rows are appended to the table: either whenever the appender
+//! flushes them, or only when flushed explicitly with FlushAll (manual flush). The rows can be appended by a background
+//! thread, so that the next rows are buffered while the previous ones are appended. Keeps statistics of its flushes.
+class BufferedAppender : public BorrowingAppender {
+public:
+	BufferedAppender(Connection &con, const string &schema, const string &table, bool manual_flush,
+	                 bool background_flush)
+	    : BorrowingAppender(con, schema, table), con(con), manual_flush(manual_flush),
+	      background_flush(background_flush) {
+		description = con.TableInfo(schema, table);
+	}
+
+	~BufferedAppender() override {
+		// flush here: once the Appender destructor runs, flushing would append to the table directly
+		Destructor();
+		try {
+			Dispatch();
+		} catch (...) {
+		}
+		Join();
+	}
+
+	//! Append all buffered rows to the table, optionally waiting until they are. The caller counts the bytes of the
+	//! rows appended since its previous call while appending them, the rows are not scanned again to size them.
+	void FlushAll(bool wait, idx_t bytes) {
+		pending_bytes += bytes;
+		Flush();
+		Dispatch();
+		if (wait) {
+			Wait();
+		}
+	}
+
+	void GetStats(duckdb_appender_flush_stats &out) {
+		lock_guard<mutex> guard(stats_lock);
+		out.flushes = flushes;
+		out.rows = flushed_rows;
+		out.bytes = flushed_bytes;
+		out.micros = flush_micros;
+	}
+
+protected:
+	void FlushInternal(ColumnDataCollection &buffered) override {
+		// the appender resets its collection after flushing, keep it and leave a new one instead
+		pending.push_back(move(collection));
+		collection = make_unique<ColumnDataCollection>(allocator, types);
+		if (!manual_flush) {
+			Dispatch();
+		}
+	}
+
+private:
+	//! Append the pending rows to the table, one flush at a time so that the rows keep their order
+	void Dispatch() {
+		// a failed background flush is reported before the pending rows are touched
+		Wait();
+		if (pending.empty()) {
+			return;
+		}
+		// combining moves the segments of the collections, without copying the rows
+		auto batch = move(pending[0]);
+		for (idx_t i = 1; i < pending.size(); i++) {
+			batch->Combine(*pending[i]);
+		}
+		pending.clear();
+		auto bytes = pending_bytes;
+		pending_bytes = 0;
+		if (background_flush) {
+			worker = std::thread(&BufferedAppender::AppendInBackground, this, move(batch), bytes);
+		} else {
+			AppendBatch(*batch, bytes);
+		}
+	}
+
+	void AppendBatch(ColumnDataCollection &batch, idx_t bytes) {
+		auto start = std::chrono::steady_clock::now();
+		con.Append(*description, batch);
+		auto end = std::chrono::steady_clock::now();
+		lock_guard<mutex> guard(stats_lock);
+		flushes++;
+		flushed_rows += batch.Count();
+		flushed_bytes += bytes;
+		flush_micros += std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	}
+
+	void AppendInBackground(unique_ptr<ColumnDataCollection> batch, idx_t bytes) {
+		try {
+			AppendBatch(*batch, bytes);
+		} catch (std::exception &ex) {
+			worker_error = ex.what();
+		} catch (...) {
+			worker_error = "Unknown error";
+		}
+	}
+
+	//! Wait for the background flush, if any, throwing its error
+	void Wait() {
+		Join();
+		if (!worker_error.empty()) {
+			string error = move(worker_error);
+			worker_error.clear();
+			throw Exception(error);
+		}
+	}
+
+	void Join() {
+		if (worker.joinable()) {
+			worker.join();
+		}
+	}
+
+	Connection &con;
+	unique_ptr<TableDescription> description;
+	bool manual_flush;
+	bool background_flush;
+	//! The collections flushed by the appender, not yet appended to the table
+	vector<unique_ptr<ColumnDataCollection>> pending;
+	//! The size of the pending rows, as counted by the caller of FlushAll: rows flushed automatically are counted with
+	//! the rows of the next FlushAll
+	idx_t pending_bytes = 0;
+	//! Appends the previous batch in background flush mode
+	std::thread worker;
+	string worker_error;
+
+	//! The statistics are updated by the background flush
+	mutex stats_lock;
+	idx_t flushes = 0;
+	idx_t flushed_rows = 0;
+	idx_t flushed_bytes = 0;
+	idx_t flush_micros = 0;
+};
+
+static bool StatementReturnsChanges(StatementType type) {
+	switch (type) {
+	case StatementType::INSERT_STATEMENT:
+	case StatementType::UPDATE_STATEMENT:
+	case StatementType::DELETE_STATEMENT:
+	case StatementType::COPY_STATEMENT:
+		return true;
+	default:
+		return false;
+	}
+}
+
+//! The number of rows changed by a statement, if the result holds it
+static idx_t RowsChanged(QueryResult &result) {
+	if (result.type != QueryResultType::MATERIALIZED_RESULT || !StatementReturnsChanges(result.statement_type)) {
+		return 0;
+	}
+	auto &materialized = (MaterializedQueryResult &)result;
+	if (materialized.RowCount() == 0) {
+		return 0;
+	}
+	return materialized.GetValue(0, 0).GetValue<int64_t>();
+}
+
+static string ParameterColumn(idx_t index) {
+	return "__param_" + to_string(index);
+}
+
+//! Turns a parsed "INSERT ... VALUES (...)" statement with a single row of values into "INSERT ... SELECT ... FROM
+//! source", the parameters of the values referencing the columns of the source. Returns false if the statement has
+//! another form.
+static bool RewriteInsertValues(SQLStatement &statement, unique_ptr<TableRef> source) {
+	auto &insert = (InsertStatement &)statement;
+	if (!insert.select_statement || !insert.returning_list.empty() ||
+	    insert.select_statement->node->type != QueryNodeType::SELECT_NODE) {
+		return false;
+	}
+	auto &select = (SelectNode &)*insert.select_statement->node;
+	if (!select.from_table || select.from_table->type != TableReferenceType::EXPRESSION_LIST) {
+		return false;
+	}
+	auto &values = ((ExpressionListRef &)*select.from_table).values;
+	if (values.size() != 1) {
+		return false;
+	}
+	bool rewritable = true;
+	std::function<void(unique_ptr<ParsedExpression> &)> replace = [&](unique_ptr<ParsedExpression> &expr) {
+		switch (expr->GetExpressionClass()) {
+		case ExpressionClass::PARAMETER:
+			expr = make_unique<ColumnRefExpression>(ParameterColumn(((ParameterExpression &)*expr).parameter_nr));
+			break;
+		case ExpressionClass::DEFAULT:
+			// DEFAULT is only allowed in VALUES
+		case ExpressionClass::SUBQUERY:
+			// the parameters of a subquery are out of reach of the expression iterator
+			rewritable = false;
+			break;
+		default:
+			ParsedExpressionIterator::EnumerateChildren(*expr, replace);
+			break;
+		}
+	};
+	auto row = move(values[0]);
+	for (auto &expr : row) {
+		replace(expr);
+	}
+	if (!rewritable) {
+		return false;
+	}
+	select.select_list = move(row);
+	select.from_table = move(source);
+	insert.n_param = 0;
+	return true;
+}
+
+static unique_ptr<QueryResult> RunQuery(ClientContext &context, const string &query) {
+	auto result = context.Query(query, false);
+	if (result->HasError()) {
+		throw Exception(result->GetError());
+	}
+	return result;
+}
+
+class ArrowScanFactory;
+
+//! The rows of parameter values to execute a prepared statement with, once per row.
+//!
+//! An "INSERT ... VALUES (...)" statement inserts all rows in a single vectorized pass: the parsed statement is
+//! rewritten to insert from an arrow_scan of the rows instead. Other statements are executed row by row. Either way,
+//! the rows are executed in one transaction, the one of the connection if it has one.
+class PreparedBatch {
+public:
+	explicit PreparedBatch(PreparedStatement &statement);
+	~PreparedBatch();
+
+	void Append(DataChunk &chunk) {
+		if (!collection) {
+			if (chunk.ColumnCount() != statement.n_param) {
+				throw InvalidInputException("Batch to execute has " + to_string(chunk.ColumnCount()) +
+				                            " columns, but the statement has " + to_string(statement.n_param) +
+				                            " parameters");
+			}
+			collection = make_unique<ColumnDataCollection>(Allocator::DefaultAllocator(), chunk.GetTypes());
+		} else if (chunk.GetTypes() != collection->Types()) {
+			throw InvalidInputException("The chunks of a batch to execute must all have the same types");
+		}
+		collection->Append(chunk);
+	}
+
+	void Append(ArrowSchema &schema, ArrowArray &array) {
+		ArrowAppend append(schema, array);
+		auto types = collection ? collection->Types() : append.SourceTypes();
+		append.Append(types, [&](DataChunk &chunk) { Append(chunk); });
+	}
+
+	//! Execute the statement with every row, returning the number of changed rows
+	idx_t Execute() {
+		if (!collection || collection->Count() == 0) {
+			return 0;
+		}
+		auto &context = *statement.context;
+		bool auto_commit = context.transaction.IsAutoCommit();
+		if (auto_commit) {
+			RunQuery(context, "BEGIN TRANSACTION");
+		}
+		try {
+			auto changes = ExecuteInTransaction(context);
+			if (auto_commit) {
+				RunQuery(context, "COMMIT");
+			}
+			return changes;
+		} catch (...) {
+			if (auto_commit) {
+				try {
+					RunQuery(context, "ROLLBACK");
+				} catch (...) {
+				}
+			}
+			throw;
+		}
+	}
+
+private:
+	idx_t ExecuteInTransaction(ClientContext &context) {
+		if (statement.GetStatementType() == StatementType::INSERT_STATEMENT) {
+			auto statements = context.ParseStatements(statement.query);
+			if (statements.size() == 1 && RewriteInsertValues(*statements[0], RowsScan(context))) {
+				auto insert = context.Prepare(move(statements[0]));
+				if (insert->HasError()) {
+					throw Exception(insert->GetError());
+				}
+				vector<Value> no_values;
+				auto result = insert->Execute(no_values, false);
+				if (result->HasError()) {
+					throw Exception(result->GetError());
+				}
+				return RowsChanged(*result);
+			}
+		}
+		return ExecuteRows();
+	}
+
+	idx_t ExecuteRows() {
+		idx_t changes = 0;
+		vector<Value> values(collection->ColumnCount());
+		for (auto &chunk : collection->Chunks()) {
+			for (idx_t row = 0; row < chunk.size(); row++) {
+				for (idx_t col = 0; col < chunk.ColumnCount(); col++) {
+					values[col] = chunk.GetValue(col, row);
+				}
+				auto result = statement.Execute(values, false);
+				if (result->HasError()) {
+					throw Exception(result->GetError());
+				}
+				changes += RowsChanged(*result);
+			}
+		}
+		return changes;
+	}
+
+	//! The FROM clause of an arrow_scan of the rows, whose columns are named after the parameters
+	unique_ptr<TableRef> RowsScan(ClientContext &context);
+
+	static duckdb_state ProduceRows(void *data, duckdb_arrow_scan_info info, duckdb_arrow_array_stream out_stream);
+	static duckdb_state GetRowsSchema(void *data, duckdb_arrow_schema out_schema);
+
+	PreparedStatement &statement;
+	unique_ptr<ColumnDataCollection> collection;
+	//! Scans the rows for the rewritten insert
+	unique_ptr<ArrowScanFactory> rows_scan;
+};
+
+//! Converts a C API decimal to a value of the decimal type of its width and scale
+static Value DecimalToValue(duckdb_decimal decimal) {
+	if (decimal.width == 0 || decimal.width > Decimal::MAX_WIDTH_DECIMAL || decimal.scale > decimal.width) {
+		throw InvalidInputException("Invalid decimal width " + to_string(decimal.width) + " and scale " +
+		                            to_string(decimal.scale));
+	}
+	hugeint_t value;
+	value.lower = decimal.value.lower;
+	value.upper = decimal.value.upper;
+	if (decimal.width > Decimal::MAX_WIDTH_INT64) {
+		return Value::DECIMAL(value, decimal.width, decimal.scale);
+	}
+	return Value::DECIMAL(Hugeint::Cast<int64_t>(value), decimal.width, decimal.scale);
+}
+
+//! Bytes written by the client while a query reads them, through a StreamFileSystem file. The writer waits while the
+//! window is full, so that the bytes buffered in between stay bounded whatever the speeds of both sides
+class InputStream {
+public:
+	explicit InputStream(idx_t window_size) : window_size(MaxValue<idx_t>(window_size, 1)) {
+	}
+
+	//! Buffer the bytes, waiting for room in the window. Returns false once the stream is no longer read
+	bool Write(const char *data, idx_t length) {
+		std::unique_lock<mutex> guard(lock);
+		while (length > 0) {
+			can_write.wait(guard, [&] { return stopped || buffered < window_size; });
+			if (stopped) {
+				return false;
+			}
+			auto size = MinValue<idx_t>(length, window_size - buffered);
+			segments.emplace_back(data, size);
+			buffered += size;
+			data += size;
+			length -= size;
+			can_read.notify_all();
+		}
+		return true;
+	}
+
+	//! End the stream, the reader fails with the error once it read the buffered bytes if there is one
+	void Close(string error_p) {
+		lock_guard<mutex> guard(lock);
+		closed = true;
+		error = move(error_p);
+		can_read.notify_all();
+	}
+
+	//! Stop the stream from both sides: the writer and the reader no longer wait
+	void Stop() {
+		lock_guard<mutex> guard(lock);
+		stopped = true;
+		can_write.notify_all();
+		can_read.notify_all();
+	}
+
+	//! A stream can only be opened once, its bytes are gone after that
+	bool Open() {
+		lock_guard<mutex> guard(lock);
+		if (opened) {
+			return false;
+		}
+		opened = true;
+		return true;
+	}
+
+	//! Read up to nr_bytes, waiting for the writer. Returns 0 at the end of the stream
+	idx_t Read(char *buffer, idx_t nr_bytes) {
+		if (position < replay.size()) {
+			auto size = MinValue<idx_t>(nr_bytes, replay.size() - position);
+			memcpy(buffer, replay.data() + position, size);
+			position += size;
+			return size;
+		}
+		auto read = ReadBuffered(buffer, nr_bytes);
+		if (replayable) {
+			if (replay.size() + read <= window_size) {
+				replay.append(buffer, read);
+			} else {
+				replayable = false;
+				string().swap(replay);
+			}
+		}
+		position += read;
+		return read;
+	}
+
+	//! Read again from the start, e.g. after sniffing a CSV file: the bytes read are kept until they exceed the window
+	void Reset() {
+		if (!replayable) {
+			throw IOException("Input stream can only be read again from the start within its first " +
+			                  to_string(window_size) + " bytes");
+		}
+		position = 0;
+	}
+
+	idx_t Position() {
+		return position;
+	}
+
+private:
+	idx_t ReadBuffered(char *buffer, idx_t nr_bytes) {
+		std::unique_lock<mutex> guard(lock);
+		can_read.wait(guard, [&] { return stopped || closed || !segments.empty(); });
+		if (stopped) {
+			throw IOException("Input stream was stopped before its end");
+		}
+		idx_t read = 0;
+		while (read < nr_bytes && !segments.empty()) {
+			auto &segment = segments.front();
+			auto size = MinValue<idx_t>(nr_bytes - read, segment.size() - offset);
+			memcpy(buffer + read, segment.data() + offset, size);
+			read += size;
+			offset += size;
+			if (offset == segment.size()) {
+				segments.pop_front();
+				offset = 0;
+			}
+		}
+		if (read == 0 && !error.empty()) {
+			throw IOException(error);
+		}
+		buffered -= read;
+		can_write.notify_all();
+		return read;
+	}
+
+	idx_t window_size;
+	mutex lock;
+	std::condition_variable can_read;
+	std::condition_variable can_write;
+	//! The written bytes not read yet, the front segment is read from offset
+	std::deque<string> segments;
+	idx_t offset = 0;
+	idx_t buffered = 0;
+	bool opened = false;
+	bool closed = false;
+	bool stopped = false;
+	string error;
+
+	//! Only used by the reader, which reads from a single thread at a time
+	idx_t position = 0;
+	bool replayable = true;
+	string replay;
+};
+
+struct StreamFileHandle : public FileHandle {
+	StreamFileHandle(FileSystem &file_system, string path, shared_ptr<InputStream> stream_p)
+	    : FileHandle(file_system, move(path)), stream(move(stream_p)) {
+	}
+
+	~StreamFileHandle() override {
+		Close();
+	}
+
+	void Close() override {
+		// whatever the reader did not read is never read, the writer no longer waits for it
+		stream->Stop();
+	}
+
+	shared_ptr<InputStream> stream;
+};
+
+//! Serves the input streams of the process as non-seekable files, under paths starting with "duckdb-stream://", so
+//! that they can be read by the CSV reader like a pipe
+class StreamFileSystem : public FileSystem {
+public:
+	//! Register the file system with the database, if it was not before
+	static void Register(DatabaseInstance &db) {
+		lock_guard<mutex> guard(registry_lock);
+		auto &databases = Databases();
+		for (idx_t i = 0; i < databases.size(); i++) {
+			auto registered = databases[i].lock();
+			if (!registered) {
+				databases.erase(databases.begin() + i);
+				i--;
+			} else if (registered.get() == &db) {
+				return;
+			}
+		}
+		FileSystem::GetFileSystem(db).RegisterSubSystem(make_unique<StreamFileSystem>());
+		databases.push_back(db.shared_from_this());
+	}
+
+	//! Make the stream readable, returning its path
+	static string AddStream(shared_ptr<InputStream> stream) {
+		lock_guard<mutex> guard(registry_lock);
+		auto path = string(PREFIX) + to_string(++stream_count);
+		Streams()[path] = move(stream);
+		return path;
+	}
+
+	static void RemoveStream(const string &path) {
+		lock_guard<mutex> guard(registry_lock);
+		Streams().erase(path);
+	}
+
+	unique_ptr<FileHandle> OpenFile(const string &path, uint8_t flags, FileLockType lock,
+	                                FileCompressionType compression, FileOpener *opener) override {
+		if (flags & FileFlags::FILE_FLAGS_WRITE) {
+			throw IOException("Input stream \"%s\" can't be written to", path);
+		}
+		auto stream = FindStream(path);
+		if (!stream) {
+			throw IOException("No input stream \"%s\"", path);
+		}
+		if (!stream->Open()) {
+			throw IOException("Input stream \"%s\" can only be read once", path);
+		}
+		return make_unique<StreamFileHandle>(*this, path, move(stream));
+	}
+
+	int64_t Read(FileHandle &handle, void *buffer, int64_t nr_bytes) override {
+		return ((StreamFileHandle &)handle).stream->Read((char *)buffer, nr_bytes);
+	}
+
+	void Read(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) override {
+		throw IOException("Input stream \"%s\" can't be read at a location", handle.path);
+	}
+
+	int64_t GetFileSize(FileHandle &handle) override {
+		// unknown, like the size of a pipe
+		return 0;
+	}
+
+	FileType GetFileType(FileHandle &handle) override {
+		return FileType::FILE_TYPE_FIFO;
+	}
+
+	bool FileExists(const string &filename) override {
+		return FindStream(filename) != nullptr;
+	}
+
+	bool IsPipe(const string &filename) override {
+		return true;
+	}
+
+	vector<string> Glob(const string &path, FileOpener *opener) override {
+		vector<string> result;
+		if (FindStream(path)) {
+			result.push_back(path);
+		}
+		return result;
+	}
+
+	bool CanHandleFile(const string &fpath) override {
+		return StringUtil::StartsWith(fpath, PREFIX);
+	}
+
+	void Seek(FileHandle &handle, idx_t location) override {
+		if (location != 0) {
+			throw IOException("Input stream \"%s\" can't be seeked", handle.path);
+		}
+		Reset(handle);
+	}
+
+	void Reset(FileHandle &handle) override {
+		((StreamFileHandle &)handle).stream->Reset();
+	}
+
+	idx_t SeekPosition(FileHandle &handle) override {
+		return ((StreamFileHandle &)handle).stream->Position();
+	}
+
+	bool CanSeek() override {
+		return false;
+	}
+
+	bool OnDiskFile(FileHandle &handle) override {
+		return false;
+	}
+
+protected:
+	std::string GetName() const override {
+		return "StreamFileSystem";
+	}
+
+private:
+	static constexpr const char *PREFIX = "duckdb-stream://";
+
+	static shared_ptr<InputStream> FindStream(const string &path) {
+		lock_guard<mutex> guard(registry_lock);
+		auto &streams = Streams();
+		auto entry = streams.find(path);
+		return entry == streams.end() ? nullptr : entry->second;
+	}
+
+	//! The streams are shared by all databases, the file system of each one only looks them up
+	static unordered_map<string, shared_ptr<InputStream>> &Streams() {
+		static unordered_map<string, shared_ptr<InputStream>> streams;
+		return streams;
+	}
+
+	static vector<std::weak_ptr<DatabaseInstance>> &Databases() {
+		static vector<std::weak_ptr<DatabaseInstance>> databases;
+		return databases;
+	}
+
+	static mutex registry_lock;
+	static idx_t stream_count;
+};
+
+constexpr const char *StreamFileSystem::PREFIX;
+mutex StreamFileSystem::registry_lock;
+idx_t StreamFileSystem::stream_count = 0;
+
+struct InputStreamWrapper {
+	shared_ptr<InputStream> stream;
+	string path;
+};
+
+// Not part of the public amalgamated header, mirrored from duckdb/function/table/arrow.hpp
+typedef unique_ptr<ArrowArrayStreamWrapper> (*stream_factory_produce_t)(
+    uintptr_t stream_factory_ptr, std::pair<std::unordered_map<idx_t, string>, std::vector<string>> &project_columns,
+    TableFilterSet *filters);
+typedef void (*stream_factory_get_schema_t)(uintptr_t stream_factory_ptr, ArrowSchemaWrapper &schema);
+
+//! The columns and filters of one arrow_scan, handed to the client producing its stream
+struct ArrowScanInfo {
+	ArrowScanInfo(std::pair<std::unordered_map<idx_t, string>, std::vector<string>> &project_columns,
+	              TableFilterSet *filters)
+	    : project_columns(project_columns), filters(filters) {
+	}
+
+	std::pair<std::unordered_map<idx_t, string>, std::vector<string>> &project_columns;
+	TableFilterSet *filters;
+	int64_t row_count = -1;
+	string error;
+};
+
+//! The stream factory of arrow_scan for Arrow data of the client, whose callbacks produce the streams and schema
+class ArrowScanFactory {
+public:
+	ArrowScanFactory(void *data, duckdb_arrow_scan_produce_t produce, duckdb_arrow_scan_schema_t get_schema,
+	                 duckdb_delete_callback_t destroy)
+	    : data(data), produce(produce), get_schema(get_schema), destroy(destroy) {
+	}
+
+	~ArrowScanFactory() {
+		if (data && destroy) {
+			destroy(data);
+		}
+	}
+
+	//! The parameters of arrow_scan scanning this factory
+	vector<Value> Parameters() {
+		stream_factory_produce_t produce_ptr = ArrowScanFactory::Produce;
+		stream_factory_get_schema_t get_schema_ptr = ArrowScanFactory::GetSchema;
+		return {Value::POINTER((uintptr_t)this), Value::POINTER((uintptr_t)produce_ptr),
+		        Value::POINTER((uintptr_t)get_schema_ptr)};
+	}
+
+	static unique_ptr<ArrowArrayStreamWrapper>
+	Produce(uintptr_t factory_ptr, std::pair<std::unordered_map<idx_t, string>, std::vector<string>> &project_columns,
+	        TableFilterSet *filters) {
+		auto &factory = *(ArrowScanFactory *)factory_ptr;
+		ArrowScanInfo info(project_columns, filters);
+		auto result = make_unique<ArrowArrayStreamWrapper>();
+		if (factory.produce(factory.data, &info, &result->arrow_array_stream) != DuckDBSuccess) {
+			throw InvalidInputException(info.error.empty() ? "Failed to produce the arrow stream" : info.error);
+		}
+		result->number_of_rows = info.row_count;
+		return result;
+	}
+
+	static void GetSchema(uintptr_t factory_ptr, ArrowSchemaWrapper &schema) {
+		auto &factory = *(ArrowScanFactory *)factory_ptr;
+		if (factory.get_schema(factory.data, &schema.arrow_schema) != DuckDBSuccess) {
+			throw InvalidInputException("Failed to get the arrow schema");
+		}
+		// arrow_scan keeps the schema in its bind data, which thus keeps the factory bound by a replacement scan
+		if (binding.get() == &factory) {
+			auto reference = new SchemaReference();
+			reference->private_data = schema.arrow_schema.private_data;
+			reference->release = schema.arrow_schema.release;
+			reference->factory = move(binding);
+			schema.arrow_schema.private_data = reference;
+			schema.arrow_schema.release = ReleaseSchema;
+		}
+	}
+
+	//! The factory a replacement scan of this thread is about to bind, referenced until its schema is taken
+	static thread_local shared_ptr<ArrowScanFactory> binding;
+
+private:
+	//! The release callback and private data of a schema, replaced to hold a reference to the factory
+	struct SchemaReference {
+		void *private_data;
+		void (*release)(ArrowSchema *);
+		shared_ptr<ArrowScanFactory> factory;
+	};
+
+	static void ReleaseSchema(ArrowSchema *schema) {
+		auto reference = (SchemaReference *)schema->private_data;
+		schema->private_data = reference->private_data;
+		schema->release = reference->release;
+		if (schema->release) {
+			schema->release(schema);
+		}
+		delete reference;
+	}
+
+	void *data;
+	duckdb_arrow_scan_produce_t produce;
+	duckdb_arrow_scan_schema_t get_schema;
+	duckdb_delete_callback_t destroy;
+};
+
+thread_local shared_ptr<ArrowScanFactory> ArrowScanFactory::binding;
+
+//! The private data of an ArrowArrayStream over some columns of the rows of a prepared batch
+struct BatchRowsExport {
+	BatchRowsExport(ColumnDataCollection &rows, vector<column_t> column_ids) : rows(rows) {
+		for (auto &col : column_ids) {
+			types.push_back(rows.Types()[col]);
+			names.push_back(ParameterColumn(col + 1));
+		}
+		// the arrays outlive the scan of the next chunk
+		rows.InitializeScan(scan_state, move(column_ids), ColumnDataScanProperties::DISALLOW_ZERO_COPY);
+	}
+
+	ColumnDataCollection &rows;
+	vector<LogicalType> types;
+	vector<string> names;
+	ColumnDataScanState scan_state;
+	string last_error;
+
+	static int GetSchema(struct ArrowArrayStream *stream, struct ArrowSchema *out) {
+		if (!stream->release) {
+			return -1;
+		}
+		auto data = (BatchRowsExport *)stream->private_data;
+		try {
+			string timezone = "UTC";
+			ArrowConverter::ToArrowSchema(out, data->types, data->names, timezone);
+		} catch (std::exception &ex) {
+			data->last_error = PreservedError(ex).Message();
+			return -1;
+		}
+		return 0;
+	}
+
+	static int GetNext(struct ArrowArrayStream *stream, struct ArrowArray *out) {
+		if (!stream->release) {
+			return -1;
+		}
+		auto data = (BatchRowsExport *)stream->private_data;
+		// a released array marks the end of the stream
+		out->release = nullptr;
+		try {
+			DataChunk chunk;
+			data->rows.InitializeScanChunk(data->scan_state, chunk);
+			if (data->rows.Scan(data->scan_state, chunk)) {
+				ArrowConverter::ToArrowArray(chunk, out);
+			}
+		} catch (std::exception &ex) {
+			data->last_error = PreservedError(ex).Message();
+			return -1;
+		}
+		return 0;
+	}
+
+	static const char *GetLastError(struct ArrowArrayStream *stream) {
+		if (!stream->release) {
+			return "stream was released";
+		}
+		auto data = (BatchRowsExport *)stream->private_data;
+		return data->last_error.c_str();
+	}
+
+	static void Release(struct ArrowArrayStream *stream) {
+		if (!stream->release) {
+			return;
+		}
+		stream->release = nullptr;
+		delete (BatchRowsExport *)stream->private_data;
+	}
+};
+
+PreparedBatch::PreparedBatch(PreparedStatement &statement) : statement(statement) {
+}
+
+PreparedBatch::~PreparedBatch() {
+}
+
+unique_ptr<TableRef> PreparedBatch::RowsScan(ClientContext &context) {
+	rows_scan = make_unique<ArrowScanFactory>(this, ProduceRows, GetRowsSchema, nullptr);
+	auto parameters = rows_scan->Parameters();
+	// the pointers can't be written in SQL: parse placeholders and replace them
+	auto statements = context.ParseStatements("SELECT * FROM arrow_scan(NULL, NULL, NULL)");
+	auto &select = (SelectNode &)*((SelectStatement &)*statements[0]).node;
+	idx_t index = 0;
+	ParsedExpressionIterator::EnumerateTableRefChildren(*select.from_table, [&](unique_ptr<ParsedExpression> &expr) {
+		ParsedExpressionIterator::EnumerateChildren(*expr, [&](unique_ptr<ParsedExpression> &child) {
+			((ConstantExpression &)*child).value = parameters[index++];
+		});
+	});
+	return move(select.from_table);
+}
+
+duckdb_state PreparedBatch::ProduceRows(void *data, duckdb_arrow_scan_info info, duckdb_arrow_array_stream out_stream) {
+	auto &batch = *(PreparedBatch *)data;
+	auto &scan_info = *(ArrowScanInfo *)info;
+	auto &rows = *batch.collection;
+	vector<column_t> column_ids;
+	for (auto &name : scan_info.project_columns.second) {
+		idx_t col = 0;
+		while (col < rows.ColumnCount() && ParameterColumn(col + 1) != name) {
+			col++;
+		}
+		if (col == rows.ColumnCount()) {
+			scan_info.error = "Unknown column \"" + name + "\" in the rows of the batch";
+			return DuckDBError;
+		}
+		column_ids.push_back(col);
+	}
+	if (column_ids.empty()) {
+		for (idx_t col = 0; col < rows.ColumnCount(); col++) {
+			column_ids.push_back(col);
+		}
+	}
+	scan_info.row_count = rows.Count();
+
+	auto stream = (ArrowArrayStream *)out_stream;
+	stream->get_schema = BatchRowsExport::GetSchema;
+	stream->get_next = BatchRowsExport::GetNext;
+	stream->get_last_error = BatchRowsExport::GetLastError;
+	stream->release = BatchRowsExport::Release;
+	stream->private_data = new BatchRowsExport(rows, move(column_ids));
+	return DuckDBSuccess;
+}
+
+duckdb_state PreparedBatch::GetRowsSchema(void *data, duckdb_arrow_schema out_schema) {
+	auto &rows = *((PreparedBatch *)data)->collection;
+	vector<LogicalType> types = rows.Types();
+	vector<string> names;
+	for (idx_t col = 0; col < rows.ColumnCount(); col++) {
+		names.push_back(ParameterColumn(col + 1));
+	}
+	try {
+		string timezone = "UTC";
+		ArrowConverter::ToArrowSchema((ArrowSchema *)out_schema, types, names, timezone);
+	} catch (...) {
+		return DuckDBError;
+	}
+	return DuckDBSuccess;
+}
+
+// Layout must match the table function state in duckdb/main/capi/table_function-c.cpp
+struct CTableFunctionInfo : public TableFunctionInfo {
+	~CTableFunctionInfo() {
+		if (extra_info && delete_callback) {
+			delete_callback(extra_info);
+		}
+		extra_info = nullptr;
+		delete_callback = nullptr;
+	}
+
+	duckdb_table_function_bind_t bind = nullptr;
+	duckdb_table_function_init_t init = nullptr;
+	duckdb_table_function_init_t local_init = nullptr;
+	duckdb_table_function_t function = nullptr;
+	void *extra_info = nullptr;
+	duckdb_delete_callback_t delete_callback = nullptr;
+};
+
+struct CTableBindData : public TableFunctionData {
+	~CTableBindData() {
+		if (bind_data && delete_callback) {
+			delete_callback(bind_data);
+		}
+		bind_data = nullptr;
+		delete_callback = nullptr;
+	}
+
+	CTableFunctionInfo *info = nullptr;
+	void *bind_data = nullptr;
+	duckdb_delete_callback_t delete_callback = nullptr;
+	unique_ptr<NodeStatistics> stats;
+};
+
+struct CTableInitData {
+	~CTableInitData() {
+		if (init_data && delete_callback) {
+			delete_callback(init_data);
+		}
+		init_data = nullptr;
+		delete_callback = nullptr;
+	}
+
+	void *init_data = nullptr;
+	duckdb_delete_callback_t delete_callback = nullptr;
+	idx_t max_threads = 1;
+};
+
+struct CTableGlobalInitData : public GlobalTableFunctionState {
+	CTableInitData init_data;
+
+	idx_t MaxThreads() const override {
+		return init_data.max_threads;
+	}
+};
+
+struct CTableLocalInitData : public LocalTableFunctionState {
+	CTableInitData init_data;
+};
+
+struct CTableInternalInitInfo {
+	CTableInternalInitInfo(const CTableBindData &bind_data, CTableInitData &init_data,
+	                       const vector<column_t> &column_ids, TableFilterSet *filters)
+	    : bind_data(bind_data), init_data(init_data), column_ids(column_ids), filters(filters) {
+	}
+
+	const CTableBindData &bind_data;
+	CTableInitData &init_data;
+	const vector<column_t> &column_ids;
+	TableFilterSet *filters;
+	bool success = true;
+	string error;
+};
+
+//! The info of a C table function with the hooks the C API does not have, e.g. for parallel scans: it takes over the
+//! info created by duckdb_create_table_function once one of them is set
+struct CTableFunctionExtInfo : public CTableFunctionInfo {
+	explicit CTableFunctionExtInfo(CTableFunctionInfo &info) : CTableFunctionInfo(info) {
+		// the extra info now belongs to this info
+		info.extra_info = nullptr;
+		info.delete_callback = nullptr;
+	}
+
+	duckdb_table_function_progress_t progress = nullptr;
+	duckdb_table_function_batch_index_t batch_index = nullptr;
+
+	static CTableFunctionExtInfo &Get(TableFunction &function) {
+		auto info = dynamic_cast<CTableFunctionExtInfo *>(function.function_info.get());
+		if (!info) {
+			auto ext_info = make_shared<CTableFunctionExtInfo>((CTableFunctionInfo &)*function.function_info);
+			info = ext_info.get();
+			function.function_info = move(ext_info);
+		}
+		return *info;
+	}
+
+	static double Progress(ClientContext &context, const FunctionData *bind_data_p,
+	                       const GlobalTableFunctionState *global_state) {
+		auto &bind_data = (const CTableBindData &)*bind_data_p;
+		auto &info = (CTableFunctionExtInfo &)*bind_data.info;
+		auto &global_data = (const CTableGlobalInitData &)*global_state;
+		return info.progress(bind_data.bind_data, global_data.init_data.init_data);
+	}
+
+	static idx_t GetBatchIndex(ClientContext &context, const FunctionData *bind_data_p,
+	                           LocalTableFunctionState *local_state, GlobalTableFunctionState *global_state) {
+		auto &bind_data = (const CTableBindData &)*bind_data_p;
+		auto &info = (CTableFunctionExtInfo &)*bind_data.info;
+		auto &global_data = (CTableGlobalInitData &)*global_state;
+		auto local_data = local_state ? ((CTableLocalInitData *)local_state)->init_data.init_data : nullptr;
+		return info.batch_index(bind_data.bind_data, global_data.init_data.init_data, local_data);
+	}
+};
+
+//! The state of a scalar function created through the C API, shared by the copies the catalog makes of it
+struct CScalarFunctionInfo {
+	//! The info passed to the callback, for one chunk
+	struct CScalarFunctionInternalInfo {
+		explicit CScalarFunctionInternalInfo(CScalarFunctionInfo &info) : info(info) {
+		}
+
+		CScalarFunctionInfo &info;
+		bool success = true;
+		string error;
+	};
+
+	~CScalarFunctionInfo() {
+		if (extra_info && delete_callback) {
+			delete_callback(extra_info);
+		}
+		extra_info = nullptr;
+		delete_callback = nullptr;
+	}
+
+	duckdb_scalar_function_t function = nullptr;
+	void *extra_info = nullptr;
+	duckdb_delete_callback_t delete_callback = nullptr;
+
+	//! Runs the callback on a chunk of arguments: the other vectors are flattened for it, while the constant ones
+	//! pass through with their single row
+	void Execute(DataChunk &args, Vector &result) {
+		for (auto &vector : args.data) {
+			if (vector.GetVectorType() != VectorType::CONSTANT_VECTOR) {
+				vector.Flatten(args.size());
+			}
+		}
+		CScalarFunctionInternalInfo info(*this);
+		function((duckdb_function_info)&info, (duckdb_data_chunk)&args, (duckdb_vector)&result);
+		if (!info.success) {
+			throw InvalidInputException(info.error);
+		}
+	}
+};
+
+struct ScalarFunctionWrapper {
+	ScalarFunctionWrapper()
+	    : function("", {}, LogicalType::INVALID, nullptr), info(make_shared<CScalarFunctionInfo>()) {
+	}
+
+	ScalarFunction function;
+	shared_ptr<CScalarFunctionInfo> info;
+	string error;
+};
+
+} // namespace duckdb
+
+using duckdb::ArrowAppend;
+using duckdb::ArrowConverter;
+using duckdb::ArrowScanFactory;
+using duckdb::ArrowScanInfo;
+using duckdb::ArrowStreamExport;
+using duckdb::AppenderWrapper;
+using duckdb::BorrowingAppender;
+using duckdb::BufferedAppender;
+using duckdb::ArrowStreamWrapper;
+using duckdb::CScalarFunctionInfo;
+using duckdb::DecimalToValue;
+using duckdb::ParallelAppend;
+using duckdb::ParallelAppenderWrapper;
+using duckdb::ConjunctionFilter;
+using duckdb::ConstantFilter;
+using duckdb::CTableFunctionExtInfo;
+using duckdb::CTableInternalInitInfo;
+using duckdb::idx_t;
+using duckdb::InputStream;
+using duckdb::InputStreamWrapper;
+using duckdb::PendingQueryResult;
+using duckdb::PendingStatementWrapper;
+using duckdb::PreparedBatch;
+using duckdb::PreparedBatchWrapper;
+using duckdb::ScalarFunctionWrapper;
+using duckdb::PreparedStatementWrapper;
+using duckdb::QueryResultType;
+using duckdb::StreamFileSystem;
+
+//===--------------------------------------------------------------------===//
+// Open/Connect
+//===--------------------------------------------------------------------===//
+void duckdb_interrupt(duckdb_connection connection) {
+	if (!connection) {
+		return;
+	}
+	auto conn = (duckdb::Connection *)connection;
+	conn->Interrupt();
+}
+
+void duckdb_enable_query_progress(duckdb_connection connection) {
+	if (!connection) {
+		return;
+	}
+	auto conn = (duckdb::Connection *)connection;
+	// the progress is only tracked while the progress bar is enabled
+	conn->context->config.enable_progress_bar = true;
+	conn->context->config.print_progress_bar = false;
+}
+
+double duckdb_query_progress(duckdb_connection connection) {
+	if (!connection) {
+		return -1;
+	}
+	auto conn = (duckdb::Connection *)connection;
+	if (!conn->context->config.enable_progress_bar) {
+		return -1;
+	}
+	return conn->context->GetProgress();
+}
+
+//===--------------------------------------------------------------------===//
+// Prepared Statements
+//===--------------------------------------------------------------------===//
+duckdb_state duckdb_bind_decimal(duckdb_prepared_statement prepared_statement, idx_t param_idx, duckdb_decimal val) {
+	auto wrapper = (PreparedStatementWrapper *)prepared_statement;
+	if (!wrapper || !wrapper->statement || wrapper->statement->HasError()) {
+		return DuckDBError;
+	}
+	if (param_idx <= 0 || param_idx > wrapper->statement->n_param) {
+		return DuckDBError;
+	}
+	try {
+		if (param_idx > wrapper->values.size()) {
+			wrapper->values.resize(param_idx);
+		}
+		wrapper->values[param_idx - 1] = DecimalToValue(val);
+	} catch (...) {
+		return DuckDBError;
+	}
+	return DuckDBSuccess;
+}
+
+//===--------------------------------------------------------------------===//
+// Pending Result Interface
+//===--------------------------------------------------------------------===//
+duckdb_state duckdb_pending_prepared_streaming(duckdb_prepared_statement prepared_statement,
+                                               duckdb_pending_result *out_result) {
+	if (!prepared_statement || !out_result) {
+		return DuckDBError;
+	}
+	auto wrapper = (PreparedStatementWrapper *)prepared_statement;
+	auto result = new PendingStatementWrapper();
+	try {
+		result->statement = wrapper->statement->PendingQuery(wrapper->values, true);
+	} catch (std::exception &ex) {
+		result->statement = duckdb::make_unique<PendingQueryResult>(duckdb::PreservedError(ex));
+	}
+	duckdb_state return_value = !result->statement->HasError() ? DuckDBSuccess : DuckDBError;
+	*out_result = (duckdb_pending_result)result;
+	return return_value;
+}
+
+duckdb_state duckdb_execute_pending_arrow(duckdb_pending_result pending_result, duckdb_arrow_stream *out_result) {
+	if (!pending_result || !out_result) {
+		return DuckDBError;
+	}
+	auto wrapper = (PendingStatementWrapper *)pending_result;
+	auto stream = new ArrowStreamWrapper();
+	*out_result = (duckdb_arrow_stream)stream;
+	if (!wrapper->statement) {
+		stream->error = "Pending statement has already been executed";
+		return DuckDBError;
+	}
+	try {
+		stream->result = wrapper->statement->Execute();
+	} catch (std::exception &ex) {
+		stream->error = duckdb::PreservedError(ex).Message();
+		wrapper->statement.reset();
+		return DuckDBError;
+	}
+	wrapper->statement.reset();
+	if (stream->result->HasError()) {
+		stream->error = stream->result->GetError();
+		return DuckDBError;
+	}
+	return DuckDBSuccess;
+}
+
+//===--------------------------------------------------------------------===//
+// Arrow Stream Interface
+//===--------------------------------------------------------------------===//
+duckdb_state duckdb_arrow_stream_schema(duckdb_arrow_stream result, duckdb_arrow_schema *out_schema) {
+	if (!result || !out_schema) {
+		return DuckDBError;
+	}
+	auto wrapper = (ArrowStreamWrapper *)result;
+	if (!wrapper->result) {
+		return DuckDBError;
+	}
+	auto timezone_config = duckdb::QueryResult::GetConfigTimezone(*wrapper->result);
+	ArrowConverter::ToArrowSchema((ArrowSchema *)*out_schema, wrapper->result->types, wrapper->result->names,
+	                              timezone_config);
+	return DuckDBSuccess;
+}
+
+duckdb_state duckdb_arrow_stream_array(duckdb_arrow_stream result, duckdb_arrow_array *out_array) {
+	if (!result || !out_array) {
+		return DuckDBError;
+	}
+	auto wrapper = (ArrowStreamWrapper *)result;
+	if (!wrapper->result) {
+		return DuckDBError;
+	}
+	if (!duckdb::FetchArrowChunk(*wrapper, (ArrowArray *)*out_array, wrapper->error)) {
+		return DuckDBError;
+	}
+	return DuckDBSuccess;
+}
+
+duckdb_state duckdb_arrow_stream_set_batch_size(duckdb_arrow_stream result, idx_t batch_size) {
+	if (!result) {
+		return DuckDBError;
+	}
+	auto wrapper = (ArrowStreamWrapper *)result;
+	if (batch_size == 0) {
+		wrapper->error = "Arrow batch size must be at least 1";
+		return DuckDBError;
+	}
+	wrapper->batch_size = batch_size;
+	return DuckDBSuccess;
+}
+
+duckdb_state duckdb_arrow_stream_set_parallel(duckdb_arrow_stream result, duckdb_prepared_statement prepared_statement) {
+	if (!result || !prepared_statement) {
+		return DuckDBError;
+	}
+	auto wrapper = (ArrowStreamWrapper *)result;
+	auto statement = (PreparedStatementWrapper *)prepared_statement;
+	if (!wrapper->result || wrapper->result->type != QueryResultType::MATERIALIZED_RESULT || wrapper->parallel ||
+	    wrapper->fetched_rows > 0 || !statement->statement) {
+		return DuckDBError;
+	}
+	wrapper->parallel_context = statement->statement->context;
+	return DuckDBSuccess;
+}
+
+idx_t duckdb_arrow_stream_column_count(duckdb_arrow_stream result) {
+	auto wrapper = (ArrowStreamWrapper *)result;
+	if (!wrapper || !wrapper->result) {
+		return 0;
+	}
+	return wrapper->result->ColumnCount();
+}
+
+idx_t duckdb_arrow_stream_row_count(duckdb_arrow_stream result) {
+	auto wrapper = (ArrowStreamWrapper *)result;
+	if (!wrapper || !wrapper->result) {
+		return 0;
+	}
+	if (wrapper->result->type == QueryResultType::MATERIALIZED_RESULT) {
+		return ((duckdb::MaterializedQueryResult &)*wrapper->result).RowCount();
+	}
+	return wrapper->fetched_rows;
+}
+
+idx_t duckdb_arrow_stream_rows_changed(duckdb_arrow_stream result) {
+	auto wrapper = (ArrowStreamWrapper *)result;
+	if (!wrapper || !wrapper->result || wrapper->result->HasError()) {
+		return 0;
+	}
+	if (wrapper->result->type != QueryResultType::MATERIALIZED_RESULT ||
+	    !duckdb::StatementReturnsChanges(wrapper->result->statement_type)) {
+		return 0;
+	}
+	auto &materialized = (duckdb::MaterializedQueryResult &)*wrapper->result;
+	if (materialized.RowCount() == 0) {
+		return 0;
+	}
+	return materialized.GetValue(0, 0).GetValue<int64_t>();
+}
+
+const char *duckdb_arrow_stream_error(duckdb_arrow_stream result) {
+	auto wrapper = (ArrowStreamWrapper *)result;
+	if (!wrapper) {
+		return nullptr;
+	}
+	return wrapper->error.c_str();
+}
+
+void duckdb_destroy_arrow_stream(duckdb_arrow_stream *result) {
+	if (result && *result) {
+		auto wrapper = (ArrowStreamWrapper *)*result;
+		delete wrapper;
+		*result = nullptr;
+	}
+}
+
+duckdb_state duckdb_arrow_stream_export(duckdb_arrow_stream *result, duckdb_arrow_array_stream out_stream) {
+	if (!result || !*result || !out_stream) {
+		return DuckDBError;
+	}
+	auto wrapper = (ArrowStreamWrapper *)*result;
+	if (!wrapper->result) {
+		return DuckDBError;
+	}
+	auto data = new ArrowStreamExport();
+	data->stream = duckdb::unique_ptr<ArrowStreamWrapper>(wrapper);
+	*result = nullptr;
+
+	auto stream = (ArrowArrayStream *)out_stream;
+	stream->get_schema = ArrowStreamExport::GetSchema;
+	stream->get_next = ArrowStreamExport::GetNext;
+	stream->get_last_error = ArrowStreamExport::GetLastError;
+	stream->release = ArrowStreamExport::Release;
+	stream->private_data = data;
+	return DuckDBSuccess;
+}
+
+//===--------------------------------------------------------------------===//
+// Appender
+//===--------------------------------------------------------------------===//
+idx_t duckdb_appender_column_count(duckdb_appender appender) {
+	if (!appender) {
+		return 0;
+	}
+	auto wrapper = (AppenderWrapper *)appender;
+	if (!wrapper->appender) {
+		return 0;
+	}
+	return wrapper->appender->GetTypes().size();
+}
+
+duckdb_logical_type duckdb_appender_column_type(duckdb_appender appender, idx_t col_idx) {
+	if (!appender) {
+		return nullptr;
+	}
+	auto wrapper = (AppenderWrapper *)appender;
+	if (!wrapper->appender || col_idx >= wrapper->appender->GetTypes().size()) {
+		return nullptr;
+	}
+	return (duckdb_logical_type) new duckdb::LogicalType(wrapper->appender->GetTypes()[col_idx]);
+}
+
+duckdb_state duckdb_append_arrow_array(duckdb_appender appender, duckdb_arrow_schema schema, duckdb_arrow_array array) {
+	if (!appender || !schema || !array) {
+		return DuckDBError;
+	}
+	auto wrapper = (AppenderWrapper *)appender;
+	if (!wrapper->appender) {
+		return DuckDBError;
+	}
+	try {
+		ArrowAppend append(*(ArrowSchema *)schema, *(ArrowArray *)array);
+		append.Append(*wrapper->appender);
+	} catch (std::exception &ex) {
+		wrapper->error = ex.what();
+		return DuckDBError;
+	} catch (...) {
+		wrapper->error = "Unknown error";
+		return DuckDBError;
+	}
+	return DuckDBSuccess;
+}
+
+static duckdb_state AppendBorrowed(duckdb_appender appender, duckdb::LogicalTypeId type, const char *data,
+                                   idx_t length) {
+	if (!appender || (!data && length > 0)) {
+		return DuckDBError;
+	}
+	auto wrapper = (AppenderWrapper *)appender;
+	if (!wrapper->appender) {
+		return DuckDBError;
+	}
+	try {
+		if (length > duckdb::NumericLimits<uint32_t>::Maximum()) {
+			throw duckdb::InvalidInputException("String of " + std::to_string(length) + " bytes is too long to append");
+		}
+		auto borrowing = dynamic_cast<BorrowingAppender *>(wrapper->appender.get());
+		if (borrowing) {
+			borrowing->AppendBorrowed(type, data, length);
+		} else if (type == duckdb::LogicalTypeId::BLOB) {
+			// appenders not created by duckdb_appender_create_ext copy the value
+			wrapper->appender->Append<duckdb::Value>(duckdb::Value::BLOB((duckdb::const_data_ptr_t)data, length));
+		} else {
+			wrapper->appender->Append(data, length);
+		}
+	} catch (std::exception &ex) {
+		wrapper->error = ex.what();
+		return DuckDBError;
+	} catch (...) {
+		wrapper->error = "Unknown error";
+		return DuckDBError;
+	}
+	return DuckDBSuccess;
+}
+
+duckdb_state duckdb_appender_release_borrowed(duckdb_appender appender) {
+	if (!appender) {
+		return DuckDBError;
+	}
+	auto wrapper = (AppenderWrapper *)appender;
+	if (!wrapper->appender) {
+		return DuckDBError;
+	}
+	auto borrowing = dynamic_cast<BorrowingAppender *>(wrapper->appender.get());
+	if (!borrowing) {
+		// nothing is borrowed by other appenders
+		return DuckDBSuccess;
+	}
+	try {
+		borrowing->ReleaseBorrowed();
+	} catch (std::exception &ex) {
+		wrapper->error = ex.what();
+		return DuckDBError;
+	} catch (...) {
+		wrapper->error = "Unknown error";
+		return DuckDBError;
+	}
+	return DuckDBSuccess;
+}
+
+duckdb_state duckdb_append_varchar_borrowed(duckdb_appender appender, const char *val, idx_t length) {
+	return AppendBorrowed(appender, duckdb::LogicalTypeId::VARCHAR, val, length);
+}
+
+duckdb_state duckdb_append_blob_borrowed(duckdb_appender appender, const void *data, idx_t length) {
+	return AppendBorrowed(appender, duckdb::LogicalTypeId::BLOB, (const char *)data, length);
+}
+
+duckdb_state duckdb_append_decimal(duckdb_appender appender, duckdb_decimal value) {
+	if (!appender) {
+		return DuckDBError;
+	}
+	auto wrapper = (AppenderWrapper *)appender;
+	if (!wrapper->appender) {
+		return DuckDBError;
+	}
+	try {
+		wrapper->appender->Append<duckdb::Value>(DecimalToValue(value));
+	} catch (std::exception &ex) {
+		wrapper->error = ex.what();
+		return DuckDBError;
+	} catch (...) {
+		wrapper->error = "Unknown error";
+		return DuckDBError;
+	}
+	return DuckDBSuccess;
+}
+
+//===--------------------------------------------------------------------===//
+// Parallel Appender
+//===--------------------------------------------------------------------===//
+duckdb_state duckdb_parallel_appender_create(duckdb_connection connection, const char *schema, const char *table,
+                                             duckdb_parallel_appender *out_appender) {
+	if (!connection || !table || !out_appender) {
+		return DuckDBError;
+	}
+	if (schema == nullptr) {
+		schema = DEFAULT_SCHEMA;
+	}
+	auto conn = (duckdb::Connection *)connection;
+	auto wrapper = new ParallelAppenderWrapper();
+	*out_appender = (duckdb_parallel_appender)wrapper;
+	try {
+		wrapper->appender = duckdb::make_unique<ParallelAppend>(*conn, schema, table);
+	} catch (std::exception &ex) {
+		wrapper->error = ex.what();
+		return DuckDBError;
+	} catch (...) {
+		wrapper->error = "Unknown create appender error";
+		return DuckDBError;
+	}
+	return DuckDBSuccess;
+}
+
+duckdb_state duckdb_parallel_appender_local(duckdb_parallel_appender appender, duckdb_appender *out_appender) {
+	if (!appender || !out_appender) {
+		return DuckDBError;
+	}
+	auto wrapper = (ParallelAppenderWrapper *)appender;
+	if (!wrapper->appender) {
+		return DuckDBError;
+	}
+	auto local = new AppenderWrapper();
+	*out_appender = (duckdb_appender)local;
+	try {
+		local->appender = wrapper->appender->CreateLocalAppender();
+	} catch (std::exception &ex) {
+		local->error = ex.what();
+		return DuckDBError;
+	} catch (...) {
+		local->error = "Unknown create appender error";
+		return DuckDBError;
+	}
+	return DuckDBSuccess;
+}
+
+duckdb_state duckdb_parallel_appender_commit(duckdb_parallel_appender appender) {
+	if (!appender) {
+		return DuckDBError;
+	}
+	auto wrapper = (ParallelAppenderWrapper *)appender;
+	if (!wrapper->appender) {
+		return DuckDBError;
+	}
+	try {
+		wrapper->appender->Commit();
+	} catch (std::exception &ex) {
+		wrapper->error = ex.what();
+		return DuckDBError;
+	} catch (...) {
+		wrapper->error = "Unknown error";
+		return DuckDBError;
+	}
+	return DuckDBSuccess;
+}
+
+const char *duckdb_parallel_appender_error(duckdb_parallel_appender appender) {
+	if (!appender) {
+		return nullptr;
+	}
+	auto wrapper = (ParallelAppenderWrapper *)appender;
+	if (wrapper->error.empty()) {
+		return nullptr;
+	}
+	return wrapper->error.c_str();
+}
+
+void duckdb_parallel_appender_destroy(duckdb_parallel_appender *appender) {
+	if (appender && *appender) {
+		auto wrapper = (ParallelAppenderWrapper *)*appender;
+		delete wrapper;
+		*appender = nullptr;
+	}
+}
+
+duckdb_state duckdb_appender_create_ext(duckdb_connection connection, const char *schema, const char *table,
+                                        bool manual_flush, bool background_flush, duckdb_appender *out_appender) {
+	if (!connection || !table || !out_appender) {
+		return DuckDBError;
+	}
+	if (schema == nullptr) {
+		schema = DEFAULT_SCHEMA;
+	}
+	auto conn = (duckdb::Connection *)connection;
+	auto wrapper = new AppenderWrapper();
+	*out_appender = (duckdb_appender)wrapper;
+	try {
+		wrapper->appender = duckdb::make_unique<BufferedAppender>(*conn, schema, table, manual_flush, background_flush);
+	} catch (std::exception &ex) {
+		wrapper->error = ex.what();
+		return DuckDBError;
+	} catch (...) {
+		wrapper->error = "Unknown create appender error";
+		return DuckDBError;
+	}
+	return DuckDBSuccess;
+}
+
+duckdb_state duckdb_appender_flush_ext(duckdb_appender appender, bool wait, idx_t bytes,
+                                       duckdb_appender_flush_stats *out_stats) {
+	if (!appender) {
+		return DuckDBError;
+	}
+	auto wrapper = (AppenderWrapper *)appender;
+	if (!wrapper->appender) {
+		return DuckDBError;
+	}
+	auto buffered = dynamic_cast<BufferedAppender *>(wrapper->appender.get());
+	try {
+		if (buffered) {
+			buffered->FlushAll(wait, bytes);
+		} else {
+			wrapper->appender->Flush();
+		}
+	} catch (std::exception &ex) {
+		wrapper->error = ex.what();
+		return DuckDBError;
+	} catch (...) {
+		wrapper->error = "Unknown error";
+		return DuckDBError;
+	}
+	if (out_stats) {
+		*out_stats = duckdb_appender_flush_stats();
+		if (buffered) {
+			buffered->GetStats(*out_stats);
+		}
+	}
+	return DuckDBSuccess;
+}
+
+//===--------------------------------------------------------------------===//
+// Prepared Batch
+//===--------------------------------------------------------------------===//
+duckdb_state duckdb_prepared_batch_create(duckdb_prepared_statement prepared_statement,
+                                          duckdb_prepared_batch *out_batch) {
+	if (!prepared_statement || !out_batch) {
+		return DuckDBError;
+	}
+	auto wrapper = (PreparedStatementWrapper *)prepared_statement;
+	auto batch = new PreparedBatchWrapper();
+	*out_batch = (duckdb_prepared_batch)batch;
+	if (!wrapper->statement || wrapper->statement->HasError()) {
+		batch->error = "Prepared statement is not valid";
+		return DuckDBError;
+	}
+	batch->batch = duckdb::make_unique<PreparedBatch>(*wrapper->statement);
+	return DuckDBSuccess;
+}
+
+duckdb_state duckdb_prepared_batch_append_data_chunk(duckdb_prepared_batch batch, duckdb_data_chunk chunk) {
+	if (!batch || !chunk) {
+		return DuckDBError;
+	}
+	auto wrapper = (PreparedBatchWrapper *)batch;
+	if (!wrapper->batch) {
+		return DuckDBError;
+	}
+	try {
+		wrapper->batch->Append(*(duckdb::DataChunk *)chunk);
+	} catch (std::exception &ex) {
+		wrapper->error = ex.what();
+		return DuckDBError;
+	} catch (...) {
+		wrapper->error = "Unknown error";
+		return DuckDBError;
+	}
+	return DuckDBSuccess;
+}
+
+duckdb_state duckdb_prepared_batch_append_arrow_array(duckdb_prepared_batch batch, duckdb_arrow_schema schema,
+                                                      duckdb_arrow_array array) {
+	if (!batch || !schema || !array) {
+		return DuckDBError;
+	}
+	auto wrapper = (PreparedBatchWrapper *)batch;
+	if (!wrapper->batch) {
+		return DuckDBError;
+	}
+	try {
+		wrapper->batch->Append(*(ArrowSchema *)schema, *(ArrowArray *)array);
+	} catch (std::exception &ex) {
+		wrapper->error = ex.what();
+		return DuckDBError;
+	} catch (...) {
+		wrapper->error = "Unknown error";
+		return DuckDBError;
+	}
+	return DuckDBSuccess;
+}
+
+duckdb_state duckdb_prepared_batch_execute(duckdb_prepared_batch batch, idx_t *out_rows_changed) {
+	if (!batch) {
+		return DuckDBError;
+	}
+	auto wrapper = (PreparedBatchWrapper *)batch;
+	if (!wrapper->batch) {
+		return DuckDBError;
+	}
+	try {
+		auto changes = wrapper->batch->Execute();
+		if (out_rows_changed) {
+			*out_rows_changed = changes;
+		}
+	} catch (std::exception &ex) {
+		wrapper->error = duckdb::PreservedError(ex).Message();
+		return DuckDBError;
+	} catch (...) {
+		wrapper->error = "Unknown error";
+		return DuckDBError;
+	}
+	return DuckDBSuccess;
+}
+
+const char *duckdb_prepared_batch_error(duckdb_prepared_batch batch) {
+	if (!batch) {
+		return nullptr;
+	}
+	auto wrapper = (PreparedBatchWrapper *)batch;
+	if (wrapper->error.empty()) {
+		return nullptr;
+	}
+	return wrapper->error.c_str();
+}
+
+void duckdb_prepared_batch_destroy(duckdb_prepared_batch *batch) {
+	if (batch && *batch) {
+		auto wrapper = (PreparedBatchWrapper *)*batch;
+		delete wrapper;
+		*batch = nullptr;
+	}
+}
+
+//===--------------------------------------------------------------------===//
+// Input Streams
+//===--------------------------------------------------------------------===//
+duckdb_state duckdb_input_stream_create(duckdb_connection connection, idx_t window_size,
+                                        duckdb_input_stream *out_stream) {
+	if (!connection || !out_stream) {
+		return DuckDBError;
+	}
+	auto conn = (duckdb::Connection *)connection;
+	try {
+		StreamFileSystem::Register(*conn->context->db);
+		auto wrapper = duckdb::make_unique<InputStreamWrapper>();
+		wrapper->stream = std::make_shared<InputStream>(window_size);
+		wrapper->path = StreamFileSystem::AddStream(wrapper->stream);
+		*out_stream = (duckdb_input_stream)wrapper.release();
+	} catch (...) {
+		*out_stream = nullptr;
+		return DuckDBError;
+	}
+	return DuckDBSuccess;
+}
+
+const char *duckdb_input_stream_path(duckdb_input_stream stream) {
+	if (!stream) {
+		return nullptr;
+	}
+	auto wrapper = (InputStreamWrapper *)stream;
+	return wrapper->path.c_str();
+}
+
+duckdb_state duckdb_input_stream_write(duckdb_input_stream stream, const void *data, idx_t length) {
+	if (!stream || (!data && length > 0)) {
+		return DuckDBError;
+	}
+	auto wrapper = (InputStreamWrapper *)stream;
+	return wrapper->stream->Write((const char *)data, length) ? DuckDBSuccess : DuckDBError;
+}
+
+void duckdb_input_stream_close(duckdb_input_stream stream, const char *error) {
+	if (!stream) {
+		return;
+	}
+	auto wrapper = (InputStreamWrapper *)stream;
+	wrapper->stream->Close(error ? error : "");
+}
+
+void duckdb_input_stream_stop(duckdb_input_stream stream) {
+	if (!stream) {
+		return;
+	}
+	auto wrapper = (InputStreamWrapper *)stream;
+	wrapper->stream->Stop();
+}
+
+void duckdb_input_stream_destroy(duckdb_input_stream *stream) {
+	if (stream && *stream) {
+		auto wrapper = (InputStreamWrapper *)*stream;
+		StreamFileSystem::RemoveStream(wrapper->path);
+		// a query still reading the stream fails instead of waiting forever
+		wrapper->stream->Stop();
+		delete wrapper;
+		*stream = nullptr;
+	}
+}
+
+//===--------------------------------------------------------------------===//
+// Values
+//===--------------------------------------------------------------------===//
+duckdb_logical_type duckdb_get_value_type(duckdb_value value) {
+	if (!value) {
+		return nullptr;
+	}
+	auto val = (duckdb::Value *)value;
+	return (duckdb_logical_type)&val->type();
+}
+
+//===--------------------------------------------------------------------===//
+// Table Functions
+//===--------------------------------------------------------------------===//
+void duckdb_table_function_set_progress(duckdb_table_function function, duckdb_table_function_progress_t progress) {
+	if (!function || !progress) {
+		return;
+	}
+	auto tf = (duckdb::TableFunction *)function;
+	auto &info = CTableFunctionExtInfo::Get(*tf);
+	info.progress = progress;
+	tf->table_scan_progress = CTableFunctionExtInfo::Progress;
+}
+
+void duckdb_table_function_set_batch_index(duckdb_table_function function,
+                                           duckdb_table_function_batch_index_t batch_index) {
+	if (!function || !batch_index) {
+		return;
+	}
+	auto tf = (duckdb::TableFunction *)function;
+	auto &info = CTableFunctionExtInfo::Get(*tf);
+	info.batch_index = batch_index;
+	tf->get_batch_index = CTableFunctionExtInfo::GetBatchIndex;
+}
+
+void duckdb_table_function_supports_filter_pushdown(duckdb_table_function function, bool pushdown) {
+	if (!function) {
+		return;
+	}
+	auto tf = (duckdb::TableFunction *)function;
+	tf->filter_pushdown = pushdown;
+}
+
+idx_t duckdb_init_get_filter_count(duckdb_init_info info) {
+	if (!info) {
+		return 0;
+	}
+	auto init_info = (CTableInternalInitInfo *)info;
+	return init_info->filters ? init_info->filters->filters.size() : 0;
+}
+
+duckdb_table_filter duckdb_init_get_filter(duckdb_init_info info, idx_t filter_index, idx_t *out_column_index) {
+	if (!info || filter_index >= duckdb_init_get_filter_count(info)) {
+		return nullptr;
+	}
+	auto init_info = (CTableInternalInitInfo *)info;
+	auto entry = init_info->filters->filters.begin();
+	std::advance(entry, filter_index);
+	if (out_column_index) {
+		*out_column_index = entry->first;
+	}
+	return (duckdb_table_filter)entry->second.get();
+}
+
+duckdb_table_filter_type duckdb_table_filter_get_type(duckdb_table_filter filter) {
+	auto table_filter = (duckdb::TableFilter *)filter;
+	return (duckdb_table_filter_type)table_filter->filter_type;
+}
+
+duckdb_comparison_type duckdb_table_filter_get_comparison(duckdb_table_filter filter) {
+	auto table_filter = (duckdb::TableFilter *)filter;
+	if (!table_filter || table_filter->filter_type != duckdb::TableFilterType::CONSTANT_COMPARISON) {
+		return DUCKDB_COMPARE_INVALID;
+	}
+	switch (((ConstantFilter *)table_filter)->comparison_type) {
+	case duckdb::ExpressionType::COMPARE_EQUAL:
+		return DUCKDB_COMPARE_EQUAL;
+	case duckdb::ExpressionType::COMPARE_NOTEQUAL:
+		return DUCKDB_COMPARE_NOT_EQUAL;
+	case duckdb::ExpressionType::COMPARE_LESSTHAN:
+		return DUCKDB_COMPARE_LESS_THAN;
+	case duckdb::ExpressionType::COMPARE_LESSTHANOREQUALTO:
+		return DUCKDB_COMPARE_LESS_THAN_OR_EQUAL;
+	case duckdb::ExpressionType::COMPARE_GREATERTHAN:
+		return DUCKDB_COMPARE_GREATER_THAN;
+	case duckdb::ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+		return DUCKDB_COMPARE_GREATER_THAN_OR_EQUAL;
+	default:
+		return DUCKDB_COMPARE_INVALID;
+	}
+}
+
+duckdb_value duckdb_table_filter_get_constant(duckdb_table_filter filter) {
+	auto table_filter = (duckdb::TableFilter *)filter;
+	if (!table_filter || table_filter->filter_type != duckdb::TableFilterType::CONSTANT_COMPARISON) {
+		return nullptr;
+	}
+	return (duckdb_value) new duckdb::Value(((ConstantFilter *)table_filter)->constant);
+}
+
+idx_t duckdb_table_filter_get_child_count(duckdb_table_filter filter) {
+	auto table_filter = (duckdb::TableFilter *)filter;
+	if (!table_filter || (table_filter->filter_type != duckdb::TableFilterType::CONJUNCTION_OR &&
+	                      table_filter->filter_type != duckdb::TableFilterType::CONJUNCTION_AND)) {
+		return 0;
+	}
+	return ((ConjunctionFilter *)table_filter)->child_filters.size();
+}
+
+duckdb_table_filter duckdb_table_filter_get_child(duckdb_table_filter filter, idx_t index) {
+	if (index >= duckdb_table_filter_get_child_count(filter)) {
+		return nullptr;
+	}
+	auto conjunction = (ConjunctionFilter *)filter;
+	return (duckdb_table_filter)conjunction->child_filters[index].get();
+}
+
+//===--------------------------------------------------------------------===//
+// Arrow Scans
+//===--------------------------------------------------------------------===//
+duckdb_arrow_scan duckdb_create_arrow_scan(void *data, duckdb_arrow_scan_produce_t produce,
+                                           duckdb_arrow_scan_schema_t get_schema, duckdb_delete_callback_t destroy) {
+	if (!produce || !get_schema) {
+		return nullptr;
+	}
+	// the client holds one reference to the factory, the queries binding it the others
+	auto factory = std::make_shared<ArrowScanFactory>(data, produce, get_schema, destroy);
+	return (duckdb_arrow_scan) new std::shared_ptr<ArrowScanFactory>(move(factory));
+}
+
+void duckdb_destroy_arrow_scan(duckdb_arrow_scan *scan) {
+	if (scan && *scan) {
+		auto factory = (std::shared_ptr<ArrowScanFactory> *)*scan;
+		delete factory;
+		*scan = nullptr;
+	}
+}
+
+void duckdb_replacement_scan_set_arrow_scan(duckdb_replacement_scan_info info, duckdb_arrow_scan scan) {
+	if (!info || !scan) {
+		return;
+	}
+	auto &factory = *(std::shared_ptr<ArrowScanFactory> *)scan;
+	// the binder binds arrow_scan on this thread right after the replacement scan: the factory is referenced until
+	// then, even if the client destroys the scan in between
+	ArrowScanFactory::binding = factory;
+	duckdb_replacement_scan_set_function_name(info, "arrow_scan");
+	for (auto &parameter : factory->Parameters()) {
+		duckdb_replacement_scan_add_parameter(info, (duckdb_value)&parameter);
+	}
+}
+
+idx_t duckdb_arrow_scan_get_column_count(duckdb_arrow_scan_info info) {
+	if (!info) {
+		return 0;
+	}
+	auto scan_info = (ArrowScanInfo *)info;
+	return scan_info->project_columns.second.size();
+}
+
+const char *duckdb_arrow_scan_get_column_name(duckdb_arrow_scan_info info, idx_t index) {
+	if (index >= duckdb_arrow_scan_get_column_count(info)) {
+		return nullptr;
+	}
+	auto scan_info = (ArrowScanInfo *)info;
+	return scan_info->project_columns.second[index].c_str();
+}
+
+idx_t duckdb_arrow_scan_get_filter_count(duckdb_arrow_scan_info info) {
+	if (!info) {
+		return 0;
+	}
+	auto scan_info = (ArrowScanInfo *)info;
+	return scan_info->filters ? scan_info->filters->filters.size() : 0;
+}
+
+duckdb_table_filter duckdb_arrow_scan_get_filter(duckdb_arrow_scan_info info, idx_t index,
+                                                 const char **out_column_name) {
+	if (index >= duckdb_arrow_scan_get_filter_count(info)) {
+		return nullptr;
+	}
+	auto scan_info = (ArrowScanInfo *)info;
+	auto entry = scan_info->filters->filters.begin();
+	std::advance(entry, index);
+	if (out_column_name) {
+		// the filters are on the projected columns
+		*out_column_name = scan_info->project_columns.first[entry->first].c_str();
+	}
+	return (duckdb_table_filter)entry->second.get();
+}
+
+void duckdb_arrow_scan_set_row_count(duckdb_arrow_scan_info info, idx_t row_count) {
+	if (!info) {
+		return;
+	}
+	auto scan_info = (ArrowScanInfo *)info;
+	scan_info->row_count = row_count;
+}
+
+void duckdb_arrow_scan_set_error(duckdb_arrow_scan_info info, const char *error) {
+	if (!info) {
+		return;
+	}
+	auto scan_info = (ArrowScanInfo *)info;
+	scan_info->error = error ? error : "";
+}
+
+//===--------------------------------------------------------------------===//
+// Scalar Functions
+//===--------------------------------------------------------------------===//
+duckdb_scalar_function duckdb_create_scalar_function() {
+	return (duckdb_scalar_function) new ScalarFunctionWrapper();
+}
+
+void duckdb_destroy_scalar_function(duckdb_scalar_function *function) {
+	if (function && *function) {
+		auto wrapper = (ScalarFunctionWrapper *)*function;
+		delete wrapper;
+		*function = nullptr;
+	}
+}
+
+void duckdb_scalar_function_set_name(duckdb_scalar_function function, const char *name) {
+	if (!function || !name) {
+		return;
+	}
+	auto wrapper = (ScalarFunctionWrapper *)function;
+	wrapper->function.name = name;
+}
+
+void duckdb_scalar_function_add_parameter(duckdb_scalar_function function, duckdb_logical_type type) {
+	if (!function || !type) {
+		return;
+	}
+	auto wrapper = (ScalarFunctionWrapper *)function;
+	wrapper->function.arguments.push_back(*(duckdb::LogicalType *)type);
+}
+
+void duckdb_scalar_function_set_return_type(duckdb_scalar_function function, duckdb_logical_type type) {
+	if (!function || !type) {
+		return;
+	}
+	auto wrapper = (ScalarFunctionWrapper *)function;
+	wrapper->function.return_type = *(duckdb::LogicalType *)type;
+}
+
+void duckdb_scalar_function_set_extra_info(duckdb_scalar_function function, void *extra_info,
+                                           duckdb_delete_callback_t destroy) {
+	if (!function) {
+		return;
+	}
+	auto wrapper = (ScalarFunctionWrapper *)function;
+	wrapper->info->extra_info = extra_info;
+	wrapper->info->delete_callback = destroy;
+}
+
+void duckdb_scalar_function_set_function(duckdb_scalar_function function, duckdb_scalar_function_t execute) {
+	if (!function) {
+		return;
+	}
+	auto wrapper = (ScalarFunctionWrapper *)function;
+	wrapper->info->function = execute;
+}
+
+void duckdb_scalar_function_set_side_effects(duckdb_scalar_function function,
+                                             duckdb_function_side_effects side_effects) {
+	if (!function) {
+		return;
+	}
+	auto wrapper = (ScalarFunctionWrapper *)function;
+	wrapper->function.side_effects = side_effects == DUCKDB_HAS_SIDE_EFFECTS
+	                                     ? duckdb::FunctionSideEffects::HAS_SIDE_EFFECTS
+	                                     : duckdb::FunctionSideEffects::NO_SIDE_EFFECTS;
+}
+
+duckdb_state duckdb_register_scalar_function(duckdb_connection connection, duckdb_scalar_function function) {
+	if (!connection || !function) {
+		return DuckDBError;
+	}
+	auto con = (duckdb::Connection *)connection;
+	auto wrapper = (ScalarFunctionWrapper *)function;
+	wrapper->error.clear();
+	if (wrapper->function.name.empty() || !wrapper->info->function) {
+		wrapper->error = "Scalar function requires a name and a function";
+		return DuckDBError;
+	}
+	auto scalar_function = wrapper->function;
+	auto info = wrapper->info;
+	scalar_function.function = [info](duckdb::DataChunk &args, duckdb::ExpressionState &state,
+	                                  duckdb::Vector &result) { info->Execute(args, result); };
+	try {
+		con->context->RunFunctionInTransaction([&]() {
+			auto &catalog = duckdb::Catalog::GetCatalog(*con->context);
+			duckdb::BuiltinFunctions functions(*con->context, catalog);
+			functions.AddFunction(move(scalar_function));
+		});
+	} catch (std::exception &ex) {
+		wrapper->error = duckdb::PreservedError(ex).Message();
+		return DuckDBError;
+	} catch (...) {
+		wrapper->error = "Unknown error";
+		return DuckDBError;
+	}
+	return DuckDBSuccess;
+}
+
+const char *duckdb_scalar_function_error(duckdb_scalar_function function) {
+	if (!function) {
+		return nullptr;
+	}
+	auto wrapper = (ScalarFunctionWrapper *)function;
+	if (wrapper->error.empty()) {
+		return nullptr;
+	}
+	return wrapper->error.c_str();
+}
+
+void *duckdb_scalar_function_get_extra_info(duckdb_function_info info) {
+	if (!info) {
+		return nullptr;
+	}
+	auto function_info = (CScalarFunctionInfo::CScalarFunctionInternalInfo *)info;
+	return function_info->info.extra_info;
+}
+
+void duckdb_scalar_function_set_error(duckdb_function_info info, const char *error) {
+	if (!info || !error) {
+		return;
+	}
+	auto function_info = (CScalarFunctionInfo::CScalarFunctionInternalInfo *)info;
+	function_info->success = false;
+	function_info->error = error;
+}
+
+bool duckdb_vector_is_constant(duckdb_vector vector) {
+	if (!vector) {
+		return false;
+	}
+	auto v = (duckdb::Vector *)vector;
+	return v->GetVectorType() == duckdb::VectorType::CONSTANT_VECTOR;
+}
+
+void duckdb_vector_set_constant(duckdb_vector vector) {
+	if (!vector) {
+		return;
+	}
+	auto v = (duckdb::Vector *)vector;
+	v->SetVectorType(duckdb::VectorType::CONSTANT_VECTOR);
+}
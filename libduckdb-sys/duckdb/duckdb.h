@@ -185,6 +185,17 @@ typedef struct {
 	idx_t size;
 } duckdb_blob;
 
+typedef struct {
+	// the number of times rows were appended to the table
+	idx_t flushes;
+	// the number of rows appended to the table
+	idx_t rows;
+	// the size of the rows appended to the table, as passed to `duckdb_appender_flush_ext`
+	idx_t bytes;
+	// the time spent appending to the table, in microseconds
+	idx_t micros;
+} duckdb_appender_flush_stats;
+
 typedef struct {
 #if DUCKDB_API_VERSION < DUCKDB_API_0_3_2
 	void *data;
@@ -235,6 +246,11 @@ typedef void *duckdb_arrow;
 typedef void *duckdb_config;
 typedef void *duckdb_arrow_schema;
 typedef void *duckdb_arrow_array;
+typedef void *duckdb_arrow_stream;
+typedef void *duckdb_parallel_appender;
+typedef void *duckdb_prepared_batch;
+typedef void *duckdb_input_stream;
+typedef void *duckdb_arrow_array_stream;
 typedef void *duckdb_logical_type;
 typedef void *duckdb_data_chunk;
 typedef void *duckdb_vector;
@@ -246,6 +262,23 @@ typedef enum {
 	DUCKDB_PENDING_RESULT_NOT_READY = 1,
 	DUCKDB_PENDING_ERROR = 2
 } duckdb_pending_state;
+typedef enum {
+	DUCKDB_TABLE_FILTER_CONSTANT_COMPARISON = 0,
+	DUCKDB_TABLE_FILTER_IS_NULL = 1,
+	DUCKDB_TABLE_FILTER_IS_NOT_NULL = 2,
+	DUCKDB_TABLE_FILTER_CONJUNCTION_OR = 3,
+	DUCKDB_TABLE_FILTER_CONJUNCTION_AND = 4
+} duckdb_table_filter_type;
+typedef enum {
+	DUCKDB_COMPARE_INVALID = 0,
+	DUCKDB_COMPARE_EQUAL = 1,
+	DUCKDB_COMPARE_NOT_EQUAL = 2,
+	DUCKDB_COMPARE_LESS_THAN = 3,
+	DUCKDB_COMPARE_LESS_THAN_OR_EQUAL = 4,
+	DUCKDB_COMPARE_GREATER_THAN = 5,
+	DUCKDB_COMPARE_GREATER_THAN_OR_EQUAL = 6
+} duckdb_comparison_type;
+typedef enum { DUCKDB_NO_SIDE_EFFECTS = 0, DUCKDB_HAS_SIDE_EFFECTS = 1 } duckdb_function_side_effects;
 
 //===--------------------------------------------------------------------===//
 // Open/Connect
@@ -301,6 +334,36 @@ Closes the specified connection and de-allocates all memory allocated for that c
 */
 DUCKDB_API void duckdb_disconnect(duckdb_connection *connection);
 
+/*!
+Interrupts the query that is currently running on the connection, if any. The query fails with an interrupt error
+within one task of its execution, freeing the resources it holds.
+
+This function can be called from any thread, while another thread is running the query.
+
+* connection: The connection to interrupt.
+*/
+DUCKDB_API void duckdb_interrupt(duckdb_connection connection);
+
+/*!
+Enables tracking the progress of the queries run on the connection, see `duckdb_query_progress`. The progress is
+not printed.
+
+* connection: The connection to track the progress of.
+*/
+DUCKDB_API void duckdb_enable_query_progress(duckdb_connection connection);
+
+/*!
+Returns the progress of the query running on the connection as a percentage between 0 and 100, or of the last query
+once it has finished. The progress is estimated from the sources of the query plan, and only updated as the query
+runs its tasks.
+
+This function can be called from any thread, while another thread is running the query.
+
+* connection: The connection to get the progress of.
+* returns: The progress percentage, or -1 if progress tracking is not enabled.
+*/
+DUCKDB_API double duckdb_query_progress(duckdb_connection connection);
+
 //===--------------------------------------------------------------------===//
 // Configuration
 //===--------------------------------------------------------------------===//
@@ -911,6 +974,14 @@ Binds a duckdb_interval value to the prepared statement at the specified index.
 DUCKDB_API duckdb_state duckdb_bind_interval(duckdb_prepared_statement prepared_statement, idx_t param_idx,
                                              duckdb_interval val);
 
+/*!
+Binds a duckdb_decimal value to the prepared statement at the specified index.
+
+The value has the width and scale of the decimal, and is cast to the type of the parameter.
+*/
+DUCKDB_API duckdb_state duckdb_bind_decimal(duckdb_prepared_statement prepared_statement, idx_t param_idx,
+                                            duckdb_decimal val);
+
 /*!
 Binds a null-terminated varchar value to the prepared statement at the specified index.
 */
@@ -1018,6 +1089,40 @@ Otherwise, all remaining tasks must be executed first.
 */
 DUCKDB_API duckdb_state duckdb_execute_pending(duckdb_pending_result pending_result, duckdb_result *out_result);
 
+/*!
+Executes the prepared statement with the given bound parameters, and returns a pending result that produces a
+streaming result when executed. A streaming result fetches its chunks lazily instead of materializing every row
+up front.
+
+Note that a streaming result keeps the connection busy: it is invalidated as soon as another query is run on the
+same connection.
+
+After calling `duckdb_pending_prepared_streaming`, the pending result should always be destroyed using
+`duckdb_destroy_pending`, even if this function returns DuckDBError.
+
+* prepared_statement: The prepared statement to execute.
+* out_result: The pending query result.
+* returns: `DuckDBSuccess` on success or `DuckDBError` on failure.
+*/
+DUCKDB_API duckdb_state duckdb_pending_prepared_streaming(duckdb_prepared_statement prepared_statement,
+                                                          duckdb_pending_result *out_result);
+
+/*!
+Fully execute a pending query result, returning the final query result as an arrow stream.
+
+If the pending result was created with `duckdb_pending_prepared_streaming`, the rows are produced lazily by
+`duckdb_arrow_stream_array`. Otherwise the result is materialized before this function returns.
+
+Note that after calling `duckdb_execute_pending_arrow`, `duckdb_destroy_arrow_stream` must be called on the result
+object even if the function returns DuckDBError. The pending result can be destroyed afterwards.
+
+* pending_result: The pending result to execute.
+* out_result: The arrow stream result.
+* returns: `DuckDBSuccess` on success or `DuckDBError` on failure.
+*/
+DUCKDB_API duckdb_state duckdb_execute_pending_arrow(duckdb_pending_result pending_result,
+                                                     duckdb_arrow_stream *out_result);
+
 //===--------------------------------------------------------------------===//
 // Value Interface
 //===--------------------------------------------------------------------===//
@@ -1070,6 +1175,14 @@ Obtains an int64 of the given value.
 */
 DUCKDB_API int64_t duckdb_get_int64(duckdb_value value);
 
+/*!
+Returns the type of the given value.
+
+* value: The value
+* returns: The type of the value. It is owned by the value and should not be destroyed.
+*/
+DUCKDB_API duckdb_logical_type duckdb_get_value_type(duckdb_value value);
+
 //===--------------------------------------------------------------------===//
 // Logical Type Interface
 //===--------------------------------------------------------------------===//
@@ -1456,11 +1569,14 @@ typedef void *duckdb_table_function;
 typedef void *duckdb_bind_info;
 typedef void *duckdb_init_info;
 typedef void *duckdb_function_info;
+typedef void *duckdb_table_filter;
 
 typedef void (*duckdb_table_function_bind_t)(duckdb_bind_info info);
 typedef void (*duckdb_table_function_init_t)(duckdb_init_info info);
 typedef void (*duckdb_table_function_t)(duckdb_function_info info, duckdb_data_chunk output);
 typedef void (*duckdb_delete_callback_t)(void *data);
+typedef double (*duckdb_table_function_progress_t)(void *bind_data, void *init_data);
+typedef idx_t (*duckdb_table_function_batch_index_t)(void *bind_data, void *init_data, void *local_init_data);
 
 /*!
 Creates a new empty table function.
@@ -1550,6 +1666,45 @@ If this is set to false (the default), the system will expect all columns to be
 */
 DUCKDB_API void duckdb_table_function_supports_projection_pushdown(duckdb_table_function table_function, bool pushdown);
 
+/*!
+Sets the progress function of the table function, which reports how much of its scan is done, e.g. in the progress bar.
+
+It is called with the bind data and the init data of the scan, possibly while other threads run the main function,
+and returns the percentage of the scan that is done, between 0 and 100, or a negative number if it is unknown.
+
+* table_function: The table function
+* progress: The progress function
+*/
+DUCKDB_API void duckdb_table_function_set_progress(duckdb_table_function table_function,
+                                                   duckdb_table_function_progress_t progress);
+
+/*!
+Sets the batch index function of the table function, which makes its scan preserve the order of its rows even with
+many threads, e.g. for a `LIMIT`.
+
+The rows of the scan are split in batches, numbered in their order. It is called after every call of the main function
+with the bind data, the init data and the thread-local init data of the thread, and returns the index of the batch the
+rows just produced by the thread belong to. The batches a thread produces must be increasing.
+
+* table_function: The table function
+* batch_index: The batch index function
+*/
+DUCKDB_API void duckdb_table_function_set_batch_index(duckdb_table_function table_function,
+                                                      duckdb_table_function_batch_index_t batch_index);
+
+/*!
+Sets whether or not the given table function supports filter pushdown.
+
+If this is set to true, the system will provide the filters of the query on the columns of the function in the `init`
+stage through the `duckdb_init_get_filter_count` and `duckdb_init_get_filter` functions, and will not apply them
+itself: the function must then only produce the rows that pass them.
+If this is set to false (the default), the system will filter the rows the function produces.
+
+* table_function: The table function
+* pushdown: True if the table function supports filter pushdown, false otherwise.
+*/
+DUCKDB_API void duckdb_table_function_supports_filter_pushdown(duckdb_table_function table_function, bool pushdown);
+
 /*!
 Register the table function object within the given connection.
 
@@ -1688,6 +1843,75 @@ Sets how many threads can process this table function in parallel (default: 1)
 */
 DUCKDB_API void duckdb_init_set_max_threads(duckdb_init_info info, idx_t max_threads);
 
+/*!
+Returns the number of columns with filters pushed down into the scan.
+
+Only table functions that support filter pushdown get filters, see `duckdb_table_function_supports_filter_pushdown`.
+
+* info: The info object
+* returns: The number of columns with filters.
+*/
+DUCKDB_API idx_t duckdb_init_get_filter_count(duckdb_init_info info);
+
+/*!
+Returns the filter of a column pushed down into the scan, the rows the function produces must pass all of them.
+
+The filter is owned by the scan and valid during the `init` stage only.
+
+* info: The info object
+* filter_index: The index of the filter, between 0 and `duckdb_init_get_filter_count`.
+* out_column_index: The index of the filtered column in the projected columns of `duckdb_init_get_column_index`.
+* returns: The filter, or `nullptr` if the index is out of range.
+*/
+DUCKDB_API duckdb_table_filter duckdb_init_get_filter(duckdb_init_info info, idx_t filter_index,
+                                                      idx_t *out_column_index);
+
+/*!
+Returns the type of the filter: a comparison with a constant, `IS NULL`, `IS NOT NULL`, or a conjunction of filters.
+
+* filter: The filter
+* returns: The type of the filter.
+*/
+DUCKDB_API duckdb_table_filter_type duckdb_table_filter_get_type(duckdb_table_filter filter);
+
+/*!
+Returns the comparison of a `DUCKDB_TABLE_FILTER_CONSTANT_COMPARISON` filter, whose column is on the left side.
+
+* filter: The filter
+* returns: The comparison, or `DUCKDB_COMPARE_INVALID` for other filters.
+*/
+DUCKDB_API duckdb_comparison_type duckdb_table_filter_get_comparison(duckdb_table_filter filter);
+
+/*!
+Returns the constant of a `DUCKDB_TABLE_FILTER_CONSTANT_COMPARISON` filter, of the type of the column.
+
+The result must be destroyed with `duckdb_destroy_value`.
+
+* filter: The filter
+* returns: The constant, or `nullptr` for other filters.
+*/
+DUCKDB_API duckdb_value duckdb_table_filter_get_constant(duckdb_table_filter filter);
+
+/*!
+Returns the number of child filters of a `DUCKDB_TABLE_FILTER_CONJUNCTION_OR` or `DUCKDB_TABLE_FILTER_CONJUNCTION_AND`
+filter.
+
+* filter: The filter
+* returns: The number of child filters, or 0 for other filters.
+*/
+DUCKDB_API idx_t duckdb_table_filter_get_child_count(duckdb_table_filter filter);
+
+/*!
+Returns a child filter of a `DUCKDB_TABLE_FILTER_CONJUNCTION_OR` or `DUCKDB_TABLE_FILTER_CONJUNCTION_AND` filter.
+
+The child is owned by its parent filter.
+
+* filter: The filter
+* index: The index of the child, between 0 and `duckdb_table_filter_get_child_count`.
+* returns: The child filter, or `nullptr` if the index is out of range.
+*/
+DUCKDB_API duckdb_table_filter duckdb_table_filter_get_child(duckdb_table_filter filter, idx_t index);
+
 /*!
 Report that an error has occurred while calling init.
 
@@ -1777,6 +2001,246 @@ Adds a parameter to the replacement scan function.
 */
 DUCKDB_API void duckdb_replacement_scan_add_parameter(duckdb_replacement_scan_info info, duckdb_value parameter);
 
+//===--------------------------------------------------------------------===//
+// Arrow Scans
+//===--------------------------------------------------------------------===//
+typedef void *duckdb_arrow_scan;
+typedef void *duckdb_arrow_scan_info;
+
+typedef duckdb_state (*duckdb_arrow_scan_produce_t)(void *data, duckdb_arrow_scan_info info,
+                                                    duckdb_arrow_array_stream out_stream);
+typedef duckdb_state (*duckdb_arrow_scan_schema_t)(void *data, duckdb_arrow_schema out_schema);
+
+/*!
+Creates an Arrow scan: Arrow data of the client scanned by `arrow_scan`, in parallel and without copying the buffers of
+its arrays, see `duckdb_replacement_scan_set_arrow_scan`.
+
+The client provides the data through two callbacks. `get_schema` writes the `ArrowSchema` of the data to `out_schema`.
+`produce` writes an `ArrowArrayStream` of the data to `out_stream`, once per scan: its arrays hold the columns and pass
+the filters given by the info object, see `duckdb_arrow_scan_get_column_count` and `duckdb_arrow_scan_get_filter`.
+The streams are read by many threads, one array at a time.
+
+The queries that bind the scan through `duckdb_replacement_scan_set_arrow_scan` keep it until they are destroyed. The
+result must be destroyed with `duckdb_destroy_arrow_scan`.
+
+* data: The data passed to the callbacks.
+* produce: The callback producing the stream of a scan.
+* get_schema: The callback writing the schema of the data.
+* destroy: The callback that will be called to destroy the data (if any).
+* returns: The Arrow scan.
+*/
+DUCKDB_API duckdb_arrow_scan duckdb_create_arrow_scan(void *data, duckdb_arrow_scan_produce_t produce,
+                                                      duckdb_arrow_scan_schema_t get_schema,
+                                                      duckdb_delete_callback_t destroy);
+
+/*!
+Destroys the Arrow scan, and de-allocates its data once no query references it.
+
+* scan: The Arrow scan to destroy.
+*/
+DUCKDB_API void duckdb_destroy_arrow_scan(duckdb_arrow_scan *scan);
+
+/*!
+Replaces the table of the replacement scan by the Arrow scan. Call it in the replacement callback instead of
+`duckdb_replacement_scan_set_function_name`.
+
+* info: The info object
+* scan: The Arrow scan.
+*/
+DUCKDB_API void duckdb_replacement_scan_set_arrow_scan(duckdb_replacement_scan_info info, duckdb_arrow_scan scan);
+
+/*!
+Returns the number of columns the stream of the scan must produce.
+
+The stream produces all the columns of the schema when there are none.
+
+* info: The info object
+* returns: The number of columns.
+*/
+DUCKDB_API idx_t duckdb_arrow_scan_get_column_count(duckdb_arrow_scan_info info);
+
+/*!
+Returns the name of a column the stream of the scan must produce, in the order of the children of its arrays.
+
+* info: The info object
+* index: The index of the column, between 0 and `duckdb_arrow_scan_get_column_count`.
+* returns: The name of the column, or `nullptr` if the index is out of range.
+*/
+DUCKDB_API const char *duckdb_arrow_scan_get_column_name(duckdb_arrow_scan_info info, idx_t index);
+
+/*!
+Returns the number of columns with filters the rows of the stream of the scan must pass.
+
+* info: The info object
+* returns: The number of columns with filters.
+*/
+DUCKDB_API idx_t duckdb_arrow_scan_get_filter_count(duckdb_arrow_scan_info info);
+
+/*!
+Returns the filter of a column the rows of the stream of the scan must pass, see `duckdb_table_filter_get_type`.
+
+The filter is owned by the scan and valid during the `produce` callback only.
+
+* info: The info object
+* index: The index of the filter, between 0 and `duckdb_arrow_scan_get_filter_count`.
+* out_column_name: The name of the filtered column, valid during the `produce` callback only.
+* returns: The filter, or `nullptr` if the index is out of range.
+*/
+DUCKDB_API duckdb_table_filter duckdb_arrow_scan_get_filter(duckdb_arrow_scan_info info, idx_t index,
+                                                            const char **out_column_name);
+
+/*!
+Sets the number of rows of the data, used for the progress of the scan.
+
+* info: The info object
+* row_count: The number of rows.
+*/
+DUCKDB_API void duckdb_arrow_scan_set_row_count(duckdb_arrow_scan_info info, idx_t row_count);
+
+/*!
+Report that an error has occurred in the `produce` callback, which then returns `DuckDBError`.
+
+* info: The info object
+* error: The error message
+*/
+DUCKDB_API void duckdb_arrow_scan_set_error(duckdb_arrow_scan_info info, const char *error);
+
+//===--------------------------------------------------------------------===//
+// Scalar Functions
+//===--------------------------------------------------------------------===//
+typedef void *duckdb_scalar_function;
+
+typedef void (*duckdb_scalar_function_t)(duckdb_function_info info, duckdb_data_chunk input, duckdb_vector output);
+
+/*!
+Creates a new empty scalar function, which computes a whole chunk of rows at once.
+
+The return value should be destroyed with `duckdb_destroy_scalar_function`.
+
+* returns: The scalar function object.
+*/
+DUCKDB_API duckdb_scalar_function duckdb_create_scalar_function();
+
+/*!
+Destroys the given scalar function object.
+
+* function: The scalar function to destroy
+*/
+DUCKDB_API void duckdb_destroy_scalar_function(duckdb_scalar_function *function);
+
+/*!
+Sets the name of the given scalar function.
+
+* function: The scalar function
+* name: The name of the scalar function
+*/
+DUCKDB_API void duckdb_scalar_function_set_name(duckdb_scalar_function function, const char *name);
+
+/*!
+Adds a parameter to the scalar function.
+
+* function: The scalar function
+* type: The type of the parameter to add.
+*/
+DUCKDB_API void duckdb_scalar_function_add_parameter(duckdb_scalar_function function, duckdb_logical_type type);
+
+/*!
+Sets the return type of the scalar function.
+
+* function: The scalar function
+* type: The return type
+*/
+DUCKDB_API void duckdb_scalar_function_set_return_type(duckdb_scalar_function function, duckdb_logical_type type);
+
+/*!
+Assigns extra information to the scalar function that can be fetched during execution.
+
+* function: The scalar function
+* extra_info: The extra information
+* destroy: The callback that will be called to destroy the extra information (if any)
+*/
+DUCKDB_API void duckdb_scalar_function_set_extra_info(duckdb_scalar_function function, void *extra_info,
+                                                      duckdb_delete_callback_t destroy);
+
+/*!
+Sets the main function of the scalar function, called with chunks of arguments by many threads at once.
+
+It writes the results of the `duckdb_data_chunk_get_size` rows of the input to the output vector. The input vectors
+are flat, except for the constant ones, see `duckdb_vector_is_constant`; both can hold NULL values, see
+`duckdb_vector_get_validity`.
+
+* function: The scalar function
+* execute: The function
+*/
+DUCKDB_API void duckdb_scalar_function_set_function(duckdb_scalar_function function,
+                                                    duckdb_scalar_function_t execute);
+
+/*!
+Declares whether the scalar function has side effects, e.g. because it is random. Functions without side effects, the
+default, are computed once for constant arguments and can be reordered by the optimizer.
+
+* function: The scalar function
+* side_effects: Whether the function has side effects
+*/
+DUCKDB_API void duckdb_scalar_function_set_side_effects(duckdb_scalar_function function,
+                                                        duckdb_function_side_effects side_effects);
+
+/*!
+Register the scalar function object within the given connection.
+
+The function requires at least a name, a return type and a function.
+
+If the function is incomplete or a function with that name already exists, DuckDBError is returned, and the reason
+can be retrieved with `duckdb_scalar_function_error`.
+
+* con: The connection to register it in.
+* function: The function pointer
+* returns: Whether or not the registration was successful.
+*/
+DUCKDB_API duckdb_state duckdb_register_scalar_function(duckdb_connection con, duckdb_scalar_function function);
+
+/*!
+Returns the reason the last registration of the scalar function failed, or `nullptr` if there is none.
+
+The error message should not be freed. It will be de-allocated when `duckdb_destroy_scalar_function` is called.
+
+* function: The scalar function to get the error from.
+* returns: The error message, or `nullptr` if there is none.
+*/
+DUCKDB_API const char *duckdb_scalar_function_error(duckdb_scalar_function function);
+
+/*!
+Retrieves the extra info of the scalar function as set in `duckdb_scalar_function_set_extra_info`
+
+* info: The info object
+* returns: The extra info
+*/
+DUCKDB_API void *duckdb_scalar_function_get_extra_info(duckdb_function_info info);
+
+/*!
+Report that an error has occurred while executing the scalar function, which fails the query.
+
+* info: The info object
+* error: The error message
+*/
+DUCKDB_API void duckdb_scalar_function_set_error(duckdb_function_info info, const char *error);
+
+/*!
+Returns whether the vector is constant: its first row holds the value of all of its rows.
+
+* vector: The vector
+* returns: Whether the vector is constant
+*/
+DUCKDB_API bool duckdb_vector_is_constant(duckdb_vector vector);
+
+/*!
+Makes the vector constant: its first row is the value of all of its rows, e.g. for the output of a scalar function
+whose input vectors are all constant.
+
+* vector: The vector
+*/
+DUCKDB_API void duckdb_vector_set_constant(duckdb_vector vector);
+
 //===--------------------------------------------------------------------===//
 // Appender
 //===--------------------------------------------------------------------===//
@@ -1826,6 +2290,49 @@ are done with the appender.
 */
 DUCKDB_API duckdb_state duckdb_appender_flush(duckdb_appender appender);
 
+/*!
+Creates an appender object that controls when its buffered rows are appended to the table, and keeps statistics of
+its flushes.
+
+By default the rows are appended whenever the appender flushes them, which it does every 100 vectors of rows. With
+`manual_flush`, they are only appended by `duckdb_appender_flush_ext` or when the appender is destroyed, so the caller
+decides how many rows are appended at once. With `background_flush`, the rows are appended by a background thread
+while the next rows are buffered; an error of a background flush is returned by the next flush.
+
+Note that the object must be destroyed with `duckdb_appender_destroy`.
+
+* connection: The connection context to create the appender in.
+* schema: The schema of the table to append to, or `nullptr` for the default schema.
+* table: The table name to append to.
+* manual_flush: Whether the rows are only appended when flushed explicitly.
+* background_flush: Whether the rows are appended by a background thread.
+* out_appender: The resulting appender object.
+* returns: `DuckDBSuccess` on success or `DuckDBError` on failure.
+*/
+DUCKDB_API duckdb_state duckdb_appender_create_ext(duckdb_connection connection, const char *schema, const char *table,
+                                                   bool manual_flush, bool background_flush,
+                                                   duckdb_appender *out_appender);
+
+/*!
+Appends all the rows buffered by the appender to the table. With `wait`, waits until they are, including the rows of
+a background flush; otherwise returns as soon as a background flush of the rows is started. Returns the statistics of
+all the flushes of the appender that are done.
+
+The appender does not size its rows: `bytes` is the size of the rows appended since the previous call, as counted by
+the caller while appending them, and is added to the statistics once the rows are appended.
+
+For appenders not created with `duckdb_appender_create_ext`, this is the same as `duckdb_appender_flush`, and the
+statistics are zero.
+
+* appender: The appender to flush.
+* wait: Whether to wait for a background flush to be done.
+* bytes: The size of the rows appended since the previous call.
+* out_stats: The statistics of the flushes of the appender, can be `nullptr`.
+* returns: `DuckDBSuccess` on success or `DuckDBError` on failure.
+*/
+DUCKDB_API duckdb_state duckdb_appender_flush_ext(duckdb_appender appender, bool wait, idx_t bytes,
+                                                  duckdb_appender_flush_stats *out_stats);
+
 /*!
 Close the appender, flushing all intermediate state in the appender to the table and closing it for further appends.
 
@@ -1926,6 +2433,10 @@ DUCKDB_API duckdb_state duckdb_append_timestamp(duckdb_appender appender, duckdb
 Append a duckdb_interval value to the appender.
 */
 DUCKDB_API duckdb_state duckdb_append_interval(duckdb_appender appender, duckdb_interval value);
+/*!
+Append a duckdb_decimal value to the appender, cast to the type of the column.
+*/
+DUCKDB_API duckdb_state duckdb_append_decimal(duckdb_appender appender, duckdb_decimal value);
 
 /*!
 Append a varchar value to the appender.
@@ -1940,10 +2451,269 @@ Append a blob value to the appender.
 */
 DUCKDB_API duckdb_state duckdb_append_blob(duckdb_appender appender, const void *data, idx_t length);
 /*!
+Append a varchar value to the appender without copying it: the appender references the string until it is copied to
+the rows buffered by the appender, so it must stay valid until the next `duckdb_appender_release_borrowed`,
+`duckdb_appender_flush`, `duckdb_appender_flush_ext` or `duckdb_appender_destroy`.
+
+Only appenders created with `duckdb_appender_create_ext` reference the string, and only in `VARCHAR` columns: it is
+copied and cast otherwise, like with `duckdb_append_varchar_length`.
+*/
+DUCKDB_API duckdb_state duckdb_append_varchar_borrowed(duckdb_appender appender, const char *val, idx_t length);
+/*!
+Append a blob value to the appender without copying it, see `duckdb_append_varchar_borrowed`. It is copied and cast
+unless the column is a `BLOB` column.
+*/
+DUCKDB_API duckdb_state duckdb_append_blob_borrowed(duckdb_appender appender, const void *data, idx_t length);
+/*!
+Copy the values appended with `duckdb_append_varchar_borrowed` and `duckdb_append_blob_borrowed` to the rows buffered
+by the appender, without flushing them to the table: they can be released once this returns. A row left incomplete by
+a failed append is discarded.
+*/
+DUCKDB_API duckdb_state duckdb_appender_release_borrowed(duckdb_appender appender);
+/*!
 Append a NULL value to the appender (of any type).
 */
 DUCKDB_API duckdb_state duckdb_append_null(duckdb_appender appender);
 
+/*!
+Returns the number of columns of the table of the appender.
+
+* appender: The appender to get the column count from.
+* returns: The number of columns, 0 if the appender is invalid.
+*/
+DUCKDB_API idx_t duckdb_appender_column_count(duckdb_appender appender);
+
+/*!
+Returns the type of a column of the table of the appender, the data chunks passed to `duckdb_append_data_chunk` must
+have these types.
+
+The result must be destroyed with `duckdb_destroy_logical_type`.
+
+* appender: The appender to get the column type from.
+* col_idx: The index of the column.
+* returns: The logical type of the column, or NULL if the appender is invalid or the column is out of range.
+*/
+DUCKDB_API duckdb_logical_type duckdb_appender_column_type(duckdb_appender appender, idx_t col_idx);
+
+/*!
+Appends the rows of an Arrow record batch, exported as a struct array through the Arrow C data interface.
+
+The struct must have one child per column of the table. Children of another type than their column are cast to it.
+Where the layouts of Arrow and DuckDB match the values are not converted, but the appender copies them still, so the
+array may be released as soon as this function returns. The array is not released by this function.
+
+* appender: The appender to append to.
+* schema: The schema of the struct array.
+* array: The struct array to append.
+* returns: The return state.
+*/
+DUCKDB_API duckdb_state duckdb_append_arrow_array(duckdb_appender appender, duckdb_arrow_schema schema,
+                                                  duckdb_arrow_array array);
+
+//===--------------------------------------------------------------------===//
+// Parallel Appender
+//===--------------------------------------------------------------------===//
+/*!
+Creates a parallel appender, which collects the rows of any number of local appenders to append them to the table
+at once with `duckdb_parallel_appender_commit`.
+
+Every local appender can be used by its own thread, they don't take any lock of the table: they only hand their rows
+over to the parallel appender when they are flushed. The rows are buffered in memory until they are committed.
+
+Note that the object must be destroyed with `duckdb_parallel_appender_destroy`, even if the creation fails.
+
+* connection: The connection context to create the appender in.
+* schema: The schema of the table to append to, or `nullptr` for the default schema.
+* table: The table name to append to.
+* out_appender: The resulting parallel appender object.
+* returns: `DuckDBSuccess` on success or `DuckDBError` on failure.
+*/
+DUCKDB_API duckdb_state duckdb_parallel_appender_create(duckdb_connection connection, const char *schema,
+                                                        const char *table, duckdb_parallel_appender *out_appender);
+
+/*!
+Creates a local appender of the parallel appender. It is used like any other appender, but its rows are only
+appended to the table by `duckdb_parallel_appender_commit`.
+
+The local appender must be destroyed with `duckdb_appender_destroy` before the parallel appender is committed or
+destroyed, even if the creation fails.
+
+* appender: The parallel appender.
+* out_appender: The resulting local appender.
+* returns: `DuckDBSuccess` on success or `DuckDBError` on failure.
+*/
+DUCKDB_API duckdb_state duckdb_parallel_appender_local(duckdb_parallel_appender appender,
+                                                       duckdb_appender *out_appender);
+
+/*!
+Appends the rows of all the local appenders of the parallel appender to the table, in one append. The local
+appenders must have been destroyed before.
+
+* appender: The parallel appender.
+* returns: `DuckDBSuccess` on success or `DuckDBError` on failure.
+*/
+DUCKDB_API duckdb_state duckdb_parallel_appender_commit(duckdb_parallel_appender appender);
+
+/*!
+Returns the error message associated with the given parallel appender.
+If the appender has no error message, this returns `nullptr` instead.
+
+The error message should not be freed. It will be de-allocated when `duckdb_parallel_appender_destroy` is called.
+
+* appender: The parallel appender to get the error from.
+* returns: The error message, or `nullptr` if there is none.
+*/
+DUCKDB_API const char *duckdb_parallel_appender_error(duckdb_parallel_appender appender);
+
+/*!
+Destroys the parallel appender, discarding the rows that were not committed.
+
+* appender: The parallel appender to destroy.
+*/
+DUCKDB_API void duckdb_parallel_appender_destroy(duckdb_parallel_appender *appender);
+
+//===--------------------------------------------------------------------===//
+// Prepared Batch
+//===--------------------------------------------------------------------===//
+/*!
+Creates a batch of rows of parameter values to execute a prepared statement with, once per row, with
+`duckdb_prepared_batch_execute`.
+
+Every column of the batch binds the parameter with the same index. The values are bound as they are, without
+looking at the types the statement expects for its parameters.
+
+Note that the object must be destroyed with `duckdb_prepared_batch_destroy`, even if the creation fails.
+
+* prepared_statement: The prepared statement to execute.
+* out_batch: The resulting batch.
+* returns: `DuckDBSuccess` on success or `DuckDBError` on failure.
+*/
+DUCKDB_API duckdb_state duckdb_prepared_batch_create(duckdb_prepared_statement prepared_statement,
+                                                     duckdb_prepared_batch *out_batch);
+
+/*!
+Appends the rows of a data chunk to the batch. The chunk must have one column per parameter of the statement, and the
+same column types as the chunks appended before.
+
+* batch: The batch to append to.
+* chunk: The chunk of parameter values.
+* returns: `DuckDBSuccess` on success or `DuckDBError` on failure.
+*/
+DUCKDB_API duckdb_state duckdb_prepared_batch_append_data_chunk(duckdb_prepared_batch batch, duckdb_data_chunk chunk);
+
+/*!
+Appends the rows of an Arrow record batch, exported as a struct array through the Arrow C data interface, to the
+batch. The struct array must have one column per parameter of the statement. Its columns are cast to the column types
+of the chunks appended before, if any.
+
+The schema and the array stay owned by the caller.
+
+* batch: The batch to append to.
+* schema: The schema of the struct array.
+* array: The struct array of parameter values.
+* returns: `DuckDBSuccess` on success or `DuckDBError` on failure.
+*/
+DUCKDB_API duckdb_state duckdb_prepared_batch_append_arrow_array(duckdb_prepared_batch batch,
+                                                                 duckdb_arrow_schema schema,
+                                                                 duckdb_arrow_array array);
+
+/*!
+Executes the prepared statement once per row of the batch, in one transaction.
+
+An `INSERT ... VALUES (...)` statement with a single row of values inserts all the rows of the batch in a single
+vectorized pass, as an `INSERT ... SELECT` from the batch. Other statements are executed row by row.
+
+* batch: The batch to execute.
+* out_rows_changed: The total number of rows changed by the statement, can be `nullptr`.
+* returns: `DuckDBSuccess` on success or `DuckDBError` on failure.
+*/
+DUCKDB_API duckdb_state duckdb_prepared_batch_execute(duckdb_prepared_batch batch, idx_t *out_rows_changed);
+
+/*!
+Returns the error message of the last failed call on the batch, or `nullptr` if there is none.
+
+The error message should not be freed. It will be de-allocated when `duckdb_prepared_batch_destroy` is called.
+
+* batch: The batch to get the error from.
+* returns: The error message, or `nullptr` if there is none.
+*/
+DUCKDB_API const char *duckdb_prepared_batch_error(duckdb_prepared_batch batch);
+
+/*!
+Destroys the batch, de-allocating all memory allocated for it.
+
+* batch: The batch to destroy.
+*/
+DUCKDB_API void duckdb_prepared_batch_destroy(duckdb_prepared_batch *batch);
+
+//===--------------------------------------------------------------------===//
+// Input Streams
+//===--------------------------------------------------------------------===//
+/*!
+Creates an input stream: bytes written by the client while a query reads them as a file, e.g. with
+`read_csv_auto(path)` or `COPY table FROM path`, where the path is the one returned by `duckdb_input_stream_path`.
+
+The stream is read like a pipe, and can only be opened once. At most `window_size` written bytes are buffered
+until the query reads them, `duckdb_input_stream_write` waits for the query in the meantime. The client thus writes
+the stream from another thread than the one running the query.
+
+The first `window_size` bytes read are kept, so that the query can read them again from the start, e.g. to
+auto-detect the format of a CSV file.
+
+* connection: The connection whose database reads the stream.
+* window_size: The maximum number of bytes buffered by the stream.
+* out_stream: The resulting stream, or `nullptr` on failure.
+* returns: `DuckDBSuccess` on success or `DuckDBError` on failure.
+*/
+DUCKDB_API duckdb_state duckdb_input_stream_create(duckdb_connection connection, idx_t window_size,
+                                                   duckdb_input_stream *out_stream);
+
+/*!
+Returns the path under which the stream is read by queries.
+
+The path should not be freed. It will be de-allocated when `duckdb_input_stream_destroy` is called.
+
+* stream: The input stream.
+* returns: The path of the stream.
+*/
+DUCKDB_API const char *duckdb_input_stream_path(duckdb_input_stream stream);
+
+/*!
+Writes bytes to the stream, waiting while the window of the stream is full.
+
+Fails once the stream is no longer read: the query is done with it, or the stream was stopped.
+
+* stream: The input stream.
+* data: The bytes to write, copied by the stream.
+* length: The number of bytes to write.
+* returns: `DuckDBSuccess` on success or `DuckDBError` if the stream is no longer read.
+*/
+DUCKDB_API duckdb_state duckdb_input_stream_write(duckdb_input_stream stream, const void *data, idx_t length);
+
+/*!
+Ends the stream: the query reads the end of the stream once it has read the bytes written before.
+
+* stream: The input stream.
+* error: If not `nullptr`, the query fails with this error instead of reading the end of the stream.
+*/
+DUCKDB_API void duckdb_input_stream_close(duckdb_input_stream stream, const char *error);
+
+/*!
+Stops the stream: the writes no longer wait and fail, and so does a query still reading the stream.
+
+Can be called from any thread, e.g. to release a thread waiting in `duckdb_input_stream_write` once the query is done.
+
+* stream: The input stream.
+*/
+DUCKDB_API void duckdb_input_stream_stop(duckdb_input_stream stream);
+
+/*!
+Destroys the stream, stopping it first.
+
+* stream: The input stream to destroy.
+*/
+DUCKDB_API void duckdb_input_stream_destroy(duckdb_input_stream *stream);
+
 /*!
 Appends a pre-filled data chunk to the specified appender.
 
@@ -2039,6 +2809,111 @@ Closes the result and de-allocates all memory allocated for the arrow result.
 */
 DUCKDB_API void duckdb_destroy_arrow(duckdb_arrow *result);
 
+/*!
+Fetch the internal arrow schema from the arrow stream result.
+
+* result: The result to fetch the schema from.
+* out_schema: The output schema.
+* returns: `DuckDBSuccess` on success or `DuckDBError` on failure.
+*/
+DUCKDB_API duckdb_state duckdb_arrow_stream_schema(duckdb_arrow_stream result, duckdb_arrow_schema *out_schema);
+
+/*!
+Fetch the next chunk of the arrow stream result as an arrow array.
+If the result is exhausted, `out_array` is left untouched and `DuckDBSuccess` is returned.
+
+The result must be destroyed with `duckdb_destroy_arrow_stream`.
+
+* result: The result to fetch the array from.
+* out_array: The output array.
+* returns: `DuckDBSuccess` on success or `DuckDBError` on failure.
+*/
+DUCKDB_API duckdb_state duckdb_arrow_stream_array(duckdb_arrow_stream result, duckdb_arrow_array *out_array);
+
+/*!
+Sets the maximum number of rows of the arrow arrays fetched from the arrow stream result, including through a stream
+exported with `duckdb_arrow_stream_export`. Defaults to one vector (`duckdb_vector_size`).
+
+Larger batches amortize the per-array overhead of the consumer, at the cost of buffering more rows at once.
+
+* result: The result object.
+* batch_size: The maximum number of rows per arrow array, must be at least 1.
+* returns: `DuckDBSuccess` on success or `DuckDBError` on failure.
+*/
+DUCKDB_API duckdb_state duckdb_arrow_stream_set_batch_size(duckdb_arrow_stream result, idx_t batch_size);
+
+/*!
+Converts a materialized arrow stream result to arrow arrays on the threads of the database's task scheduler, instead
+of one chunk at a time on the fetching thread. The arrays are still fetched in the order of the result.
+
+Must be called before the first array is fetched. Fails if the result is a streaming result.
+
+* result: The result object, produced by executing `prepared_statement`.
+* prepared_statement: The prepared statement the result was produced by.
+* returns: `DuckDBSuccess` on success or `DuckDBError` on failure.
+*/
+DUCKDB_API duckdb_state duckdb_arrow_stream_set_parallel(duckdb_arrow_stream result,
+                                                         duckdb_prepared_statement prepared_statement);
+
+/*!
+Returns the number of columns present in the arrow stream result.
+
+* result: The result object.
+* returns: The number of columns present in the result object.
+*/
+DUCKDB_API idx_t duckdb_arrow_stream_column_count(duckdb_arrow_stream result);
+
+/*!
+Returns the number of rows present in the arrow stream result. For a streaming result this is the number of rows
+fetched so far.
+
+* result: The result object.
+* returns: The number of rows present in the result object.
+*/
+DUCKDB_API idx_t duckdb_arrow_stream_row_count(duckdb_arrow_stream result);
+
+/*!
+Returns the number of rows changed by the query stored in the arrow stream result. This is relevant only for
+INSERT/UPDATE/DELETE queries. For other queries the rows_changed will be 0.
+
+* result: The result object.
+* returns: The number of rows changed.
+*/
+DUCKDB_API idx_t duckdb_arrow_stream_rows_changed(duckdb_arrow_stream result);
+
+/*!
+Returns the error message contained within the arrow stream result. The error is set if `duckdb_execute_pending_arrow`
+or `duckdb_arrow_stream_array` returns `DuckDBError`.
+
+The error message should not be freed. It will be de-allocated when `duckdb_destroy_arrow_stream` is called.
+
+* result: The result object to fetch the error from.
+* returns: The error of the result.
+*/
+DUCKDB_API const char *duckdb_arrow_stream_error(duckdb_arrow_stream result);
+
+/*!
+Closes the arrow stream result and de-allocates all memory allocated for it.
+
+* result: The result to destroy.
+*/
+DUCKDB_API void duckdb_destroy_arrow_stream(duckdb_arrow_stream *result);
+
+/*!
+Moves the arrow stream result into an Arrow C stream interface (`struct ArrowArrayStream`), so that it can be
+consumed by any Arrow implementation: the schema is exchanged once, and every call to `get_next` hands out the next
+chunk of the result.
+
+The exported stream takes ownership of the result, which is set to NULL. It is released through the `release`
+callback of the stream, `duckdb_destroy_arrow_stream` must not be called on it anymore.
+If this function returns DuckDBError, the result is left untouched.
+
+* result: The arrow stream result to export.
+* out_stream: The `struct ArrowArrayStream` to initialize.
+* returns: `DuckDBSuccess` on success or `DuckDBError` on failure.
+*/
+DUCKDB_API duckdb_state duckdb_arrow_stream_export(duckdb_arrow_stream *result, duckdb_arrow_array_stream out_stream);
+
 //===--------------------------------------------------------------------===//
 // Threading Information
 //===--------------------------------------------------------------------===//
@@ -123,6 +123,81 @@ mod tests {
         }
     }
 
+    #[test]
+    fn test_pending_arrow_stream() {
+        unsafe {
+            // open db
+            let mut db: duckdb_database = ptr::null_mut();
+            let mut con: duckdb_connection = ptr::null_mut();
+            if duckdb_open(ptr::null_mut(), &mut db) != duckdb_state_DuckDBSuccess {
+                panic!("duckdb_open error")
+            }
+            if duckdb_connect(db, &mut con) != duckdb_state_DuckDBSuccess {
+                panic!("duckdb_connect error")
+            }
+
+            let sql = CString::new("SELECT i::INTEGER FROM range(0, 5000) t(i)").unwrap();
+            let mut stmt: duckdb_prepared_statement = ptr::null_mut();
+            if duckdb_prepare(con, sql.as_ptr() as *const c_char, &mut stmt) != duckdb_state_DuckDBSuccess {
+                panic!("duckdb_prepare error")
+            }
+            let mut pending: duckdb_pending_result = ptr::null_mut();
+            if duckdb_pending_prepared_streaming(stmt, &mut pending) != duckdb_state_DuckDBSuccess {
+                panic!("duckdb_pending_prepared_streaming error")
+            }
+            let mut result: duckdb_arrow_stream = ptr::null_mut();
+            if duckdb_execute_pending_arrow(pending, &mut result) != duckdb_state_DuckDBSuccess {
+                panic!("duckdb_execute_pending_arrow error")
+            }
+            duckdb_destroy_pending(&mut pending);
+            assert_eq!(duckdb_arrow_stream_column_count(result), 1);
+            assert_eq!(duckdb_arrow_stream_rows_changed(result), 0);
+            // nothing has been fetched yet
+            assert_eq!(duckdb_arrow_stream_row_count(result), 0);
+
+            let mut total = 0;
+            loop {
+                let mut array = FFI_ArrowArray::empty();
+                let mut array_ptr = &mut array as *mut FFI_ArrowArray;
+                if duckdb_arrow_stream_array(result, &mut array_ptr as *mut _ as *mut duckdb_arrow_array)
+                    != duckdb_state_DuckDBSuccess
+                {
+                    panic!("duckdb_arrow_stream_array error")
+                }
+                if array.is_empty() {
+                    break;
+                }
+                let mut schema = FFI_ArrowSchema::empty();
+                let mut schema_ptr = &mut schema as *mut FFI_ArrowSchema;
+                if duckdb_arrow_stream_schema(result, &mut schema_ptr as *mut _ as *mut duckdb_arrow_schema)
+                    != duckdb_state_DuckDBSuccess
+                {
+                    panic!("duckdb_arrow_stream_schema error")
+                }
+                let arrow_array = ArrowArray::try_from_raw(&array, &schema).expect("ok");
+                let struct_array = StructArray::from(ArrayData::try_from(arrow_array).expect("ok"));
+                let arr_i = struct_array.column(0).as_any().downcast_ref::<Int32Array>().unwrap();
+                assert_eq!(arr_i.value(0), total);
+                total += struct_array.len() as i32;
+                assert_eq!(duckdb_arrow_stream_row_count(result), total as u64);
+            }
+            assert_eq!(total, 5000);
+            // an exhausted stream keeps returning no data
+            let mut array = FFI_ArrowArray::empty();
+            let mut array_ptr = &mut array as *mut FFI_ArrowArray;
+            assert_eq!(
+                duckdb_arrow_stream_array(result, &mut array_ptr as *mut _ as *mut duckdb_arrow_array),
+                duckdb_state_DuckDBSuccess
+            );
+            assert!(array.is_empty());
+
+            duckdb_destroy_arrow_stream(&mut result);
+            duckdb_destroy_prepare(&mut stmt);
+            duckdb_disconnect(&mut con);
+            duckdb_close(&mut db);
+        }
+    }
+
     #[test]
     fn basic_api_usage() {
         unsafe {
@@ -3,16 +3,98 @@ use super::{AppenderParams, Connection, Result, ValueRef};
 use std::ffi::c_void;
 use std::fmt;
 use std::iter::IntoIterator;
+use std::mem;
 use std::os::raw::c_char;
+use std::time::Duration;
 
-use crate::error::result_from_duckdb_appender;
-use crate::types::{ToSql, ToSqlOutput};
+use crate::appender_columns::{columns_len, ColumnChunk, ColumnSlice};
+use crate::data_chunk::STRING_INLINE_LENGTH;
+use crate::error::result_from_duckdb_append;
+use crate::types::{decimal_to_ffi, hugeint_to_ffi, ToSql, ToSqlOutput};
 use crate::Error;
 
+use arrow::array::{Array, BinaryArray, LargeBinaryArray, LargeStringArray, StringArray, StructArray};
+use arrow::datatypes::DataType;
+use arrow::ffi::{FFI_ArrowArray, FFI_ArrowSchema};
+use arrow::record_batch::RecordBatch;
+
+/// Options of an [`Appender`], see [`Connection::appender_with_options`]
+///
+/// By default, the appender appends its buffered rows to the table every 100
+/// vectors of rows (204800 rows), and the flush blocks the appends until it
+/// is done.
+#[derive(Debug, Clone, Default)]
+pub struct AppenderOptions {
+    pub(crate) flush_rows: Option<usize>,
+    pub(crate) flush_bytes: Option<usize>,
+    pub(crate) background_flush: bool,
+}
+
+impl AppenderOptions {
+    /// Flush once this many rows are buffered, instead of every 100 vectors
+    /// of rows
+    pub fn flush_rows(mut self, rows: usize) -> AppenderOptions {
+        self.flush_rows = Some(rows.max(1));
+        self
+    }
+
+    /// Flush once the buffered rows take about this many bytes, counting the
+    /// fixed-width values and the strings and blobs that are not inlined
+    pub fn flush_bytes(mut self, bytes: usize) -> AppenderOptions {
+        self.flush_bytes = Some(bytes.max(1));
+        self
+    }
+
+    /// Append the flushed rows to the table in a background thread, while the
+    /// next rows are buffered
+    ///
+    /// Only one flush runs at a time: a flush waits for the previous one to be
+    /// done. An error of a background flush is returned by the next append
+    /// that flushes, or by [`Appender::flush`], and the rows of that flush are
+    /// lost.
+    pub fn background_flush(mut self, enabled: bool) -> AppenderOptions {
+        self.background_flush = enabled;
+        self
+    }
+
+    // Whether the buffered rows are only appended when flushed explicitly
+    #[inline]
+    pub(crate) fn manual_flush(&self) -> bool {
+        self.flush_rows.is_some() || self.flush_bytes.is_some()
+    }
+}
+
+/// Statistics of the flushes of an [`Appender`], returned by
+/// [`Appender::flush`]
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub struct FlushStats {
+    /// Number of times rows were appended to the table
+    pub flushes: u64,
+    /// Number of rows appended to the table
+    pub rows: u64,
+    /// Estimated size of the fixed-width values and of the strings and blobs
+    /// that are not inlined appended to the table, counted while appending
+    pub bytes: u64,
+    /// Time spent appending to the table
+    pub duration: Duration,
+}
+
+impl From<ffi::duckdb_appender_flush_stats> for FlushStats {
+    #[inline]
+    fn from(stats: ffi::duckdb_appender_flush_stats) -> FlushStats {
+        FlushStats {
+            flushes: stats.flushes,
+            rows: stats.rows,
+            bytes: stats.bytes,
+            duration: Duration::from_micros(stats.micros),
+        }
+    }
+}
+
 /// Appender for fast import data
 pub struct Appender<'conn> {
     conn: &'conn Connection,
-    app: ffi::duckdb_appender,
+    raw: RawAppender,
 }
 
 impl Appender<'_> {
@@ -62,11 +144,245 @@ impl Appender<'_> {
     /// Will return `Err` if append column count not the same with the table schema
     #[inline]
     pub fn append_row<P: AppenderParams>(&mut self, params: P) -> Result<()> {
+        self.raw.append_row(params)
+    }
+
+    /// Append multiple rows of values, referencing their strings and blobs
+    /// instead of copying them
+    ///
+    /// [`append_row`](Appender::append_row) copies strings and blobs twice:
+    /// into the row chunk of the appender, and from there into its buffered
+    /// rows once the chunk is full. The strings and blobs of `rows` are only
+    /// copied the second time, which halves the copying of large text or blob
+    /// values. As they are borrowed, the chunk is copied to the buffered rows
+    /// before returning, even if it isn't full, without flushing them to the
+    /// table. Other values are appended as by `append_row`.
+    ///
+    /// ## Example
+    ///
+    /// ```rust,no_run
+    /// # use duckdb::{Connection, Result};
+    /// # use duckdb::types::ValueRef;
+    /// fn insert_lines(conn: &Connection, lines: &[String]) -> Result<()> {
+    ///     let mut app = conn.appender("logs")?;
+    ///     app.append_rows_borrowed(lines.iter().map(|line| [ValueRef::from(line.as_str())]))
+    /// }
+    /// ```
+    ///
+    /// # Failure
+    ///
+    /// Will return `Err` if append column count not the same with the table
+    /// schema, or if a value can't be cast to the type of its column
+    #[inline]
+    pub fn append_rows_borrowed<'buf, I, R>(&mut self, rows: I) -> Result<()>
+    where
+        I: IntoIterator<Item = R>,
+        R: AsRef<[ValueRef<'buf>]>,
+    {
+        self.raw.append_rows_borrowed(rows)
+    }
+
+    /// Append whole columns at once, one [`ColumnSlice`] per column of the
+    /// table, all of the same length
+    ///
+    /// The values are copied a vector size at a time into a data chunk, which
+    /// is much faster than [`append_rows`](Appender::append_rows) as it
+    /// avoids converting and appending every value on its own. Strings and
+    /// blobs are not copied into the chunk but referenced, and only copied
+    /// once the chunk is appended. The columns must hold values of the exact
+    /// type of the table columns, no casting is performed.
+    ///
+    /// Rows appended with [`append_row`](Appender::append_row) that were not
+    /// flushed yet may be stored after the rows of the columns.
+    ///
+    /// ## Example
+    ///
+    /// ```rust,no_run
+    /// # use duckdb::{Connection, Result};
+    /// fn insert_columns(conn: &Connection) -> Result<()> {
+    ///     let ids: Vec<i32> = vec![1, 2, 3];
+    ///     let names = vec![Some("one"), None, Some("three")];
+    ///     let mut app = conn.appender("foo")?;
+    ///     app.append_columns(&[&ids, &names])?;
+    ///     Ok(())
+    /// }
+    /// ```
+    ///
+    /// # Failure
+    ///
+    /// Will return `Err` if the number of columns is not the same as in the
+    /// table schema, if the columns have different lengths, or if the values
+    /// of a column don't match the type of the table column
+    pub fn append_columns(&mut self, columns: &[&dyn ColumnSlice]) -> Result<()> {
+        self.raw.append_columns(columns)
+    }
+
+    /// Append the rows of an Arrow record batch, with one column per column of
+    /// the table
+    ///
+    /// The batch is handed to DuckDB through the Arrow C data interface, and
+    /// copied a vector size at a time without converting the values where the
+    /// Arrow and DuckDB layouts match (primitive types, dates, times and
+    /// timestamps, and validity). Columns of another type than the table
+    /// column are cast to it.
+    ///
+    /// ## Example
+    ///
+    /// ```rust,no_run
+    /// # use duckdb::{Connection, Result};
+    /// # use arrow::record_batch::RecordBatch;
+    /// fn insert_batch(conn: &Connection, batch: &RecordBatch) -> Result<()> {
+    ///     let mut app = conn.appender("foo")?;
+    ///     app.append_record_batch(batch)?;
+    ///     Ok(())
+    /// }
+    /// ```
+    ///
+    /// # Failure
+    ///
+    /// Will return `Err` if the number of columns is not the same as in the
+    /// table schema, if a column has an Arrow type that is not supported, or
+    /// if its values can't be cast to the type of the table column
+    pub fn append_record_batch(&mut self, record_batch: &RecordBatch) -> Result<()> {
+        self.raw.append_record_batch(record_batch)
+    }
+
+    #[inline]
+    pub(super) fn new<'a>(conn: &'a Connection, app: ffi::duckdb_appender, options: &AppenderOptions) -> Appender<'a> {
+        Appender {
+            conn,
+            raw: RawAppender::with_options(app, options),
+        }
+    }
+
+    /// Flush data into DB, waiting for a background flush to be done
+    ///
+    /// Returns the statistics of all the flushes of the appender so far.
+    ///
+    /// # Failure
+    ///
+    /// Will return `Err` if the rows can't be appended to the table, or if a
+    /// previous background flush failed
+    #[inline]
+    pub fn flush(&mut self) -> Result<FlushStats> {
+        self.raw.flush()
+    }
+}
+
+// Private newtype for the appender handles shared by `Appender` and the
+// local appenders of a `ParallelAppender`, which close and destroy themselves
+// when dropped.
+pub struct RawAppender {
+    app: ffi::duckdb_appender,
+    // rows and estimated bytes appended since the last flush, checked against
+    // the flush thresholds
+    buffered_rows: usize,
+    buffered_bytes: usize,
+    flush_rows: usize,
+    flush_bytes: usize,
+}
+
+impl RawAppender {
+    #[inline]
+    pub(crate) fn new(app: ffi::duckdb_appender) -> RawAppender {
+        RawAppender::with_options(app, &AppenderOptions::default())
+    }
+
+    #[inline]
+    pub(crate) fn with_options(app: ffi::duckdb_appender, options: &AppenderOptions) -> RawAppender {
+        RawAppender {
+            app,
+            buffered_rows: 0,
+            buffered_bytes: 0,
+            flush_rows: options.flush_rows.unwrap_or(usize::MAX),
+            flush_bytes: options.flush_bytes.unwrap_or(usize::MAX),
+        }
+    }
+
+    #[inline]
+    pub(crate) fn append_row<P: AppenderParams>(&mut self, params: P) -> Result<()> {
         let _ = unsafe { ffi::duckdb_appender_begin_row(self.app) };
         params.__bind_in(self)?;
         // NOTE: we only check end_row return value
         let rc = unsafe { ffi::duckdb_appender_end_row(self.app) };
-        result_from_duckdb_appender(rc, self.app)
+        result_from_duckdb_append(rc, self.app)?;
+        self.buffered(1, 0)
+    }
+
+    pub(crate) fn append_rows_borrowed<'buf, I, R>(&mut self, rows: I) -> Result<()>
+    where
+        I: IntoIterator<Item = R>,
+        R: AsRef<[ValueRef<'buf>]>,
+    {
+        let result = rows.into_iter().try_for_each(|row| {
+            let _ = unsafe { ffi::duckdb_appender_begin_row(self.app) };
+            for &value in row.as_ref() {
+                self.append_value(value, true)?;
+            }
+            let rc = unsafe { ffi::duckdb_appender_end_row(self.app) };
+            result_from_duckdb_append(rc, self.app)?;
+            self.buffered(1, 0)
+        });
+        // the appender must not reference the rows once they are gone, even on
+        // failure
+        let rc = unsafe { ffi::duckdb_appender_release_borrowed(self.app) };
+        result?;
+        result_from_duckdb_append(rc, self.app)
+    }
+
+    // Account for appended rows, flushing once a threshold is reached. The
+    // bytes of a row appended with `append_row` are counted while binding.
+    #[inline]
+    fn buffered(&mut self, rows: usize, bytes: usize) -> Result<()> {
+        self.buffered_rows += rows;
+        self.buffered_bytes += bytes;
+        if self.buffered_rows >= self.flush_rows || self.buffered_bytes >= self.flush_bytes {
+            self.flush_ext(false)?;
+        }
+        Ok(())
+    }
+
+    pub(crate) fn append_columns(&mut self, columns: &[&dyn ColumnSlice]) -> Result<()> {
+        let column_count = unsafe { ffi::duckdb_appender_column_count(self.app) as usize };
+        let len = columns_len(columns, column_count)?;
+        if len == 0 {
+            return Ok(());
+        }
+
+        let vector_size = unsafe { ffi::duckdb_vector_size() as usize };
+        let mut chunk = unsafe { ColumnChunk::new(self.app) };
+        for start in (0..len).step_by(vector_size) {
+            let rows = start..len.min(start + vector_size);
+            if let Err(idx) = unsafe { chunk.fill(columns, rows) } {
+                return Err(Error::DuckDBFailure(
+                    ffi::Error::new(ffi::DuckDBError),
+                    Some(format!("column {} does not match the type of the table column", idx)),
+                ));
+            }
+            let rc = unsafe { ffi::duckdb_append_data_chunk(self.app, chunk.ptr()) };
+            result_from_duckdb_append(rc, self.app)?;
+            let bytes = columns.iter().map(|column| column.__byte_size(rows.clone())).sum();
+            self.buffered(rows.len(), bytes)?;
+        }
+        Ok(())
+    }
+
+    pub(crate) fn append_record_batch(&mut self, record_batch: &RecordBatch) -> Result<()> {
+        let (schema, array) = export_record_batch(record_batch)?;
+        let rc = unsafe {
+            ffi::duckdb_append_arrow_array(
+                self.app,
+                &schema as *const FFI_ArrowSchema as ffi::duckdb_arrow_schema,
+                &array as *const FFI_ArrowArray as ffi::duckdb_arrow_array,
+            )
+        };
+        result_from_duckdb_append(rc, self.app)?;
+        let bytes = record_batch
+            .columns()
+            .iter()
+            .map(|column| array_size(column.as_ref()))
+            .sum();
+        self.buffered(record_batch.num_rows(), bytes)
     }
 
     #[inline]
@@ -81,17 +397,20 @@ impl Appender<'_> {
         Ok(())
     }
 
-    fn bind_parameter<P: ?Sized + ToSql>(&self, param: &P) -> Result<()> {
+    fn bind_parameter<P: ?Sized + ToSql>(&mut self, param: &P) -> Result<()> {
         let value = param.to_sql()?;
-
-        let ptr = self.app;
         let value = match value {
             ToSqlOutput::Borrowed(v) => v,
             ToSqlOutput::Owned(ref v) => ValueRef::from(v),
         };
-        // NOTE: we ignore the return value here
-        //       because if anything failed, end_row will fail
-        // TODO: append more
+        self.append_value(value, false)
+    }
+
+    // Append the next value of the current row, as it is: DuckDB casts it if
+    // the column has another type. With `borrow`, strings and blobs are
+    // referenced until the appender releases them instead of being copied.
+    fn append_value(&mut self, value: ValueRef<'_>, borrow: bool) -> Result<()> {
+        let ptr = self.app;
         let rc = match value {
             ValueRef::Null => unsafe { ffi::duckdb_append_null(ptr) },
             ValueRef::Boolean(i) => unsafe { ffi::duckdb_append_bool(ptr, i) },
@@ -99,42 +418,123 @@ impl Appender<'_> {
             ValueRef::SmallInt(i) => unsafe { ffi::duckdb_append_int16(ptr, i) },
             ValueRef::Int(i) => unsafe { ffi::duckdb_append_int32(ptr, i) },
             ValueRef::BigInt(i) => unsafe { ffi::duckdb_append_int64(ptr, i) },
-
-            // FIXME
-            ValueRef::HugeInt(i) => unsafe { ffi::duckdb_append_int64(ptr, i as i64) },
-
+            ValueRef::HugeInt(i) => unsafe { ffi::duckdb_append_hugeint(ptr, hugeint_to_ffi(i)) },
+            ValueRef::UTinyInt(i) => unsafe { ffi::duckdb_append_uint8(ptr, i) },
+            ValueRef::USmallInt(i) => unsafe { ffi::duckdb_append_uint16(ptr, i) },
+            ValueRef::UInt(i) => unsafe { ffi::duckdb_append_uint32(ptr, i) },
+            ValueRef::UBigInt(i) => unsafe { ffi::duckdb_append_uint64(ptr, i) },
             ValueRef::Float(r) => unsafe { ffi::duckdb_append_float(ptr, r) },
             ValueRef::Double(r) => unsafe { ffi::duckdb_append_double(ptr, r) },
+            ValueRef::Decimal(d) => unsafe { ffi::duckdb_append_decimal(ptr, decimal_to_ffi(d)) },
+            ValueRef::Timestamp(unit, t) => unsafe {
+                let ts = ffi::duckdb_timestamp {
+                    micros: unit.to_micros(t)?,
+                };
+                ffi::duckdb_append_timestamp(ptr, ts)
+            },
+            ValueRef::Date32(days) => unsafe { ffi::duckdb_append_date(ptr, ffi::duckdb_date { days }) },
+            ValueRef::Time64(unit, t) => unsafe {
+                let time = ffi::duckdb_time {
+                    micros: unit.to_micros(t)?,
+                };
+                ffi::duckdb_append_time(ptr, time)
+            },
+            ValueRef::Text(s) if borrow => unsafe {
+                ffi::duckdb_append_varchar_borrowed(ptr, s.as_ptr() as *const c_char, s.len() as u64)
+            },
             ValueRef::Text(s) => unsafe {
                 ffi::duckdb_append_varchar_length(ptr, s.as_ptr() as *const c_char, s.len() as u64)
             },
+            ValueRef::Blob(b) if borrow => unsafe {
+                ffi::duckdb_append_blob_borrowed(ptr, b.as_ptr() as *const c_void, b.len() as u64)
+            },
             ValueRef::Blob(b) => unsafe { ffi::duckdb_append_blob(ptr, b.as_ptr() as *const c_void, b.len() as u64) },
-            _ => unreachable!("not supported"),
         };
         if rc != 0 {
             return Err(Error::AppendError);
         }
+        self.buffered_bytes += value_size(&value);
         Ok(())
     }
 
     #[inline]
-    pub(super) fn new(conn: &Connection, app: ffi::duckdb_appender) -> Appender<'_> {
-        Appender { conn, app }
+    pub(crate) fn flush(&mut self) -> Result<FlushStats> {
+        self.flush_ext(true)
     }
 
-    /// Flush data into DB
-    #[inline]
-    pub fn flush(&mut self) {
-        unsafe {
-            ffi::duckdb_appender_flush(self.app);
+    // Without `wait`, returns once a background flush of the rows is started.
+    // The appender counts the flushed bytes from the estimate of the buffered
+    // rows, it doesn't size them again.
+    fn flush_ext(&mut self, wait: bool) -> Result<FlushStats> {
+        let mut stats: ffi::duckdb_appender_flush_stats = unsafe { mem::zeroed() };
+        let rc = unsafe { ffi::duckdb_appender_flush_ext(self.app, wait, self.buffered_bytes as u64, &mut stats) };
+        // the rows are gone from the appender, appended or not
+        self.buffered_rows = 0;
+        self.buffered_bytes = 0;
+        result_from_duckdb_append(rc, self.app)?;
+        Ok(FlushStats::from(stats))
+    }
+}
+
+/// Export `record_batch` as a struct array through the Arrow C data
+/// interface, the caller keeping ownership of both.
+pub(crate) fn export_record_batch(record_batch: &RecordBatch) -> Result<(FFI_ArrowSchema, FFI_ArrowArray)> {
+    let schema = FFI_ArrowSchema::try_from(record_batch.schema().as_ref())
+        .map_err(|e| Error::DuckDBFailure(ffi::Error::new(ffi::DuckDBError), Some(e.to_string())))?;
+    // cheap: the struct array shares the buffers of the batch
+    let struct_array = StructArray::from(record_batch.clone());
+    let array = FFI_ArrowArray::new(struct_array.data());
+    Ok((schema, array))
+}
+
+// Estimated size of a value in a vector: strings and blobs that are not
+// inlined take their length on top of the fixed-width part.
+#[inline]
+fn value_size(value: &ValueRef) -> usize {
+    match *value {
+        ValueRef::Null => 0,
+        ValueRef::Boolean(_) | ValueRef::TinyInt(_) | ValueRef::UTinyInt(_) => 1,
+        ValueRef::SmallInt(_) | ValueRef::USmallInt(_) => 2,
+        ValueRef::Int(_) | ValueRef::UInt(_) | ValueRef::Float(_) | ValueRef::Date32(_) => 4,
+        ValueRef::HugeInt(_) => 16,
+        ValueRef::Text(b) | ValueRef::Blob(b) if b.len() > STRING_INLINE_LENGTH => 16 + b.len(),
+        ValueRef::Text(_) | ValueRef::Blob(_) => 16,
+        _ => 8,
+    }
+}
+
+// Estimated size of the rows of an Arrow column in vectors, like
+// `value_size`: only the rows of a sliced column count, not the buffers it
+// shares with the rest of the array, and strings and blobs take the bytes
+// between their first and last offsets on top of the fixed-width part.
+fn array_size(column: &dyn Array) -> usize {
+    fn span<T: Copy + Into<i64>>(offsets: &[T]) -> usize {
+        match (offsets.first(), offsets.last()) {
+            (Some(&first), Some(&last)) => (last.into() - first.into()) as usize,
+            _ => 0,
         }
     }
+
+    let rows = column.len();
+    let any = column.as_any();
+    match column.data_type() {
+        DataType::Null => 0,
+        DataType::Boolean | DataType::Int8 | DataType::UInt8 => rows,
+        DataType::Int16 | DataType::UInt16 => 2 * rows,
+        DataType::Int32 | DataType::UInt32 | DataType::Float32 | DataType::Date32 => 4 * rows,
+        DataType::Decimal128(..) => 16 * rows,
+        DataType::Utf8 => 16 * rows + span(any.downcast_ref::<StringArray>().unwrap().value_offsets()),
+        DataType::LargeUtf8 => 16 * rows + span(any.downcast_ref::<LargeStringArray>().unwrap().value_offsets()),
+        DataType::Binary => 16 * rows + span(any.downcast_ref::<BinaryArray>().unwrap().value_offsets()),
+        DataType::LargeBinary => 16 * rows + span(any.downcast_ref::<LargeBinaryArray>().unwrap().value_offsets()),
+        _ => 8 * rows,
+    }
 }
 
-impl Drop for Appender<'_> {
+impl Drop for RawAppender {
     fn drop(&mut self) {
         if !self.app.is_null() {
-            self.flush();
+            let _ = self.flush();
             unsafe {
                 ffi::duckdb_appender_close(self.app);
                 ffi::duckdb_appender_destroy(&mut self.app);
@@ -151,7 +551,7 @@ impl fmt::Debug for Appender<'_> {
 
 #[cfg(test)]
 mod test {
-    use crate::{Connection, Result};
+    use crate::{params, AppenderOptions, Connection, Result};
     use std::convert::TryFrom;
 
     #[test]
@@ -184,6 +584,276 @@ mod test {
         Ok(())
     }
 
+    #[test]
+    fn test_append_columns() -> Result<()> {
+        let db = Connection::open_in_memory()?;
+        db.execute_batch("CREATE TABLE foo(i INTEGER, d DOUBLE, b BOOLEAN, s VARCHAR, x BLOB)")?;
+
+        let len = 3000;
+        let ints: Vec<i32> = (0..len).collect();
+        let doubles: Vec<Option<f64>> = (0..len)
+            .map(|i| if i % 7 == 0 { None } else { Some(i as f64) })
+            .collect();
+        let bools: Vec<bool> = (0..len).map(|i| i % 2 == 0).collect();
+        // both inlined (<= 12 bytes) and out of line strings
+        let strings: Vec<Option<String>> = (0..len)
+            .map(|i| {
+                if i % 3 == 0 {
+                    None
+                } else {
+                    Some("x".repeat((i % 20) as usize))
+                }
+            })
+            .collect();
+        let blobs: Vec<&[u8]> = (0..len)
+            .map(|i| if i % 2 == 0 { &b"ab"[..] } else { &b""[..] })
+            .collect();
+        {
+            let mut app = db.appender("foo")?;
+            app.append_columns(&[&ints, &doubles, &bools, &strings, &blobs])?;
+        }
+
+        let (count, sum_i, sum_d, nulls_d, trues): (i64, i64, f64, i64, i64) = db.query_row(
+            "SELECT count(*), sum(i)::BIGINT, sum(d), count(*) - count(d), count(*) FILTER (WHERE b) FROM foo",
+            [],
+            |row| Ok((row.get(0)?, row.get(1)?, row.get(2)?, row.get(3)?, row.get(4)?)),
+        )?;
+        assert_eq!(count, len as i64);
+        assert_eq!(sum_i, (0..len as i64).sum::<i64>());
+        assert_eq!(sum_d, (0..len).filter(|i| i % 7 != 0).map(|i| i as f64).sum::<f64>());
+        assert_eq!(nulls_d, (0..len).filter(|i| i % 7 == 0).count() as i64);
+        assert_eq!(trues, len as i64 / 2);
+
+        let mut stmt = db.prepare("SELECT s, x FROM foo ORDER BY i")?;
+        let mut rows = stmt.query([])?;
+        let mut i = 0;
+        while let Some(row) = rows.next()? {
+            assert_eq!(row.get::<_, Option<String>>(0)?, strings[i]);
+            assert_eq!(row.get::<_, Vec<u8>>(1)?, blobs[i]);
+            i += 1;
+        }
+        assert_eq!(i, len as usize);
+        Ok(())
+    }
+
+    #[test]
+    fn test_append_columns_mismatch() -> Result<()> {
+        let db = Connection::open_in_memory()?;
+        db.execute_batch("CREATE TABLE foo(x INTEGER, y VARCHAR)")?;
+
+        let mut app = db.appender("foo")?;
+        let ints: Vec<i32> = vec![1, 2];
+        let bigints: Vec<i64> = vec![1, 2];
+        let strs = vec!["a", "b"];
+        assert!(app.append_columns(&[&ints]).is_err());
+        assert!(app.append_columns(&[&ints, &vec!["a"]]).is_err());
+        assert!(app.append_columns(&[&bigints, &strs]).is_err());
+        assert!(app.append_columns(&[&strs, &ints]).is_err());
+
+        // the appender is still usable after a failed append
+        app.append_columns(&[&&ints[..], &strs])?;
+        app.append_row(params![3, "c"])?;
+        app.flush()?;
+        let count: i64 = db.query_row("SELECT count(*) FROM foo", [], |r| r.get(0))?;
+        assert_eq!(count, 3);
+        Ok(())
+    }
+
+    #[test]
+    fn test_flush_rows() -> Result<()> {
+        let db = Connection::open_in_memory()?;
+        db.execute_batch("CREATE TABLE foo(x INTEGER)")?;
+
+        let mut app = db.appender_with_options("foo", AppenderOptions::default().flush_rows(1000))?;
+        app.append_rows((0..2500).map(|i| [i]))?;
+        // only whole thousands of rows were flushed
+        let count: i64 = db.query_row("SELECT count(*) FROM foo", [], |r| r.get(0))?;
+        assert_eq!(count, 2000);
+
+        let ints: Vec<i32> = (0..400).collect();
+        app.append_columns(&[&ints])?;
+        let count: i64 = db.query_row("SELECT count(*) FROM foo", [], |r| r.get(0))?;
+        assert_eq!(count, 2000);
+
+        let stats = app.flush()?;
+        assert_eq!(stats.flushes, 3);
+        assert_eq!(stats.rows, 2900);
+        assert_eq!(stats.bytes, 2900 * 4);
+        let count: i64 = db.query_row("SELECT count(*) FROM foo", [], |r| r.get(0))?;
+        assert_eq!(count, 2900);
+        Ok(())
+    }
+
+    #[test]
+    fn test_flush_bytes_background() -> Result<()> {
+        let db = Connection::open_in_memory()?;
+        db.execute_batch("CREATE TABLE foo(x BIGINT, s VARCHAR)")?;
+
+        let options = AppenderOptions::default().flush_bytes(1 << 20).background_flush(true);
+        let mut app = db.appender_with_options("foo", options)?;
+        let long = "a string that is not inlined";
+        for i in 0..100_000i64 {
+            app.append_row(params![i, long])?;
+        }
+        let stats = app.flush()?;
+        // every row takes 8 + 16 + 28 bytes
+        assert_eq!(stats.rows, 100_000);
+        assert_eq!(stats.bytes, 100_000 * 52);
+        assert!(stats.flushes >= 5, "{:?}", stats);
+
+        let (count, sum): (i64, i64) = db.query_row("SELECT count(*), sum(x)::BIGINT FROM foo", [], |r| {
+            Ok((r.get(0)?, r.get(1)?))
+        })?;
+        assert_eq!(count, 100_000);
+        assert_eq!(sum, (0..100_000).sum::<i64>());
+        Ok(())
+    }
+
+    #[test]
+    fn test_background_flush_error() -> Result<()> {
+        let db = Connection::open_in_memory()?;
+        db.execute_batch("CREATE TABLE foo(x INTEGER PRIMARY KEY)")?;
+
+        let options = AppenderOptions::default().flush_rows(10).background_flush(true);
+        let mut app = db.appender_with_options("foo", options)?;
+        app.append_rows((0..10).map(|_| [1]))?;
+        // the duplicate keys are only reported once the background flush is done
+        assert!(app.flush().is_err());
+        app.append_row([2])?;
+        let stats = app.flush()?;
+        assert_eq!(stats.rows, 1);
+        Ok(())
+    }
+
+    #[test]
+    fn test_append_record_batch() -> Result<()> {
+        use arrow::array::{BooleanArray, Int32Array, StringArray};
+        use arrow::datatypes::{DataType, Field, Schema};
+        use arrow::record_batch::RecordBatch;
+        use std::sync::Arc;
+
+        let db = Connection::open_in_memory()?;
+        db.execute_batch("CREATE TABLE foo(i INTEGER, b BOOLEAN, s VARCHAR, l BIGINT)")?;
+
+        let len = 3000;
+        let ints: Vec<Option<i32>> = (0..len).map(|i| if i % 5 == 0 { None } else { Some(i) }).collect();
+        let strings: Vec<Option<String>> = (0..len)
+            .map(|i| {
+                if i % 3 == 0 {
+                    None
+                } else {
+                    Some("x".repeat((i % 20) as usize))
+                }
+            })
+            .collect();
+        let schema = Schema::new(vec![
+            Field::new("i", DataType::Int32, true),
+            Field::new("b", DataType::Boolean, false),
+            Field::new("s", DataType::Utf8, true),
+            // cast to the BIGINT column
+            Field::new("l", DataType::Int32, false),
+        ]);
+        let batch = RecordBatch::try_new(
+            Arc::new(schema),
+            vec![
+                Arc::new(Int32Array::from(ints.clone())),
+                Arc::new(BooleanArray::from((0..len).map(|i| i % 2 == 0).collect::<Vec<_>>())),
+                Arc::new(StringArray::from(
+                    strings.iter().map(|s| s.as_deref()).collect::<Vec<_>>(),
+                )),
+                Arc::new(Int32Array::from((0..len).collect::<Vec<_>>())),
+            ],
+        )
+        .unwrap();
+        {
+            let mut app = db.appender("foo")?;
+            app.append_record_batch(&batch)?;
+            // sliced batches start at an offset into the arrays
+            app.append_record_batch(&batch.slice(1001, 10))?;
+        }
+
+        let count: i64 = db.query_row("SELECT count(*) FROM foo", [], |r| r.get(0))?;
+        assert_eq!(count, len as i64 + 10);
+        let mut stmt = db.prepare("SELECT i, b, s, l FROM foo ORDER BY rowid")?;
+        let mut rows = stmt.query([])?;
+        let mut n = 0;
+        while let Some(row) = rows.next()? {
+            let idx = if n < len as usize { n } else { n - len as usize + 1001 };
+            assert_eq!(row.get::<_, Option<i32>>(0)?, ints[idx]);
+            assert_eq!(row.get::<_, bool>(1)?, idx % 2 == 0);
+            assert_eq!(row.get::<_, Option<String>>(2)?, strings[idx]);
+            assert_eq!(row.get::<_, i64>(3)?, idx as i64);
+            n += 1;
+        }
+        assert_eq!(n, len as usize + 10);
+        Ok(())
+    }
+
+    #[test]
+    fn test_append_record_batch_bytes() -> Result<()> {
+        use arrow::array::{Int32Array, StringArray};
+        use arrow::datatypes::{DataType, Field, Schema};
+        use arrow::record_batch::RecordBatch;
+        use std::sync::Arc;
+
+        let db = Connection::open_in_memory()?;
+        db.execute_batch("CREATE TABLE foo(i INTEGER, s VARCHAR)")?;
+
+        let strings: Vec<String> = (0..1000).map(|i| "x".repeat(i % 50)).collect();
+        let schema = Schema::new(vec![
+            Field::new("i", DataType::Int32, false),
+            Field::new("s", DataType::Utf8, false),
+        ]);
+        let batch = RecordBatch::try_new(
+            Arc::new(schema),
+            vec![
+                Arc::new(Int32Array::from((0..1000).collect::<Vec<_>>())),
+                Arc::new(StringArray::from(
+                    strings.iter().map(|s| s.as_str()).collect::<Vec<_>>(),
+                )),
+            ],
+        )
+        .unwrap();
+
+        let mut app = db.appender_with_options("foo", AppenderOptions::default())?;
+        // only the rows of the slice count, not the buffers it shares with the
+        // whole batch
+        app.append_record_batch(&batch.slice(120, 10))?;
+        let stats = app.flush()?;
+        assert_eq!(stats.rows, 10);
+        let string_bytes: usize = strings[120..130].iter().map(|s| s.len()).sum();
+        assert_eq!(stats.bytes, (10 * (4 + 16) + string_bytes) as u64);
+        Ok(())
+    }
+
+    #[test]
+    fn test_append_record_batch_mismatch() -> Result<()> {
+        use arrow::array::{Int32Array, StringArray};
+        use arrow::datatypes::{DataType, Field, Schema};
+        use arrow::record_batch::RecordBatch;
+        use std::sync::Arc;
+
+        let db = Connection::open_in_memory()?;
+        db.execute_batch("CREATE TABLE foo(x INTEGER)")?;
+        let mut app = db.appender("foo")?;
+
+        let schema = Schema::new(vec![
+            Field::new("x", DataType::Int32, false),
+            Field::new("y", DataType::Int32, false),
+        ]);
+        let batch = RecordBatch::try_new(
+            Arc::new(schema),
+            vec![Arc::new(Int32Array::from(vec![1])), Arc::new(Int32Array::from(vec![2]))],
+        )
+        .unwrap();
+        assert!(app.append_record_batch(&batch).is_err());
+
+        let schema = Schema::new(vec![Field::new("x", DataType::Utf8, false)]);
+        let batch = RecordBatch::try_new(Arc::new(schema), vec![Arc::new(StringArray::from(vec!["a"]))]).unwrap();
+        assert!(app.append_record_batch(&batch).is_err());
+        Ok(())
+    }
+
     // Waiting https://github.com/duckdb/duckdb/pull/3405
     #[cfg(feature = "uuid")]
     #[test]
@@ -205,6 +875,118 @@ mod test {
         Ok(())
     }
 
+    #[test]
+    fn test_append_rows_borrowed() -> Result<()> {
+        use crate::types::ValueRef;
+
+        let db = Connection::open_in_memory()?;
+        db.execute_batch("CREATE TABLE foo(id INTEGER, line VARCHAR, payload BLOB, n INTEGER)")?;
+
+        let len = 3000;
+        let lines: Vec<String> = (0..len)
+            .map(|i| format!("a log line long enough not to be inlined {}", i))
+            .collect();
+        let payloads: Vec<Vec<u8>> = (0..len).map(|i| vec![i as u8; (i % 40) as usize]).collect();
+        {
+            let mut app = db.appender("foo")?;
+            app.append_rows_borrowed((0..len as usize).map(|i| {
+                [
+                    ValueRef::Int(i as i32),
+                    ValueRef::from(lines[i].as_str()),
+                    ValueRef::Blob(&payloads[i]),
+                    // cast to the column type, not borrowed
+                    ValueRef::Text(b"42"),
+                ]
+            }))?;
+            // a failed row is discarded
+            assert!(app
+                .append_rows_borrowed([[
+                    ValueRef::Int(-1),
+                    ValueRef::Text(b"x"),
+                    ValueRef::Null,
+                    ValueRef::Text(b"x")
+                ]])
+                .is_err());
+            app.append_rows_borrowed([[ValueRef::Int(-2), ValueRef::Null, ValueRef::Null, ValueRef::Null]])?;
+        }
+
+        let (count, sum, n): (i64, i64, i64) =
+            db.query_row("SELECT count(*), sum(id)::BIGINT, sum(n)::BIGINT FROM foo", [], |r| {
+                Ok((r.get(0)?, r.get(1)?, r.get(2)?))
+            })?;
+        assert_eq!(count, len + 1);
+        assert_eq!(sum, (0..len).sum::<i64>() - 2);
+        assert_eq!(n, 42 * len);
+
+        let mut stmt = db.prepare("SELECT line, payload FROM foo WHERE id >= 0 ORDER BY id")?;
+        let mut rows = stmt.query([])?;
+        let mut i = 0;
+        while let Some(row) = rows.next()? {
+            assert_eq!(row.get::<_, String>(0)?, lines[i]);
+            assert_eq!(row.get::<_, Vec<u8>>(1)?, payloads[i]);
+            i += 1;
+        }
+        assert_eq!(i, len as usize);
+        Ok(())
+    }
+
+    #[test]
+    fn test_append_native_types() -> Result<()> {
+        use crate::types::{TimeUnit, Value};
+        use rust_decimal::Decimal;
+
+        let db = Connection::open_in_memory()?;
+        db.execute_batch(
+            "CREATE TABLE foo(h HUGEINT, ub UBIGINT, us USMALLINT, d DECIMAL(18, 3), ts TIMESTAMP, dt DATE, t TIME)",
+        )?;
+        {
+            let mut app = db.appender("foo")?;
+            app.append_row(params![
+                i128::MAX,
+                u64::MAX,
+                u16::MAX,
+                Decimal::new(-123456, 2),
+                Value::Timestamp(TimeUnit::Millisecond, 1_649_519_797_544),
+                Value::Date32(19091),
+                Value::Time64(TimeUnit::Microsecond, 57_397_544_000),
+            ])?;
+            // cast to the column types
+            app.append_row(params![
+                1i128,
+                2u8,
+                3u8,
+                7u32,
+                Value::Date32(19091),
+                "2022-04-09",
+                Value::Null
+            ])?;
+        }
+
+        let val = db.query_row(
+            "SELECT h::VARCHAR, ub::VARCHAR, us::VARCHAR, d::VARCHAR, ts::VARCHAR, dt::VARCHAR, t::VARCHAR FROM foo \
+             ORDER BY h DESC LIMIT 1",
+            [],
+            |row| <(String, String, String, String, String, String, String)>::try_from(row),
+        )?;
+        assert_eq!(
+            val,
+            (
+                i128::MAX.to_string(),
+                u64::MAX.to_string(),
+                u16::MAX.to_string(),
+                "-1234.560".to_string(),
+                "2022-04-09 15:56:37.544".to_string(),
+                "2022-04-09".to_string(),
+                "15:56:37.544".to_string(),
+            )
+        );
+        let val = db.query_row("SELECT d::VARCHAR, ts::VARCHAR FROM foo WHERE h = 1", [], |row| {
+            <(String, String)>::try_from(row)
+        })?;
+        assert_eq!(val, ("7.000".to_string(), "2022-04-09 00:00:00".to_string()));
+        Ok(())
+    }
+
     #[test]
     fn test_append_string_as_ts_row() -> Result<()> {
         let db = Connection::open_in_memory()?;
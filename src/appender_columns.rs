@@ -0,0 +1,428 @@
+use std::mem;
+use std::ops::Range;
+use std::ptr;
+
+use super::ffi;
+use super::{Error, Result};
+use crate::data_chunk::{DuckDBString, VectorValue, STRING_INLINE_LENGTH};
+
+mod sealed {
+    use super::ffi;
+
+    /// This trait exists just to ensure that the only impls of `trait
+    /// ColumnSlice` that are allowed are ones in this crate.
+    pub trait Sealed {}
+
+    /// The values a [`ColumnSlice`](super::ColumnSlice) is made of.
+    pub trait ColumnValue: Sized {
+        /// Copy `values` to the start of `vector`, returning `false` if they
+        /// can't be stored in a vector of type `type_id`.
+        unsafe fn write(values: &[Self], vector: ffi::duckdb_vector, type_id: ffi::duckdb_type) -> bool;
+
+        /// Estimated size of `values` in a vector.
+        fn byte_size(values: &[Self]) -> usize;
+
+        /// The DuckDB type the values are bound as when they are parameters.
+        fn type_id() -> ffi::duckdb_type;
+    }
+}
+
+use sealed::ColumnValue;
+
+/// A column of values that
+/// [`Appender::append_columns`](crate::Appender::append_columns) copies into
+/// a table in bulk.
+///
+/// Implemented for `Vec`s and slices of:
+/// - the primitive types matching the column type, see
+///   [`VectorValue`](crate::VectorValue), and `bool`
+/// - `&str` and `String` for VARCHAR columns
+/// - `&[u8]` and `Vec<u8>` for BLOB columns
+/// - `Option`s of all of them, `None` appending NULL
+pub trait ColumnSlice: sealed::Sealed {
+    /// Number of values of the column.
+    fn len(&self) -> usize;
+
+    /// Whether the column has no values.
+    #[inline]
+    fn is_empty(&self) -> bool {
+        self.len() == 0
+    }
+
+    /// Copy the values in `rows` to the start of `vector`, returning `false`
+    /// if they can't be stored in a vector of type `type_id`.
+    #[doc(hidden)]
+    unsafe fn __write(&self, vector: ffi::duckdb_vector, type_id: ffi::duckdb_type, rows: Range<usize>) -> bool;
+
+    /// Estimated size of the values in `rows` once appended.
+    #[doc(hidden)]
+    fn __byte_size(&self, rows: Range<usize>) -> usize;
+
+    /// The DuckDB type the values are bound as when they are parameters.
+    #[doc(hidden)]
+    fn __type_id(&self) -> ffi::duckdb_type;
+}
+
+impl<T: ColumnValue> sealed::Sealed for Vec<T> {}
+impl<T: ColumnValue> ColumnSlice for Vec<T> {
+    #[inline]
+    fn len(&self) -> usize {
+        Vec::len(self)
+    }
+
+    #[inline]
+    unsafe fn __write(&self, vector: ffi::duckdb_vector, type_id: ffi::duckdb_type, rows: Range<usize>) -> bool {
+        T::write(&self[rows], vector, type_id)
+    }
+
+    #[inline]
+    fn __byte_size(&self, rows: Range<usize>) -> usize {
+        T::byte_size(&self[rows])
+    }
+
+    #[inline]
+    fn __type_id(&self) -> ffi::duckdb_type {
+        T::type_id()
+    }
+}
+
+impl<T: ColumnValue> sealed::Sealed for &[T] {}
+impl<T: ColumnValue> ColumnSlice for &[T] {
+    #[inline]
+    fn len(&self) -> usize {
+        <[T]>::len(self)
+    }
+
+    #[inline]
+    unsafe fn __write(&self, vector: ffi::duckdb_vector, type_id: ffi::duckdb_type, rows: Range<usize>) -> bool {
+        T::write(&self[rows], vector, type_id)
+    }
+
+    #[inline]
+    fn __byte_size(&self, rows: Range<usize>) -> usize {
+        T::byte_size(&self[rows])
+    }
+
+    #[inline]
+    fn __type_id(&self) -> ffi::duckdb_type {
+        T::type_id()
+    }
+}
+
+// Mark the rows of `vector` for which `is_null` holds as NULL.
+#[inline]
+unsafe fn write_validity<T>(values: &[T], vector: ffi::duckdb_vector, is_null: impl Fn(&T) -> bool) {
+    if !values.iter().any(&is_null) {
+        return;
+    }
+    // the validity mask starts out with every row valid
+    ffi::duckdb_vector_ensure_validity_writable(vector);
+    let validity = ffi::duckdb_vector_get_validity(vector);
+    for (row, value) in values.iter().enumerate() {
+        if is_null(value) {
+            *validity.add(row / 64) &= !(1 << (row % 64));
+        }
+    }
+}
+
+macro_rules! column_value_primitive {
+    ($($t:ty: $type_id:ident),+) => {$(
+        impl ColumnValue for $t {
+            #[inline]
+            unsafe fn write(values: &[Self], vector: ffi::duckdb_vector, type_id: ffi::duckdb_type) -> bool {
+                if !<$t>::is_compatible(type_id) {
+                    return false;
+                }
+                let data = ffi::duckdb_vector_get_data(vector) as *mut $t;
+                ptr::copy_nonoverlapping(values.as_ptr(), data, values.len());
+                true
+            }
+
+            #[inline]
+            fn byte_size(values: &[Self]) -> usize {
+                values.len() * mem::size_of::<$t>()
+            }
+
+            #[inline]
+            fn type_id() -> ffi::duckdb_type {
+                ffi::$type_id
+            }
+        }
+
+        impl ColumnValue for Option<$t> {
+            #[inline]
+            unsafe fn write(values: &[Self], vector: ffi::duckdb_vector, type_id: ffi::duckdb_type) -> bool {
+                if !<$t>::is_compatible(type_id) {
+                    return false;
+                }
+                let data = ffi::duckdb_vector_get_data(vector) as *mut $t;
+                for (row, value) in values.iter().enumerate() {
+                    // NULL rows are left as they are, DuckDB never reads them
+                    if let Some(value) = *value {
+                        *data.add(row) = value;
+                    }
+                }
+                write_validity(values, vector, Option::is_none);
+                true
+            }
+
+            #[inline]
+            fn byte_size(values: &[Self]) -> usize {
+                values.len() * mem::size_of::<$t>()
+            }
+
+            #[inline]
+            fn type_id() -> ffi::duckdb_type {
+                ffi::$type_id
+            }
+        }
+    )+};
+}
+
+column_value_primitive!(
+    i8: DUCKDB_TYPE_DUCKDB_TYPE_TINYINT,
+    i16: DUCKDB_TYPE_DUCKDB_TYPE_SMALLINT,
+    i32: DUCKDB_TYPE_DUCKDB_TYPE_INTEGER,
+    i64: DUCKDB_TYPE_DUCKDB_TYPE_BIGINT,
+    u8: DUCKDB_TYPE_DUCKDB_TYPE_UTINYINT,
+    u16: DUCKDB_TYPE_DUCKDB_TYPE_USMALLINT,
+    u32: DUCKDB_TYPE_DUCKDB_TYPE_UINTEGER,
+    u64: DUCKDB_TYPE_DUCKDB_TYPE_UBIGINT,
+    f32: DUCKDB_TYPE_DUCKDB_TYPE_FLOAT,
+    f64: DUCKDB_TYPE_DUCKDB_TYPE_DOUBLE
+);
+
+// BOOLEAN is stored as one byte holding 0 or 1, like a Rust `bool`, but it is
+// not a `VectorValue`: reading NULL rows as `bool` could see other bytes.
+impl ColumnValue for bool {
+    #[inline]
+    unsafe fn write(values: &[Self], vector: ffi::duckdb_vector, type_id: ffi::duckdb_type) -> bool {
+        if type_id != ffi::DUCKDB_TYPE_DUCKDB_TYPE_BOOLEAN {
+            return false;
+        }
+        let data = ffi::duckdb_vector_get_data(vector) as *mut bool;
+        ptr::copy_nonoverlapping(values.as_ptr(), data, values.len());
+        true
+    }
+
+    #[inline]
+    fn byte_size(values: &[Self]) -> usize {
+        values.len()
+    }
+
+    #[inline]
+    fn type_id() -> ffi::duckdb_type {
+        ffi::DUCKDB_TYPE_DUCKDB_TYPE_BOOLEAN
+    }
+}
+
+impl ColumnValue for Option<bool> {
+    #[inline]
+    unsafe fn write(values: &[Self], vector: ffi::duckdb_vector, type_id: ffi::duckdb_type) -> bool {
+        if type_id != ffi::DUCKDB_TYPE_DUCKDB_TYPE_BOOLEAN {
+            return false;
+        }
+        let data = ffi::duckdb_vector_get_data(vector) as *mut bool;
+        for (row, value) in values.iter().enumerate() {
+            *data.add(row) = value.unwrap_or(false);
+        }
+        write_validity(values, vector, Option::is_none);
+        true
+    }
+
+    #[inline]
+    fn byte_size(values: &[Self]) -> usize {
+        values.len()
+    }
+
+    #[inline]
+    fn type_id() -> ffi::duckdb_type {
+        ffi::DUCKDB_TYPE_DUCKDB_TYPE_BOOLEAN
+    }
+}
+
+// Short strings are inlined in the vector, the longer ones reference the
+// values rather than being copied to the string heap of the vector: they are
+// only copied once the chunk is appended.
+#[inline]
+unsafe fn write_bytes<'a>(vector: ffi::duckdb_vector, values: impl Iterator<Item = Option<&'a [u8]>>) {
+    let data = ffi::duckdb_vector_get_data(vector) as *mut DuckDBString;
+    for (row, value) in values.enumerate() {
+        if let Some(bytes) = value {
+            *data.add(row) = DuckDBString::borrowed(bytes);
+        }
+    }
+}
+
+// Strings and blobs take a `duckdb_string_t`, and their length if they are
+// not inlined.
+#[inline]
+fn bytes_size(len: usize) -> usize {
+    let inline = mem::size_of::<DuckDBString>();
+    if len > STRING_INLINE_LENGTH {
+        inline + len
+    } else {
+        inline
+    }
+}
+
+// The first type is the one the values are bound as.
+macro_rules! column_value_bytes {
+    ($t:ty, $as_bytes:path, $bind_type_id:ident $(| $type_id:ident)*) => {
+        impl ColumnValue for $t {
+            #[inline]
+            unsafe fn write(values: &[Self], vector: ffi::duckdb_vector, type_id: ffi::duckdb_type) -> bool {
+                if !(type_id == ffi::$bind_type_id $(|| type_id == ffi::$type_id)*) {
+                    return false;
+                }
+                write_bytes(vector, values.iter().map(|value| Some($as_bytes(value))));
+                true
+            }
+
+            #[inline]
+            fn byte_size(values: &[Self]) -> usize {
+                values.iter().map(|value| bytes_size($as_bytes(value).len())).sum()
+            }
+
+            #[inline]
+            fn type_id() -> ffi::duckdb_type {
+                ffi::$bind_type_id
+            }
+        }
+
+        impl ColumnValue for Option<$t> {
+            #[inline]
+            unsafe fn write(values: &[Self], vector: ffi::duckdb_vector, type_id: ffi::duckdb_type) -> bool {
+                if !(type_id == ffi::$bind_type_id $(|| type_id == ffi::$type_id)*) {
+                    return false;
+                }
+                write_bytes(vector, values.iter().map(|value| value.as_ref().map($as_bytes)));
+                write_validity(values, vector, Option::is_none);
+                true
+            }
+
+            #[inline]
+            fn byte_size(values: &[Self]) -> usize {
+                values
+                    .iter()
+                    .map(|value| bytes_size(value.as_ref().map_or(0, |value| $as_bytes(value).len())))
+                    .sum()
+            }
+
+            #[inline]
+            fn type_id() -> ffi::duckdb_type {
+                ffi::$bind_type_id
+            }
+        }
+    };
+}
+
+#[inline]
+fn str_bytes<'a>(s: &'a &str) -> &'a [u8] {
+    s.as_bytes()
+}
+
+#[inline]
+fn slice_bytes<'a>(b: &'a &[u8]) -> &'a [u8] {
+    b
+}
+
+column_value_bytes!(
+    &str,
+    str_bytes,
+    DUCKDB_TYPE_DUCKDB_TYPE_VARCHAR | DUCKDB_TYPE_DUCKDB_TYPE_JSON
+);
+column_value_bytes!(
+    String,
+    String::as_bytes,
+    DUCKDB_TYPE_DUCKDB_TYPE_VARCHAR | DUCKDB_TYPE_DUCKDB_TYPE_JSON
+);
+column_value_bytes!(&[u8], slice_bytes, DUCKDB_TYPE_DUCKDB_TYPE_BLOB);
+column_value_bytes!(Vec<u8>, Vec::as_slice, DUCKDB_TYPE_DUCKDB_TYPE_BLOB);
+
+/// The number of rows of `columns`, checking that there is one column per
+/// table column or parameter and that they have the same length.
+pub(crate) fn columns_len(columns: &[&dyn ColumnSlice], expected: usize) -> Result<usize> {
+    if columns.len() != expected {
+        return Err(Error::InvalidParameterCount(columns.len(), expected));
+    }
+    let len = columns.first().map_or(0, |column| column.len());
+    if columns.iter().any(|column| column.len() != len) {
+        return Err(Error::DuckDBFailure(
+            ffi::Error::new(ffi::DuckDBError),
+            Some("columns have different lengths".to_owned()),
+        ));
+    }
+    Ok(len)
+}
+
+/// A data chunk with the column types of a table, refilled with the rows of
+/// [`ColumnSlice`]s for every append.
+pub(crate) struct ColumnChunk {
+    ptr: ffi::duckdb_data_chunk,
+    type_ids: Vec<ffi::duckdb_type>,
+}
+
+impl ColumnChunk {
+    /// A chunk matching the columns of `appender`.
+    pub(crate) unsafe fn new(appender: ffi::duckdb_appender) -> ColumnChunk {
+        let column_count = ffi::duckdb_appender_column_count(appender);
+        let types = (0..column_count)
+            .map(|idx| ffi::duckdb_appender_column_type(appender, idx))
+            .collect();
+        ColumnChunk::from_types(types)
+    }
+
+    /// A chunk with the types the values of `columns` are bound as.
+    pub(crate) unsafe fn for_columns(columns: &[&dyn ColumnSlice]) -> ColumnChunk {
+        let types = columns
+            .iter()
+            .map(|column| ffi::duckdb_create_logical_type(column.__type_id()))
+            .collect();
+        ColumnChunk::from_types(types)
+    }
+
+    // Takes ownership of `types`.
+    unsafe fn from_types(mut types: Vec<ffi::duckdb_logical_type>) -> ColumnChunk {
+        let type_ids = types
+            .iter()
+            .map(|&logical_type| ffi::duckdb_get_type_id(logical_type))
+            .collect();
+        let ptr = ffi::duckdb_create_data_chunk(types.as_mut_ptr(), types.len() as u64);
+        for logical_type in &mut types {
+            ffi::duckdb_destroy_logical_type(logical_type);
+        }
+        ColumnChunk { ptr, type_ids }
+    }
+
+    #[inline]
+    pub(crate) fn ptr(&self) -> ffi::duckdb_data_chunk {
+        self.ptr
+    }
+
+    /// Replace the content of the chunk with `rows` of `columns`, returning
+    /// the index of the first column whose values don't match the type of the
+    /// table column on failure.
+    ///
+    /// `columns` must match the columns of the chunk, and `rows` must be in
+    /// range of all of them and at most one vector size long. Strings and
+    /// blobs reference `columns`, so the chunk must be appended (which copies
+    /// them) before `columns` are dropped.
+    pub(crate) unsafe fn fill(&mut self, columns: &[&dyn ColumnSlice], rows: Range<usize>) -> Result<(), usize> {
+        ffi::duckdb_data_chunk_reset(self.ptr);
+        for (idx, (column, &type_id)) in columns.iter().zip(&self.type_ids).enumerate() {
+            let vector = ffi::duckdb_data_chunk_get_vector(self.ptr, idx as u64);
+            if !column.__write(vector, type_id, rows.clone()) {
+                return Err(idx);
+            }
+        }
+        ffi::duckdb_data_chunk_set_size(self.ptr, rows.len() as u64);
+        Ok(())
+    }
+}
+
+impl Drop for ColumnChunk {
+    fn drop(&mut self) {
+        unsafe { ffi::duckdb_destroy_data_chunk(&mut self.ptr) };
+    }
+}
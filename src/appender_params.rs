@@ -1,4 +1,5 @@
-use crate::{Appender, Result, ToSql};
+use crate::appender::RawAppender;
+use crate::{Result, ToSql};
 
 mod sealed {
     /// This trait exists just to ensure that the only impls of `trait Params`
@@ -124,7 +125,7 @@ pub trait AppenderParams: Sealed {
     //
     // For now, just hide the function in the docs...
     #[doc(hidden)]
-    fn __bind_in(self, stmt: &mut Appender<'_>) -> Result<()>;
+    fn __bind_in(self, stmt: &mut RawAppender) -> Result<()>;
 }
 
 // Explicitly impl for empty array. Critically, for `conn.execute([])` to be
@@ -133,7 +134,7 @@ pub trait AppenderParams: Sealed {
 impl Sealed for [&dyn ToSql; 0] {}
 impl AppenderParams for [&dyn ToSql; 0] {
     #[inline]
-    fn __bind_in(self, stmt: &mut Appender<'_>) -> Result<()> {
+    fn __bind_in(self, stmt: &mut RawAppender) -> Result<()> {
         // Note: Can't just return `Ok(())` — `Statement::bind_parameters`
         // checks that the right number of params were passed too.
         // TODO: we should have tests for `Error::InvalidParameterCount`...
@@ -144,7 +145,7 @@ impl AppenderParams for [&dyn ToSql; 0] {
 impl Sealed for &[&dyn ToSql] {}
 impl AppenderParams for &[&dyn ToSql] {
     #[inline]
-    fn __bind_in(self, stmt: &mut Appender<'_>) -> Result<()> {
+    fn __bind_in(self, stmt: &mut RawAppender) -> Result<()> {
         stmt.bind_parameters(self)
     }
 }
@@ -155,14 +156,14 @@ macro_rules! impl_for_array_ref {
         // avoid the compile time hit from making them all inline for now.
         impl<T: ToSql + ?Sized> Sealed for &[&T; $N] {}
         impl<T: ToSql + ?Sized> AppenderParams for &[&T; $N] {
-            fn __bind_in(self, stmt: &mut Appender<'_>) -> Result<()> {
+            fn __bind_in(self, stmt: &mut RawAppender) -> Result<()> {
                 stmt.bind_parameters(self)
             }
         }
         impl<T: ToSql> Sealed for [T; $N] {}
         impl<T: ToSql> AppenderParams for [T; $N] {
             #[inline]
-            fn __bind_in(self, stmt: &mut Appender<'_>) -> Result<()> {
+            fn __bind_in(self, stmt: &mut RawAppender) -> Result<()> {
                 stmt.bind_parameters(&self)
             }
         }
@@ -299,7 +300,7 @@ where
     I::Item: ToSql,
 {
     #[inline]
-    fn __bind_in(self, stmt: &mut Appender<'_>) -> Result<()> {
+    fn __bind_in(self, stmt: &mut RawAppender) -> Result<()> {
         stmt.bind_parameters(self.0)
     }
 }
@@ -1,16 +1,29 @@
-use super::Statement;
+use super::{Error, Result, Statement};
 use arrow::{datatypes::SchemaRef, record_batch::RecordBatch};
 
 /// An handle for the resulting RecordBatch of a query.
+///
+/// The batches of a streaming result are fetched, and the query run, as the
+/// iterator advances, so the query can still fail after its first batches,
+/// e.g. once its timeout has passed. The iterator then ends early and keeps
+/// the error for [`take_error`](Arrow::take_error); use
+/// [`try_next`](Arrow::try_next) to get it right away instead.
 #[must_use = "Arrow is lazy and will do nothing unless consumed"]
 pub struct Arrow<'stmt> {
     pub(crate) stmt: Option<&'stmt Statement<'stmt>>,
+    // whether the query failed, its result is then over
+    failed: bool,
+    error: Option<Error>,
 }
 
 impl<'stmt> Arrow<'stmt> {
     #[inline]
     pub(crate) fn new(stmt: &'stmt Statement<'stmt>) -> Arrow<'stmt> {
-        Arrow { stmt: Some(stmt) }
+        Arrow {
+            stmt: Some(stmt),
+            failed: false,
+            error: None,
+        }
     }
 
     /// return arrow schema
@@ -18,12 +31,46 @@ impl<'stmt> Arrow<'stmt> {
     pub fn get_schema(&self) -> SchemaRef {
         self.stmt.unwrap().stmt.schema()
     }
+
+    /// Fetch the next batch, `None` once the result is exhausted
+    ///
+    /// # Failure
+    ///
+    /// Will return `Err` if the query fails while the batch is fetched
+    pub fn try_next(&mut self) -> Result<Option<RecordBatch>> {
+        let stmt = match self.stmt {
+            Some(stmt) if !self.failed => stmt,
+            _ => return Ok(None),
+        };
+        match stmt.step() {
+            Ok(array) => Ok(array.map(|array| RecordBatch::from(&array))),
+            Err(err) => {
+                self.failed = true;
+                Err(err)
+            }
+        }
+    }
+
+    /// The error that ended the iteration early, if any
+    ///
+    /// Check it once the iterator returns `None` to tell a failed query apart
+    /// from a complete result.
+    #[inline]
+    pub fn take_error(&mut self) -> Option<Error> {
+        self.error.take()
+    }
 }
 
 impl<'stmt> Iterator for Arrow<'stmt> {
     type Item = RecordBatch;
 
     fn next(&mut self) -> Option<Self::Item> {
-        Some(RecordBatch::from(&self.stmt?.step()?))
+        match self.try_next() {
+            Ok(batch) => batch,
+            Err(err) => {
+                self.error = Some(err);
+                None
+            }
+        }
     }
 }
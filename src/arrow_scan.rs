@@ -0,0 +1,544 @@
+use std::collections::HashMap;
+use std::ffi::{CStr, CString};
+use std::os::raw::{c_char, c_void};
+use std::panic::{self, AssertUnwindSafe};
+use std::ptr;
+use std::sync::atomic::{AtomicBool, Ordering};
+use std::sync::{Arc, Mutex, Weak};
+
+use super::ffi;
+use super::{Connection, Result};
+use crate::error::Error;
+use crate::types::Value;
+use crate::vtab::{Comparison, TableFilter};
+
+use arrow::array::{
+    Array, ArrayRef, BooleanArray, Decimal128Array, Float32Array, Float64Array, Int16Array, Int32Array, Int64Array,
+    Int8Array, StringArray, UInt16Array, UInt32Array, UInt64Array, UInt8Array,
+};
+use arrow::compute::kernels::boolean::{and_kleene, is_not_null, is_null, or_kleene};
+use arrow::compute::kernels::cast::cast;
+use arrow::compute::kernels::comparison::{eq_dyn, gt_dyn, gt_eq_dyn, lt_dyn, lt_eq_dyn, neq_dyn};
+use arrow::compute::kernels::filter::filter_record_batch;
+use arrow::compute::kernels::take::take;
+use arrow::datatypes::{DataType, SchemaRef};
+use arrow::error::{ArrowError, Result as ArrowResult};
+use arrow::ffi::FFI_ArrowSchema;
+use arrow::ffi_stream::{export_reader_into_raw, FFI_ArrowArrayStream};
+use arrow::record_batch::{RecordBatch, RecordBatchReader};
+
+impl Connection {
+    /// Register Arrow record batches as the table `name`, until the
+    /// connection is closed
+    ///
+    /// The table is scanned by `arrow_scan`: in parallel across the batches,
+    /// and without copying the buffers of their fixed-width columns. Only the
+    /// columns a query needs are scanned, and the batches are filtered before
+    /// DuckDB reads them. Registering another table under the same name
+    /// replaces it.
+    ///
+    /// The table is looked up by a replacement scan of the database, only
+    /// when it has no table or view of the same name. The tables are shared
+    /// by the connections of the database: the other connections see it too,
+    /// while this connection is open, and registering a table under the same
+    /// name on any of them replaces it.
+    ///
+    /// ## Example
+    ///
+    /// ```rust,no_run
+    /// # use duckdb::{Connection, Result};
+    /// # use arrow::record_batch::RecordBatch;
+    /// fn count_rows(conn: &Connection, batches: Vec<RecordBatch>) -> Result<i64> {
+    ///     conn.register_arrow("batches", batches)?;
+    ///     conn.query_row("SELECT count(*) FROM batches", [], |r| r.get(0))
+    /// }
+    /// ```
+    ///
+    /// # Failure
+    ///
+    /// Will return `Err` if there are no batches, whose schema the table
+    /// takes, or if they don't all have the same schema
+    pub fn register_arrow<I>(&self, name: &str, batches: I) -> Result<()>
+    where
+        I: IntoIterator<Item = RecordBatch>,
+    {
+        let batches: Vec<RecordBatch> = batches.into_iter().collect();
+        let schema = match batches.first() {
+            Some(batch) => batch.schema(),
+            None => {
+                return Err(arrow_error(format!(
+                    "no record batch to take the schema of {} from",
+                    name
+                )))
+            }
+        };
+        self.register_arrow_data(name, schema, batches)
+    }
+
+    /// Register the record batches read from `reader` as the table `name`,
+    /// until the connection is closed, see
+    /// [`register_arrow`](Connection::register_arrow)
+    ///
+    /// The batches are all read, and kept in memory, by now.
+    ///
+    /// # Failure
+    ///
+    /// Will return `Err` if the reader fails
+    pub fn register_arrow_reader<R: RecordBatchReader>(&self, name: &str, reader: R) -> Result<()> {
+        let schema = reader.schema();
+        let batches = reader
+            .collect::<ArrowResult<Vec<_>>>()
+            .map_err(|e| arrow_error(e.to_string()))?;
+        self.register_arrow_data(name, schema, batches)
+    }
+
+    /// Unregister the Arrow table `name`, returning whether it was
+    /// registered
+    ///
+    /// Its batches are freed once the queries scanning them are done.
+    pub fn unregister_arrow(&self, name: &str) -> bool {
+        self.db.borrow().arrow_tables.remove(name)
+    }
+
+    fn register_arrow_data(&self, name: &str, schema: SchemaRef, batches: Vec<RecordBatch>) -> Result<()> {
+        if let Some(batch) = batches.iter().find(|batch| batch.schema() != schema) {
+            return Err(arrow_error(format!(
+                "record batch schema {} differs from {}",
+                batch.schema(),
+                schema
+            )));
+        }
+        let rows = batches.iter().map(|batch| batch.num_rows()).sum();
+        let data = Arc::new(ArrowData { schema, batches, rows });
+
+        let db = self.db.borrow();
+        let tables = &db.arrow_tables;
+        if !tables.scanned.swap(true, Ordering::AcqRel) {
+            // the replacement scan may outlive the connections, it shares the
+            // tables until the database is closed
+            let extra_data = Arc::into_raw(tables.clone()) as *mut c_void;
+            unsafe {
+                ffi::duckdb_add_replacement_scan(db.db, Some(replacement_scan), extra_data, Some(drop_arrow_tables))
+            };
+        }
+        tables.insert(name, data, db.con as usize);
+        Ok(())
+    }
+}
+
+/// The Arrow tables registered on the connections of a database, looked up by
+/// its replacement scan
+///
+/// A replaced or unregistered table drops its scan right away: the queries
+/// that bound the scan hold their own reference to it, and fail once its
+/// batches are gone.
+#[derive(Default)]
+pub(crate) struct ArrowTables {
+    tables: Mutex<HashMap<String, ArrowTable>>,
+    // whether the replacement scan is added to the database, on the first
+    // registration
+    scanned: AtomicBool,
+}
+
+impl ArrowTables {
+    fn insert(&self, name: &str, data: Arc<ArrowData>, owner: usize) {
+        let scan = ArrowScan::new(Arc::downgrade(&data));
+        let table = ArrowTable { data, scan, owner };
+        self.tables.lock().unwrap().insert(name.to_lowercase(), table);
+    }
+
+    fn remove(&self, name: &str) -> bool {
+        self.tables.lock().unwrap().remove(&name.to_lowercase()).is_some()
+    }
+
+    /// Unregister the tables of a connection, when it is closed
+    pub(crate) fn remove_owned_by(&self, owner: usize) {
+        self.tables.lock().unwrap().retain(|_, table| table.owner != owner);
+    }
+}
+
+struct ArrowTable {
+    data: Arc<ArrowData>,
+    scan: ArrowScan,
+    // the connection that registered the table
+    owner: usize,
+}
+
+struct ArrowData {
+    schema: SchemaRef,
+    batches: Vec<RecordBatch>,
+    rows: usize,
+}
+
+struct ArrowScan(ffi::duckdb_arrow_scan);
+
+// The scan is only read by DuckDB, which synchronizes its streams
+unsafe impl Send for ArrowScan {}
+unsafe impl Sync for ArrowScan {}
+
+impl ArrowScan {
+    fn new(data: Weak<ArrowData>) -> ArrowScan {
+        let data = Box::into_raw(Box::new(data)) as *mut c_void;
+        ArrowScan(unsafe {
+            ffi::duckdb_create_arrow_scan(data, Some(produce), Some(get_schema), Some(drop_arrow_data))
+        })
+    }
+}
+
+impl Drop for ArrowScan {
+    fn drop(&mut self) {
+        unsafe { ffi::duckdb_destroy_arrow_scan(&mut self.0) };
+    }
+}
+
+unsafe extern "C" fn replacement_scan(
+    info: ffi::duckdb_replacement_scan_info,
+    table_name: *const c_char,
+    data: *mut c_void,
+) {
+    let tables = &*(data as *const ArrowTables);
+    let name = CStr::from_ptr(table_name).to_string_lossy().to_lowercase();
+    if let Some(table) = tables.tables.lock().unwrap().get(&name) {
+        ffi::duckdb_replacement_scan_set_arrow_scan(info, table.scan.0);
+    }
+}
+
+unsafe extern "C" fn drop_arrow_tables(data: *mut c_void) {
+    drop(Arc::from_raw(data as *const ArrowTables));
+}
+
+unsafe extern "C" fn drop_arrow_data(data: *mut c_void) {
+    drop(Box::from_raw(data as *mut Weak<ArrowData>));
+}
+
+unsafe extern "C" fn get_schema(data: *mut c_void, out_schema: ffi::duckdb_arrow_schema) -> ffi::duckdb_state {
+    let data = match (*(data as *const Weak<ArrowData>)).upgrade() {
+        Some(data) => data,
+        None => return ffi::DuckDBError,
+    };
+    match FFI_ArrowSchema::try_from(data.schema.as_ref()) {
+        Ok(schema) => {
+            ptr::write(out_schema as *mut FFI_ArrowSchema, schema);
+            ffi::DuckDBSuccess
+        }
+        Err(_) => ffi::DuckDBError,
+    }
+}
+
+unsafe extern "C" fn produce(
+    data: *mut c_void,
+    info: ffi::duckdb_arrow_scan_info,
+    out_stream: ffi::duckdb_arrow_array_stream,
+) -> ffi::duckdb_state {
+    let data = (*(data as *const Weak<ArrowData>)).upgrade();
+    let reader = panic::catch_unwind(AssertUnwindSafe(|| match data {
+        Some(data) => ArrowScanReader::new(data, info),
+        None => Err(ArrowError::InvalidArgumentError(
+            "the arrow table was unregistered".to_owned(),
+        )),
+    }));
+    match reader {
+        Ok(Ok(reader)) => {
+            ffi::duckdb_arrow_scan_set_row_count(info, reader.data.rows as u64);
+            export_reader_into_raw(Box::new(reader), out_stream as *mut FFI_ArrowArrayStream);
+            ffi::DuckDBSuccess
+        }
+        Ok(Err(err)) => {
+            let c_err = CString::new(err.to_string().replace('\0', "")).unwrap();
+            ffi::duckdb_arrow_scan_set_error(info, c_err.as_ptr());
+            ffi::DuckDBError
+        }
+        Err(_) => ffi::DuckDBError,
+    }
+}
+
+/// The stream of one scan of an Arrow table: its batches with only the
+/// columns of the scan, and only the rows passing its filters
+struct ArrowScanReader {
+    data: Arc<ArrowData>,
+    schema: SchemaRef,
+    projection: Vec<usize>,
+    // by index in the projected columns
+    filters: Vec<(usize, TableFilter)>,
+    next: usize,
+}
+
+impl ArrowScanReader {
+    unsafe fn new(data: Arc<ArrowData>, info: ffi::duckdb_arrow_scan_info) -> ArrowResult<ArrowScanReader> {
+        let projection = (0..ffi::duckdb_arrow_scan_get_column_count(info))
+            .map(|idx| {
+                let name = CStr::from_ptr(ffi::duckdb_arrow_scan_get_column_name(info, idx));
+                data.schema.index_of(&name.to_string_lossy())
+            })
+            .collect::<ArrowResult<Vec<_>>>()?;
+        // e.g. count(*) needs no column, but the batches keep their length
+        let projection = if projection.is_empty() {
+            (0..data.schema.fields().len()).collect()
+        } else {
+            projection
+        };
+        let schema = Arc::new(data.schema.project(&projection)?);
+        let filters = (0..ffi::duckdb_arrow_scan_get_filter_count(info))
+            .map(|idx| {
+                let mut name = ptr::null();
+                let filter = ffi::duckdb_arrow_scan_get_filter(info, idx, &mut name);
+                let column = schema.index_of(&CStr::from_ptr(name).to_string_lossy())?;
+                Ok((column, TableFilter::from_raw(filter)))
+            })
+            .collect::<ArrowResult<Vec<_>>>()?;
+        Ok(ArrowScanReader {
+            data,
+            schema,
+            projection,
+            filters,
+            next: 0,
+        })
+    }
+
+    fn scan(&self, batch: &RecordBatch) -> ArrowResult<RecordBatch> {
+        let batch = batch.project(&self.projection)?;
+        let mut mask: Option<BooleanArray> = None;
+        for (column, filter) in &self.filters {
+            let column_mask = filter_mask(filter, batch.column(*column))?;
+            mask = Some(match mask {
+                Some(mask) => and_kleene(&mask, &column_mask)?,
+                None => column_mask,
+            });
+        }
+        match mask {
+            Some(mask) => filter_record_batch(&batch, &mask),
+            None => Ok(batch),
+        }
+    }
+}
+
+impl Iterator for ArrowScanReader {
+    type Item = ArrowResult<RecordBatch>;
+
+    fn next(&mut self) -> Option<Self::Item> {
+        while let Some(batch) = self.data.batches.get(self.next) {
+            self.next += 1;
+            match self.scan(batch) {
+                // skip the batches the filters leave empty
+                Ok(batch) if batch.num_rows() == 0 => continue,
+                result => return Some(result),
+            }
+        }
+        None
+    }
+}
+
+impl RecordBatchReader for ArrowScanReader {
+    fn schema(&self) -> SchemaRef {
+        self.schema.clone()
+    }
+}
+
+// The rows of `column` passing `filter`: NULL, e.g. for comparisons with NULL
+// values, doesn't pass.
+fn filter_mask(filter: &TableFilter, column: &ArrayRef) -> ArrowResult<BooleanArray> {
+    match filter {
+        TableFilter::IsNull => is_null(column.as_ref()),
+        TableFilter::IsNotNull => is_not_null(column.as_ref()),
+        TableFilter::And(filters) => filters
+            .iter()
+            .try_fold(BooleanArray::from(vec![true; column.len()]), |mask, filter| {
+                and_kleene(&mask, &filter_mask(filter, column)?)
+            }),
+        TableFilter::Or(filters) => filters
+            .iter()
+            .try_fold(BooleanArray::from(vec![false; column.len()]), |mask, filter| {
+                or_kleene(&mask, &filter_mask(filter, column)?)
+            }),
+        // the filter isn't applied again after the scan
+        TableFilter::Unsupported => Err(ArrowError::NotYetImplemented(
+            "unsupported filter pushed down into the arrow table".to_owned(),
+        )),
+        TableFilter::Compare(comparison, value) => {
+            let constant = constant_array(value, column.data_type(), column.len())?;
+            let (column, constant) = (column.as_ref(), constant.as_ref());
+            match comparison {
+                Comparison::Equal => eq_dyn(column, constant),
+                Comparison::NotEqual => neq_dyn(column, constant),
+                Comparison::LessThan => lt_dyn(column, constant),
+                Comparison::LessThanOrEqual => lt_eq_dyn(column, constant),
+                Comparison::GreaterThan => gt_dyn(column, constant),
+                Comparison::GreaterThanOrEqual => gt_eq_dyn(column, constant),
+            }
+        }
+    }
+}
+
+// `value` repeated `len` times as an array of `data_type`, for the comparison
+// kernels
+fn constant_array(value: &Value, data_type: &DataType, len: usize) -> ArrowResult<ArrayRef> {
+    let scalar: ArrayRef = match (value, data_type) {
+        (Value::Decimal(decimal), DataType::Decimal128(precision, scale)) => {
+            let mut decimal = *decimal;
+            decimal.rescale(*scale as u32);
+            let array: Decimal128Array = vec![Some(decimal.mantissa())].into_iter().collect();
+            Arc::new(array.with_precision_and_scale(*precision, *scale)?)
+        }
+        (Value::Boolean(b), _) => Arc::new(BooleanArray::from(vec![*b])),
+        (Value::TinyInt(i), _) => Arc::new(Int8Array::from(vec![*i])),
+        (Value::SmallInt(i), _) => Arc::new(Int16Array::from(vec![*i])),
+        (Value::Int(i), _) => Arc::new(Int32Array::from(vec![*i])),
+        (Value::BigInt(i), _) => Arc::new(Int64Array::from(vec![*i])),
+        (Value::UTinyInt(i), _) => Arc::new(UInt8Array::from(vec![*i])),
+        (Value::USmallInt(i), _) => Arc::new(UInt16Array::from(vec![*i])),
+        (Value::UInt(i), _) => Arc::new(UInt32Array::from(vec![*i])),
+        (Value::UBigInt(i), _) => Arc::new(UInt64Array::from(vec![*i])),
+        (Value::Float(f), _) => Arc::new(Float32Array::from(vec![*f])),
+        (Value::Double(f), _) => Arc::new(Float64Array::from(vec![*f])),
+        // e.g. dates and timestamps, which arrow parses
+        (Value::Text(s), _) => Arc::new(StringArray::from(vec![s.as_str()])),
+        (value, data_type) => {
+            return Err(ArrowError::NotYetImplemented(format!(
+                "filter on {} with {:?}",
+                data_type, value
+            )))
+        }
+    };
+    let scalar = cast(&scalar, data_type)?;
+    take(scalar.as_ref(), &UInt32Array::from(vec![0; len]), None)
+}
+
+#[inline]
+fn arrow_error(message: String) -> Error {
+    Error::DuckDBFailure(ffi::Error::new(ffi::DuckDBError), Some(message))
+}
+
+#[cfg(test)]
+mod test {
+    use std::sync::Arc;
+
+    use arrow::array::{Int64Array, StringArray};
+    use arrow::datatypes::{DataType, Field, Schema};
+    use arrow::record_batch::RecordBatch;
+
+    use crate::{Connection, Result};
+
+    fn batches(count: usize, rows: usize) -> Vec<RecordBatch> {
+        let schema = Arc::new(Schema::new(vec![
+            Field::new("id", DataType::Int64, false),
+            Field::new("name", DataType::Utf8, true),
+        ]));
+        (0..count)
+            .map(|batch| {
+                let ids: Vec<i64> = (batch * rows..(batch + 1) * rows).map(|id| id as i64).collect();
+                let names: Vec<Option<String>> = ids
+                    .iter()
+                    .map(|id| {
+                        if id % 3 == 0 {
+                            None
+                        } else {
+                            Some(format!("name {}", id))
+                        }
+                    })
+                    .collect();
+                RecordBatch::try_new(
+                    schema.clone(),
+                    vec![Arc::new(Int64Array::from(ids)), Arc::new(StringArray::from(names))],
+                )
+                .unwrap()
+            })
+            .collect()
+    }
+
+    #[test]
+    fn test_register_arrow() -> Result<()> {
+        let db = Connection::open_in_memory()?;
+        db.execute_batch("PRAGMA threads=4")?;
+        db.register_arrow("items", batches(100, 5000))?;
+
+        let (count, sum): (i64, i64) = db.query_row("SELECT count(*), sum(id) FROM items", [], |r| {
+            Ok((r.get(0)?, r.get(1)?))
+        })?;
+        assert_eq!(count, 500000);
+        assert_eq!(sum, (0..500000).sum::<i64>());
+
+        // projection and filters
+        let name: String = db.query_row("SELECT name FROM items WHERE id = 123457", [], |r| r.get(0))?;
+        assert_eq!(name, "name 123457");
+        let count: i64 = db.query_row(
+            "SELECT count(*) FROM items WHERE id >= 1000 AND id < 2000 AND name IS NULL",
+            [],
+            |r| r.get(0),
+        )?;
+        assert_eq!(count, (1000..2000).filter(|id| id % 3 == 0).count() as i64);
+        let count: i64 = db.query_row("SELECT count(*) FROM ITEMS WHERE name > 'name 9'", [], |r| r.get(0))?;
+        let expected = (0..500000)
+            .filter(|id| id % 3 != 0 && format!("name {}", id).as_str() > "name 9")
+            .count();
+        assert_eq!(count, expected as i64);
+
+        // the other connections of the database see the table
+        let other = db.try_clone()?;
+        let count: i64 = other.query_row("SELECT count(*) FROM items WHERE id < 10", [], |r| r.get(0))?;
+        assert_eq!(count, 10);
+        Ok(())
+    }
+
+    #[test]
+    fn test_register_arrow_replace() -> Result<()> {
+        let db = Connection::open_in_memory()?;
+        assert!(db.register_arrow("items", Vec::new()).is_err());
+        db.register_arrow("items", batches(1, 10))?;
+        let mut stmt = db.prepare("SELECT count(*) FROM items")?;
+        assert_eq!(stmt.query_row([], |r| r.get::<_, i64>(0))?, 10);
+
+        db.register_arrow("items", batches(2, 10))?;
+        let count: i64 = db.query_row("SELECT count(*) FROM items", [], |r| r.get(0))?;
+        assert_eq!(count, 20);
+
+        assert!(db.unregister_arrow("items"));
+        assert!(!db.unregister_arrow("items"));
+        assert!(db
+            .query_row("SELECT count(*) FROM items", [], |r| r.get::<_, i64>(0))
+            .is_err());
+        // a statement bound to the unregistered table fails instead of
+        // reading freed batches
+        assert!(stmt.query_row([], |r| r.get::<_, i64>(0)).is_err());
+
+        // tables and views take precedence
+        db.register_arrow("items", batches(1, 10))?;
+        db.execute_batch("CREATE TABLE items(x INTEGER)")?;
+        let count: i64 = db.query_row("SELECT count(*) FROM items", [], |r| r.get(0))?;
+        assert_eq!(count, 0);
+        Ok(())
+    }
+
+    #[test]
+    fn test_register_arrow_connections() -> Result<()> {
+        let db = Connection::open_in_memory()?;
+        let other = db.try_clone()?;
+        db.register_arrow("items", batches(1, 10))?;
+        other.register_arrow("others", batches(1, 10))?;
+        // the connections share the tables, a registration replaces the
+        // table of another connection
+        other.register_arrow("items", batches(3, 10))?;
+        let count: i64 = db.query_row("SELECT count(*) FROM items", [], |r| r.get(0))?;
+        assert_eq!(count, 30);
+
+        // a statement keeps the scan it bound, and fails once its batches are
+        // gone, however often the table was replaced since
+        let mut stmt = db.prepare("SELECT count(*) FROM others")?;
+        for _ in 0..100 {
+            other.register_arrow("others", batches(2, 10))?;
+        }
+        assert!(stmt.query_row([], |r| r.get::<_, i64>(0)).is_err());
+
+        // the tables of a connection go away with it
+        other.close().unwrap();
+        assert!(db
+            .query_row("SELECT count(*) FROM items", [], |r| r.get::<_, i64>(0))
+            .is_err());
+        assert!(db
+            .query_row("SELECT count(*) FROM others", [], |r| r.get::<_, i64>(0))
+            .is_err());
+        db.register_arrow("items", batches(1, 10))?;
+        let count: i64 = db.query_row("SELECT count(*) FROM items", [], |r| r.get(0))?;
+        assert_eq!(count, 10);
+        Ok(())
+    }
+}
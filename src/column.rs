@@ -1,5 +1,9 @@
+use std::collections::HashMap;
+use std::hash::{Hash, Hasher};
 use std::str;
 
+use arrow::datatypes::Schema;
+
 use crate::{Error, Result, Statement};
 
 /// Information about a column of a DuckDB query.
@@ -23,6 +27,101 @@ impl Column<'_> {
     }
 }
 
+/// A column of the result of a statement, resolved once by name with
+/// [`Statement::column_handle`].
+///
+/// Reading a [`Row`](crate::Row) through a handle costs the same as reading
+/// it by position, while keeping the readability of name-based access.
+///
+/// ```rust,no_run
+/// # use duckdb::{Connection, Result};
+/// fn sum_ids(conn: &Connection) -> Result<i64> {
+///     let mut stmt = conn.prepare("SELECT id, name FROM people")?;
+///     let mut rows = stmt.query([])?;
+///     let id = rows.as_ref().unwrap().column_handle("id")?;
+///     let mut sum = 0;
+///     while let Some(row) = rows.next()? {
+///         sum += row.get::<_, i64>(id)?;
+///     }
+///     Ok(sum)
+/// }
+/// ```
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+pub struct ColumnHandle {
+    index: usize,
+}
+
+impl ColumnHandle {
+    /// Returns the index of the column.
+    #[inline]
+    pub fn index(&self) -> usize {
+        self.index
+    }
+}
+
+/// A column name that hashes and compares ignoring ASCII case, like
+/// [`Statement::column_index`] matches names.
+#[repr(transparent)]
+#[derive(Debug)]
+struct CaseInsensitive(str);
+
+impl CaseInsensitive {
+    #[inline]
+    fn new(name: &str) -> &CaseInsensitive {
+        // Safety: `CaseInsensitive` is a transparent wrapper around `str`
+        unsafe { &*(name as *const str as *const CaseInsensitive) }
+    }
+
+    #[inline]
+    fn boxed(name: &str) -> Box<CaseInsensitive> {
+        // Safety: `CaseInsensitive` is a transparent wrapper around `str`
+        unsafe { Box::from_raw(Box::into_raw(Box::<str>::from(name)) as *mut CaseInsensitive) }
+    }
+}
+
+impl PartialEq for CaseInsensitive {
+    #[inline]
+    fn eq(&self, other: &CaseInsensitive) -> bool {
+        self.0.eq_ignore_ascii_case(&other.0)
+    }
+}
+
+impl Eq for CaseInsensitive {}
+
+impl Hash for CaseInsensitive {
+    #[inline]
+    fn hash<H: Hasher>(&self, state: &mut H) {
+        for b in self.0.bytes() {
+            state.write_u8(b.to_ascii_lowercase());
+        }
+        // like `str`, so that no name hashes as a prefix of another
+        state.write_u8(0xff);
+    }
+}
+
+/// Case-insensitive index of the column names of a result, built once when
+/// its schema is captured.
+#[derive(Debug)]
+pub(crate) struct ColumnIndex {
+    names: HashMap<Box<CaseInsensitive>, usize>,
+}
+
+impl ColumnIndex {
+    pub(crate) fn new(schema: &Schema) -> ColumnIndex {
+        let mut names = HashMap::with_capacity(schema.fields().len());
+        for (i, field) in schema.fields().iter().enumerate() {
+            // the first of duplicate names wins, as with a linear scan
+            names.entry(CaseInsensitive::boxed(field.name())).or_insert(i);
+        }
+        ColumnIndex { names }
+    }
+
+    #[inline]
+    pub(crate) fn get(&self, name: &str) -> Option<usize> {
+        self.names.get(CaseInsensitive::new(name)).copied()
+    }
+}
+
 impl Statement<'_> {
     /// Get all the column names in the result set of the prepared statement.
     ///
@@ -108,15 +207,24 @@ impl Statement<'_> {
     /// the specified `name`.
     #[inline]
     pub fn column_index(&self, name: &str) -> Result<usize> {
-        let n = self.column_count();
-        for i in 0..n {
-            // Note: `column_name` is only fallible if `i` is out of bounds,
-            // which we've already checked.
-            if name.eq_ignore_ascii_case(self.stmt.column_name(i).unwrap()) {
-                return Ok(i);
-            }
-        }
-        Err(Error::InvalidColumnName(String::from(name)))
+        self.stmt
+            .column_index(name)
+            .ok_or_else(|| Error::InvalidColumnName(String::from(name)))
+    }
+
+    /// Resolves a column name to a [`ColumnHandle`], to read rows by name
+    /// without looking the name up for every value.
+    ///
+    /// Names are matched like [`column_index`](Statement::column_index). The
+    /// handle stays valid for every execution of this statement.
+    ///
+    /// # Failure
+    ///
+    /// Will return an `Error::InvalidColumnName` when there is no column with
+    /// the specified `name`.
+    #[inline]
+    pub fn column_handle(&self, name: &str) -> Result<ColumnHandle> {
+        self.column_index(name).map(|index| ColumnHandle { index })
     }
 
     /// Returns a slice describing the columns of the result of the query.
@@ -164,6 +272,28 @@ mod test {
         Ok(())
     }
 
+    #[test]
+    fn test_column_index() -> Result<()> {
+        use crate::Error;
+
+        let db = Connection::open_in_memory()?;
+        let mut stmt = db.prepare("SELECT 1 AS a, 2 AS \"B\", 3 AS a, 4 AS \"Ab\"")?;
+        let mut rows = stmt.query([])?;
+        let stmt = rows.as_ref().unwrap();
+        assert_eq!(stmt.column_index("a")?, 0);
+        assert_eq!(stmt.column_index("A")?, 0);
+        assert_eq!(stmt.column_index("b")?, 1);
+        assert_eq!(stmt.column_index("aB")?, 3);
+        assert!(matches!(stmt.column_index("c"), Err(Error::InvalidColumnName(name)) if name == "c"));
+
+        let b = stmt.column_handle("B")?;
+        assert_eq!(b.index(), 1);
+        let row = rows.next()?.unwrap();
+        assert_eq!(row.get::<_, i32>(b)?, 2);
+        assert_eq!(row.get::<_, i32>("ab")?, 4);
+        Ok(())
+    }
+
     #[test]
     fn test_column_name_in_error() -> Result<()> {
         use crate::{types::Type, Error};
@@ -0,0 +1,576 @@
+use std::marker::PhantomData;
+use std::os::raw::c_char;
+use std::{slice, str};
+
+use super::ffi;
+use super::Statement;
+
+/// An handle for the data chunks of a query result, see
+/// [`Statement::query_chunks`].
+///
+/// Unlike [`Rows`](crate::Rows) and [`Arrow`](crate::Arrow), the data is not
+/// converted to Arrow: every [`DataChunk`] exposes the DuckDB vectors as they
+/// are laid out in memory.
+#[must_use = "Chunks is lazy and will do nothing unless consumed"]
+pub struct Chunks<'stmt> {
+    result: ffi::duckdb_result,
+    chunk_count: usize,
+    current_chunk: usize,
+    _stmt: PhantomData<&'stmt Statement<'stmt>>,
+}
+
+impl<'stmt> Chunks<'stmt> {
+    #[inline]
+    pub(crate) fn new(result: ffi::duckdb_result) -> Chunks<'stmt> {
+        let chunk_count = unsafe { ffi::duckdb_result_chunk_count(result) as usize };
+        Chunks {
+            result,
+            chunk_count,
+            current_chunk: 0,
+            _stmt: PhantomData,
+        }
+    }
+
+    #[inline]
+    fn result_ptr(&self) -> *mut ffi::duckdb_result {
+        // the accessors below take a mutable pointer but never modify the result
+        &self.result as *const _ as *mut _
+    }
+
+    /// Number of columns of the result.
+    #[inline]
+    pub fn column_count(&self) -> usize {
+        unsafe { ffi::duckdb_column_count(self.result_ptr()) as usize }
+    }
+
+    /// Name of the column at `idx`, `None` if out of range.
+    pub fn column_name(&self, idx: usize) -> Option<&str> {
+        unsafe {
+            let name = ffi::duckdb_column_name(self.result_ptr(), idx as u64);
+            if name.is_null() {
+                return None;
+            }
+            std::ffi::CStr::from_ptr(name).to_str().ok()
+        }
+    }
+
+    /// Number of data chunks in the result.
+    #[inline]
+    pub fn chunk_count(&self) -> usize {
+        self.chunk_count
+    }
+
+    /// Fetch the next data chunk, `None` once all of them have been read.
+    ///
+    /// The chunk borrows the result, so it has to be dropped before the next
+    /// one can be fetched.
+    #[allow(clippy::should_implement_trait)] // cannot implement Iterator
+    pub fn next(&mut self) -> Option<DataChunk<'_>> {
+        if self.current_chunk >= self.chunk_count {
+            return None;
+        }
+        let chunk = unsafe { ffi::duckdb_result_get_chunk(self.result, self.current_chunk as u64) };
+        self.current_chunk += 1;
+        if chunk.is_null() {
+            return None;
+        }
+        Some(DataChunk::new_owned(chunk))
+    }
+}
+
+impl Drop for Chunks<'_> {
+    fn drop(&mut self) {
+        unsafe { ffi::duckdb_destroy_result(&mut self.result) };
+    }
+}
+
+/// A DuckDB data chunk: a set of column [vectors](FlatVector) of the same
+/// length, at most one DuckDB vector size (1024) rows.
+pub struct DataChunk<'a> {
+    ptr: ffi::duckdb_data_chunk,
+    owned: bool,
+    _source: PhantomData<&'a ()>,
+}
+
+impl DataChunk<'_> {
+    #[inline]
+    pub(crate) fn new_owned(ptr: ffi::duckdb_data_chunk) -> Self {
+        DataChunk {
+            ptr,
+            owned: true,
+            _source: PhantomData,
+        }
+    }
+
+    /// A chunk owned by DuckDB, e.g. the output of a table function.
+    #[inline]
+    pub(crate) fn new_borrowed(ptr: ffi::duckdb_data_chunk) -> Self {
+        DataChunk {
+            ptr,
+            owned: false,
+            _source: PhantomData,
+        }
+    }
+
+    /// Number of rows in the chunk.
+    #[inline]
+    pub fn len(&self) -> usize {
+        unsafe { ffi::duckdb_data_chunk_get_size(self.ptr) as usize }
+    }
+
+    /// Maximum number of rows of the chunk, one DuckDB vector size.
+    #[inline]
+    pub fn capacity(&self) -> usize {
+        unsafe { ffi::duckdb_vector_size() as usize }
+    }
+
+    /// Set the number of rows in the chunk, once they are written to its
+    /// vectors with [`vector_mut`](DataChunk::vector_mut).
+    ///
+    /// # Panics
+    ///
+    /// Panics if `len` is over the [capacity](DataChunk::capacity).
+    pub fn set_len(&mut self, len: usize) {
+        assert!(len <= self.capacity(), "chunk length {} over capacity", len);
+        unsafe { ffi::duckdb_data_chunk_set_size(self.ptr, len as u64) };
+    }
+
+    /// Whether the chunk holds no rows.
+    #[inline]
+    pub fn is_empty(&self) -> bool {
+        self.len() == 0
+    }
+
+    /// Number of columns in the chunk.
+    #[inline]
+    pub fn column_count(&self) -> usize {
+        unsafe { ffi::duckdb_data_chunk_get_column_count(self.ptr) as usize }
+    }
+
+    /// The vector holding the column at `idx`.
+    ///
+    /// # Panics
+    ///
+    /// Panics if `idx` is out of range.
+    pub fn vector(&self, idx: usize) -> FlatVector<'_> {
+        assert!(idx < self.column_count(), "column index {} out of range", idx);
+        unsafe { FlatVector::new(ffi::duckdb_data_chunk_get_vector(self.ptr, idx as u64), self.len()) }
+    }
+
+    /// The vector holding the column at `idx`, to write its values: it spans
+    /// the [capacity](DataChunk::capacity) of the chunk rather than its
+    /// length.
+    ///
+    /// # Panics
+    ///
+    /// Panics if `idx` is out of range.
+    pub fn vector_mut(&mut self, idx: usize) -> FlatVectorMut<'_> {
+        assert!(idx < self.column_count(), "column index {} out of range", idx);
+        unsafe { FlatVectorMut::new(ffi::duckdb_data_chunk_get_vector(self.ptr, idx as u64), self.capacity()) }
+    }
+}
+
+impl Drop for DataChunk<'_> {
+    fn drop(&mut self) {
+        if self.owned {
+            unsafe { ffi::duckdb_destroy_data_chunk(&mut self.ptr) };
+        }
+    }
+}
+
+/// A flat DuckDB vector, read in place without copying.
+///
+/// A constant vector, e.g. a constant argument of a scalar function, holds a
+/// single row: the value of every row of its chunk.
+pub struct FlatVector<'a> {
+    ptr: ffi::duckdb_vector,
+    len: usize,
+    type_id: ffi::duckdb_type,
+    constant: bool,
+    _chunk: PhantomData<&'a ()>,
+}
+
+// Layout of duckdb::string_t: strings up to 12 bytes are inlined right after
+// the length, longer ones keep a 4 byte prefix and a pointer to the data.
+#[repr(C)]
+#[derive(Clone, Copy)]
+pub(crate) struct DuckDBString {
+    length: u32,
+    prefix: [c_char; 4],
+    ptr: *const c_char,
+}
+
+pub(crate) const STRING_INLINE_LENGTH: usize = 12;
+
+impl DuckDBString {
+    /// An inlined string, `bytes` must be at most `STRING_INLINE_LENGTH` long.
+    #[inline]
+    pub(crate) fn inlined(bytes: &[u8]) -> DuckDBString {
+        debug_assert!(bytes.len() <= STRING_INLINE_LENGTH);
+        // the unused bytes must be zeroed, DuckDB compares inlined strings as a whole
+        let mut string = DuckDBString {
+            length: bytes.len() as u32,
+            prefix: [0; 4],
+            ptr: std::ptr::null(),
+        };
+        unsafe {
+            let data = (&mut string as *mut DuckDBString as *mut u8).add(4);
+            std::ptr::copy_nonoverlapping(bytes.as_ptr(), data, bytes.len());
+        }
+        string
+    }
+
+    /// A string referencing `bytes`, inlined if it is short enough: it must
+    /// not outlive `bytes`.
+    #[inline]
+    pub(crate) fn borrowed(bytes: &[u8]) -> DuckDBString {
+        if bytes.len() <= STRING_INLINE_LENGTH {
+            return DuckDBString::inlined(bytes);
+        }
+        debug_assert!(bytes.len() <= u32::MAX as usize);
+        let mut prefix = [0; 4];
+        for (p, &b) in prefix.iter_mut().zip(bytes) {
+            *p = b as c_char;
+        }
+        DuckDBString {
+            length: bytes.len() as u32,
+            prefix,
+            ptr: bytes.as_ptr() as *const c_char,
+        }
+    }
+
+    #[inline]
+    fn as_bytes(&self) -> &[u8] {
+        let len = self.length as usize;
+        unsafe {
+            let data = if len <= STRING_INLINE_LENGTH {
+                // the inlined bytes span both the prefix and the pointer
+                (self as *const DuckDBString as *const u8).add(4)
+            } else {
+                self.ptr as *const u8
+            };
+            slice::from_raw_parts(data, len)
+        }
+    }
+}
+
+impl FlatVector<'_> {
+    #[inline]
+    unsafe fn new(ptr: ffi::duckdb_vector, len: usize) -> Self {
+        let mut logical_type = ffi::duckdb_vector_get_column_type(ptr);
+        let type_id = ffi::duckdb_get_type_id(logical_type);
+        ffi::duckdb_destroy_logical_type(&mut logical_type);
+        let constant = ffi::duckdb_vector_is_constant(ptr);
+        FlatVector {
+            ptr,
+            len: if constant { len.min(1) } else { len },
+            type_id,
+            constant,
+            _chunk: PhantomData,
+        }
+    }
+
+    /// Number of rows in the vector, at most one for a constant vector.
+    #[inline]
+    pub fn len(&self) -> usize {
+        self.len
+    }
+
+    /// Whether the vector is constant, its single row standing for every row
+    /// of the chunk.
+    #[inline]
+    pub fn is_constant(&self) -> bool {
+        self.constant
+    }
+
+    /// Whether the vector holds no rows.
+    #[inline]
+    pub fn is_empty(&self) -> bool {
+        self.len == 0
+    }
+
+    /// The DuckDB type of the vector, one of the `ffi::DUCKDB_TYPE_*`
+    /// constants.
+    #[inline]
+    pub fn type_id(&self) -> ffi::duckdb_type {
+        self.type_id
+    }
+
+    /// Whether the value at `row` is not NULL.
+    #[inline]
+    pub fn is_valid(&self, row: usize) -> bool {
+        assert!(row < self.len, "row index {} out of range", row);
+        unsafe {
+            let validity = ffi::duckdb_vector_get_validity(self.ptr);
+            // a missing validity mask means that every row is valid
+            validity.is_null() || *validity.add(row / 64) & (1 << (row % 64)) != 0
+        }
+    }
+
+    /// The values of the vector as a slice, or `None` if `T` doesn't match the
+    /// vector type.
+    ///
+    /// NULL rows hold unspecified values, check them with
+    /// [`is_valid`](FlatVector::is_valid).
+    #[inline]
+    pub fn values<T: VectorValue>(&self) -> Option<&[T]> {
+        if !T::is_compatible(self.type_id) {
+            return None;
+        }
+        unsafe {
+            let data = ffi::duckdb_vector_get_data(self.ptr) as *const T;
+            Some(slice::from_raw_parts(data, self.len))
+        }
+    }
+
+    /// The string at `row`, `None` if it's NULL.
+    ///
+    /// # Panics
+    ///
+    /// Panics if the vector is not a VARCHAR vector.
+    pub fn get_str(&self, row: usize) -> Option<&str> {
+        assert!(
+            self.type_id == ffi::DUCKDB_TYPE_DUCKDB_TYPE_VARCHAR || self.type_id == ffi::DUCKDB_TYPE_DUCKDB_TYPE_JSON,
+            "not a VARCHAR vector"
+        );
+        // DuckDB validates VARCHAR values as UTF-8
+        self.get_bytes(row).map(|b| unsafe { str::from_utf8_unchecked(b) })
+    }
+
+    /// The blob at `row`, `None` if it's NULL.
+    ///
+    /// # Panics
+    ///
+    /// Panics if the vector is neither a BLOB nor a VARCHAR vector.
+    pub fn get_blob(&self, row: usize) -> Option<&[u8]> {
+        assert!(
+            self.type_id == ffi::DUCKDB_TYPE_DUCKDB_TYPE_BLOB
+                || self.type_id == ffi::DUCKDB_TYPE_DUCKDB_TYPE_VARCHAR
+                || self.type_id == ffi::DUCKDB_TYPE_DUCKDB_TYPE_JSON,
+            "not a BLOB vector"
+        );
+        self.get_bytes(row)
+    }
+
+    #[inline]
+    fn get_bytes(&self, row: usize) -> Option<&[u8]> {
+        if !self.is_valid(row) {
+            return None;
+        }
+        unsafe {
+            let data = ffi::duckdb_vector_get_data(self.ptr) as *const DuckDBString;
+            Some((*data.add(row)).as_bytes())
+        }
+    }
+}
+
+/// A flat DuckDB vector being written, see [`DataChunk::vector_mut`].
+///
+/// Values are written in place: fixed-width values through
+/// [`values_mut`](FlatVectorMut::values_mut), strings and blobs are copied to
+/// the string heap of the vector.
+pub struct FlatVectorMut<'a> {
+    ptr: ffi::duckdb_vector,
+    len: usize,
+    type_id: ffi::duckdb_type,
+    _chunk: PhantomData<&'a mut ()>,
+}
+
+impl FlatVectorMut<'_> {
+    #[inline]
+    pub(crate) unsafe fn new(ptr: ffi::duckdb_vector, len: usize) -> Self {
+        let mut logical_type = ffi::duckdb_vector_get_column_type(ptr);
+        let type_id = ffi::duckdb_get_type_id(logical_type);
+        ffi::duckdb_destroy_logical_type(&mut logical_type);
+        FlatVectorMut {
+            ptr,
+            len,
+            type_id,
+            _chunk: PhantomData,
+        }
+    }
+
+    /// Number of rows that can be written.
+    #[inline]
+    pub fn len(&self) -> usize {
+        self.len
+    }
+
+    /// Whether no row can be written.
+    #[inline]
+    pub fn is_empty(&self) -> bool {
+        self.len == 0
+    }
+
+    /// The DuckDB type of the vector, one of the `ffi::DUCKDB_TYPE_*`
+    /// constants.
+    #[inline]
+    pub fn type_id(&self) -> ffi::duckdb_type {
+        self.type_id
+    }
+
+    /// The values of the vector as a mutable slice, or `None` if `T` doesn't
+    /// match the vector type.
+    #[inline]
+    pub fn values_mut<T: VectorValue>(&mut self) -> Option<&mut [T]> {
+        if !T::is_compatible(self.type_id) {
+            return None;
+        }
+        unsafe {
+            let data = ffi::duckdb_vector_get_data(self.ptr) as *mut T;
+            Some(slice::from_raw_parts_mut(data, self.len))
+        }
+    }
+
+    /// Make the vector constant: its first row is then the value of every row
+    /// of the chunk, e.g. for the result of a scalar function whose arguments
+    /// are all constant.
+    #[inline]
+    pub fn set_constant(&mut self) {
+        unsafe { ffi::duckdb_vector_set_constant(self.ptr) };
+    }
+
+    /// Set the value at `row` to NULL.
+    pub fn set_null(&mut self, row: usize) {
+        assert!(row < self.len, "row index {} out of range", row);
+        unsafe {
+            // the validity mask starts out with every row valid
+            ffi::duckdb_vector_ensure_validity_writable(self.ptr);
+            let validity = ffi::duckdb_vector_get_validity(self.ptr);
+            *validity.add(row / 64) &= !(1 << (row % 64));
+        }
+    }
+
+    /// Set the value at `row` of a BOOLEAN vector.
+    ///
+    /// # Panics
+    ///
+    /// Panics if the vector is not a BOOLEAN vector.
+    pub fn set_bool(&mut self, row: usize, value: bool) {
+        assert!(row < self.len, "row index {} out of range", row);
+        assert!(
+            self.type_id == ffi::DUCKDB_TYPE_DUCKDB_TYPE_BOOLEAN,
+            "not a BOOLEAN vector"
+        );
+        unsafe { *(ffi::duckdb_vector_get_data(self.ptr) as *mut bool).add(row) = value };
+    }
+
+    /// Set the value at `row` of a VARCHAR vector to a copy of `value`.
+    ///
+    /// # Panics
+    ///
+    /// Panics if the vector is not a VARCHAR vector.
+    pub fn set_str(&mut self, row: usize, value: &str) {
+        assert!(
+            self.type_id == ffi::DUCKDB_TYPE_DUCKDB_TYPE_VARCHAR || self.type_id == ffi::DUCKDB_TYPE_DUCKDB_TYPE_JSON,
+            "not a VARCHAR vector"
+        );
+        self.set_bytes(row, value.as_bytes());
+    }
+
+    /// Set the value at `row` of a BLOB vector to a copy of `value`.
+    ///
+    /// # Panics
+    ///
+    /// Panics if the vector is not a BLOB vector.
+    pub fn set_blob(&mut self, row: usize, value: &[u8]) {
+        assert!(self.type_id == ffi::DUCKDB_TYPE_DUCKDB_TYPE_BLOB, "not a BLOB vector");
+        self.set_bytes(row, value);
+    }
+
+    #[inline]
+    fn set_bytes(&mut self, row: usize, value: &[u8]) {
+        assert!(row < self.len, "row index {} out of range", row);
+        unsafe {
+            ffi::duckdb_vector_assign_string_element_len(
+                self.ptr,
+                row as u64,
+                value.as_ptr() as *const c_char,
+                value.len() as u64,
+            )
+        };
+    }
+}
+
+mod sealed {
+    /// This trait exists just to ensure that the only impls of `trait
+    /// VectorValue` that are allowed are ones in this crate.
+    pub trait Sealed {}
+}
+
+/// A type with the same in-memory representation as the values of some
+/// DuckDB vectors, see [`FlatVector::values`].
+pub trait VectorValue: sealed::Sealed + Copy {
+    /// Whether vectors of DuckDB type `type_id` hold values of this type.
+    fn is_compatible(type_id: ffi::duckdb_type) -> bool;
+}
+
+macro_rules! vector_value {
+    ($t:ty, $($type_id:ident)|+) => {
+        impl sealed::Sealed for $t {}
+        impl VectorValue for $t {
+            #[inline]
+            fn is_compatible(type_id: ffi::duckdb_type) -> bool {
+                $(type_id == ffi::$type_id)||+
+            }
+        }
+    };
+}
+
+vector_value!(i8, DUCKDB_TYPE_DUCKDB_TYPE_TINYINT);
+vector_value!(i16, DUCKDB_TYPE_DUCKDB_TYPE_SMALLINT);
+// DATE is stored as days since the epoch
+vector_value!(i32, DUCKDB_TYPE_DUCKDB_TYPE_INTEGER | DUCKDB_TYPE_DUCKDB_TYPE_DATE);
+// TIME and the TIMESTAMP types are stored as a count of their unit
+vector_value!(
+    i64,
+    DUCKDB_TYPE_DUCKDB_TYPE_BIGINT
+        | DUCKDB_TYPE_DUCKDB_TYPE_TIME
+        | DUCKDB_TYPE_DUCKDB_TYPE_TIMESTAMP
+        | DUCKDB_TYPE_DUCKDB_TYPE_TIMESTAMP_S
+        | DUCKDB_TYPE_DUCKDB_TYPE_TIMESTAMP_MS
+        | DUCKDB_TYPE_DUCKDB_TYPE_TIMESTAMP_NS
+);
+vector_value!(u8, DUCKDB_TYPE_DUCKDB_TYPE_UTINYINT);
+vector_value!(u16, DUCKDB_TYPE_DUCKDB_TYPE_USMALLINT);
+vector_value!(u32, DUCKDB_TYPE_DUCKDB_TYPE_UINTEGER);
+vector_value!(u64, DUCKDB_TYPE_DUCKDB_TYPE_UBIGINT);
+vector_value!(f32, DUCKDB_TYPE_DUCKDB_TYPE_FLOAT);
+vector_value!(f64, DUCKDB_TYPE_DUCKDB_TYPE_DOUBLE);
+
+#[cfg(test)]
+mod test {
+    use crate::ffi;
+    use crate::{Connection, Result};
+
+    #[test]
+    fn test_query_chunks() -> Result<()> {
+        let db = Connection::open_in_memory()?;
+        let mut stmt = db.prepare(
+            "SELECT i::INTEGER, CASE WHEN i % 3 = 0 THEN NULL ELSE repeat('x', (i % 20)::INTEGER) END \
+             FROM range(0, 3000) t(i) ORDER BY i",
+        )?;
+        let mut chunks = stmt.query_chunks([])?;
+        assert_eq!(chunks.column_count(), 2);
+        assert!(chunks.chunk_count() >= 3);
+
+        let mut expected = 0i32;
+        while let Some(chunk) = chunks.next() {
+            let ints = chunk.vector(0);
+            let strs = chunk.vector(1);
+            assert_eq!(ints.type_id(), ffi::DUCKDB_TYPE_DUCKDB_TYPE_INTEGER);
+            assert!(ints.values::<i64>().is_none());
+            for (row, &i) in ints.values::<i32>().unwrap().iter().enumerate() {
+                assert_eq!(i, expected);
+                // both inlined (<= 12 bytes) and out of line strings
+                match strs.get_str(row) {
+                    None => assert_eq!(i % 3, 0),
+                    Some(s) => assert_eq!(s, "x".repeat((i % 20) as usize)),
+                }
+                expected += 1;
+            }
+        }
+        assert_eq!(expected, 3000);
+        Ok(())
+    }
+}
@@ -2,9 +2,11 @@ use super::Result;
 use crate::ffi;
 use crate::types::FromSqlError;
 use crate::types::Type;
+use arrow::error::ArrowError;
 use std::error;
 use std::ffi::CStr;
 use std::fmt;
+use std::io;
 use std::path::PathBuf;
 use std::str;
 
@@ -81,6 +83,14 @@ pub enum Error {
 
     /// Apppend Error
     AppendError,
+
+    /// Error reading the input of a stream, e.g. in
+    /// [`copy_csv_from_reader`](crate::Connection::copy_csv_from_reader).
+    ReadError(io::Error),
+
+    /// Error converting a result to or from Arrow, e.g. for a type Arrow
+    /// can't represent.
+    ArrowError(ArrowError),
 }
 
 impl PartialEq for Error {
@@ -113,6 +123,13 @@ impl From<str::Utf8Error> for Error {
     }
 }
 
+impl From<ArrowError> for Error {
+    #[cold]
+    fn from(err: ArrowError) -> Error {
+        Error::ArrowError(err)
+    }
+}
+
 impl From<::std::ffi::NulError> for Error {
     #[cold]
     fn from(err: ::std::ffi::NulError) -> Error {
@@ -183,6 +200,8 @@ impl fmt::Display for Error {
             Error::InvalidQuery => write!(f, "Query is not read-only"),
             Error::MultipleStatement => write!(f, "Multiple statements provided"),
             Error::AppendError => write!(f, "Append error"),
+            Error::ReadError(ref err) => write!(f, "Read error: {}", err),
+            Error::ArrowError(ref err) => err.fmt(f),
         }
     }
 }
@@ -193,6 +212,8 @@ impl error::Error for Error {
             Error::DuckDBFailure(ref err, _) => Some(err),
             Error::Utf8Error(ref err) => Some(err),
             Error::NulError(ref err) => Some(err),
+            Error::ReadError(ref err) => Some(err),
+            Error::ArrowError(ref err) => Some(err),
 
             Error::IntegralValueOutOfRange(..)
             | Error::InvalidParameterName(_)
@@ -215,8 +236,29 @@ impl error::Error for Error {
 // These are public but not re-exported by lib.rs, so only visible within crate.
 
 #[inline]
-fn error_from_duckdb_code(code: ffi::duckdb_state, message: Option<String>) -> Result<()> {
-    Err(Error::DuckDBFailure(ffi::Error::new(code), message))
+pub fn error_from_duckdb_code(code: ffi::duckdb_state, message: Option<String>) -> Result<()> {
+    // DuckDB only tells interrupted queries apart through the message
+    let error = match message {
+        Some(ref message) if message.starts_with("INTERRUPT Error") => error_interrupted_code(code),
+        _ => ffi::Error::new(code),
+    };
+    Err(Error::DuckDBFailure(error, message))
+}
+
+#[inline]
+fn error_interrupted_code(code: ffi::duckdb_state) -> ffi::Error {
+    ffi::Error {
+        code: ffi::ErrorCode::OperationInterrupted,
+        extended_code: code,
+    }
+}
+
+#[cold]
+pub fn error_timed_out() -> Error {
+    Error::DuckDBFailure(
+        error_interrupted_code(ffi::DuckDBError),
+        Some("INTERRUPT Error: Query timed out".to_owned()),
+    )
 }
 
 #[cold]
@@ -238,6 +280,85 @@ pub fn result_from_duckdb_appender(code: ffi::duckdb_state, mut appender: ffi::d
     }
 }
 
+// Leaves the parallel appender to its owner, which destroys it on drop.
+#[cold]
+#[inline]
+pub fn result_from_duckdb_parallel_appender(
+    code: ffi::duckdb_state,
+    appender: ffi::duckdb_parallel_appender,
+) -> Result<()> {
+    if code == ffi::DuckDBSuccess {
+        return Ok(());
+    }
+    let message = unsafe {
+        let c_err = ffi::duckdb_parallel_appender_error(appender);
+        if c_err.is_null() {
+            None
+        } else {
+            Some(CStr::from_ptr(c_err).to_string_lossy().to_string())
+        }
+    };
+    error_from_duckdb_code(code, message)
+}
+
+// Leaves the prepared batch to its owner, which destroys it on drop.
+#[cold]
+#[inline]
+pub fn result_from_duckdb_prepared_batch(code: ffi::duckdb_state, batch: ffi::duckdb_prepared_batch) -> Result<()> {
+    if code == ffi::DuckDBSuccess {
+        return Ok(());
+    }
+    let message = unsafe {
+        let c_err = ffi::duckdb_prepared_batch_error(batch);
+        if c_err.is_null() {
+            None
+        } else {
+            Some(CStr::from_ptr(c_err).to_string_lossy().to_string())
+        }
+    };
+    error_from_duckdb_code(code, message)
+}
+
+// Leaves the scalar function to its owner, which destroys it once registered.
+#[cold]
+#[inline]
+pub fn result_from_duckdb_scalar_function(
+    code: ffi::duckdb_state,
+    function: ffi::duckdb_scalar_function,
+) -> Result<()> {
+    if code == ffi::DuckDBSuccess {
+        return Ok(());
+    }
+    let message = unsafe {
+        let c_err = ffi::duckdb_scalar_function_error(function);
+        if c_err.is_null() {
+            None
+        } else {
+            Some(CStr::from_ptr(c_err).to_string_lossy().to_string())
+        }
+    };
+    error_from_duckdb_code(code, message)
+}
+
+// Unlike `result_from_duckdb_appender`, leaves the appender to its owner: a
+// failed append doesn't invalidate it.
+#[cold]
+#[inline]
+pub fn result_from_duckdb_append(code: ffi::duckdb_state, appender: ffi::duckdb_appender) -> Result<()> {
+    if code == ffi::DuckDBSuccess {
+        return Ok(());
+    }
+    let message = unsafe {
+        let c_err = ffi::duckdb_appender_error(appender);
+        if c_err.is_null() {
+            None
+        } else {
+            Some(CStr::from_ptr(c_err).to_string_lossy().to_string())
+        }
+    };
+    error_from_duckdb_code(code, message)
+}
+
 #[cold]
 #[inline]
 pub fn result_from_duckdb_prepare(code: ffi::duckdb_state, mut prepare: ffi::duckdb_prepared_statement) -> Result<()> {
@@ -275,3 +396,59 @@ pub fn result_from_duckdb_arrow(code: ffi::duckdb_state, mut out: ffi::duckdb_ar
         error_from_duckdb_code(code, message)
     }
 }
+
+#[cold]
+#[inline]
+pub fn result_from_duckdb_pending(code: ffi::duckdb_state, mut pending: ffi::duckdb_pending_result) -> Result<()> {
+    if code == ffi::DuckDBSuccess {
+        return Ok(());
+    }
+    unsafe {
+        let message = if pending.is_null() {
+            Some("pending is null".to_string())
+        } else {
+            let c_err = ffi::duckdb_pending_error(pending);
+            let message = Some(CStr::from_ptr(c_err).to_string_lossy().to_string());
+            ffi::duckdb_destroy_pending(&mut pending);
+            message
+        };
+        error_from_duckdb_code(code, message)
+    }
+}
+
+#[cold]
+#[inline]
+pub fn result_from_duckdb_arrow_stream(code: ffi::duckdb_state, mut out: ffi::duckdb_arrow_stream) -> Result<()> {
+    if code == ffi::DuckDBSuccess {
+        return Ok(());
+    }
+    unsafe {
+        let message = if out.is_null() {
+            Some("out is null".to_string())
+        } else {
+            let c_err = ffi::duckdb_arrow_stream_error(out);
+            let message = Some(CStr::from_ptr(c_err).to_string_lossy().to_string());
+            ffi::duckdb_destroy_arrow_stream(&mut out);
+            message
+        };
+        error_from_duckdb_code(code, message)
+    }
+}
+
+#[cold]
+#[inline]
+pub fn result_from_duckdb_result(code: ffi::duckdb_state, out: &mut ffi::duckdb_result) -> Result<()> {
+    if code == ffi::DuckDBSuccess {
+        return Ok(());
+    }
+    unsafe {
+        let c_err = ffi::duckdb_result_error(out);
+        let message = if c_err.is_null() {
+            None
+        } else {
+            Some(CStr::from_ptr(c_err).to_string_lossy().to_string())
+        };
+        ffi::duckdb_destroy_result(out);
+        error_from_duckdb_code(code, message)
+    }
+}
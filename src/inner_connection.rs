@@ -3,22 +3,37 @@ use std::mem;
 use std::os::raw::c_char;
 use std::ptr;
 use std::str;
+use std::sync::atomic::AtomicU8;
+use std::sync::{Arc, Mutex};
 
 use super::ffi;
-use super::{Appender, Config, Connection, Result};
-use crate::error::{result_from_duckdb_appender, result_from_duckdb_arrow, result_from_duckdb_prepare, Error};
+use super::{Appender, AppenderOptions, Config, Connection, InterruptHandle, ParallelAppender, Result, PROGRESS_OFF};
+use crate::arrow_scan::ArrowTables;
+use crate::error::{
+    result_from_duckdb_appender, result_from_duckdb_arrow, result_from_duckdb_parallel_appender,
+    result_from_duckdb_prepare, Error,
+};
 use crate::raw_statement::RawStatement;
 use crate::statement::Statement;
 
 pub struct InnerConnection {
     pub db: ffi::duckdb_database,
     pub con: ffi::duckdb_connection,
+    interrupt_lock: Arc<Mutex<ffi::duckdb_connection>>,
+    progress: Arc<AtomicU8>,
+    // the Arrow tables registered on the connections of the database, see
+    // `register_arrow`
+    pub arrow_tables: Arc<ArrowTables>,
     owned: bool,
 }
 
 impl InnerConnection {
     #[inline]
-    pub unsafe fn new(db: ffi::duckdb_database, owned: bool) -> Result<InnerConnection> {
+    pub unsafe fn new(
+        db: ffi::duckdb_database,
+        arrow_tables: Arc<ArrowTables>,
+        owned: bool,
+    ) -> Result<InnerConnection> {
         let mut con: ffi::duckdb_connection = ptr::null_mut();
         let r = ffi::duckdb_connect(db, &mut con);
         if r != ffi::DuckDBSuccess {
@@ -28,7 +43,14 @@ impl InnerConnection {
                 Some("connect error".to_owned()),
             ));
         }
-        Ok(InnerConnection { db, con, owned })
+        Ok(InnerConnection {
+            db,
+            con,
+            interrupt_lock: Arc::new(Mutex::new(con)),
+            progress: Arc::new(AtomicU8::new(PROGRESS_OFF)),
+            arrow_tables,
+            owned,
+        })
     }
 
     pub fn open_with_flags(c_path: &CStr, config: Config) -> Result<InnerConnection> {
@@ -41,7 +63,7 @@ impl InnerConnection {
                 ffi::duckdb_free(c_err as *mut c_void);
                 return Err(Error::DuckDBFailure(ffi::Error::new(r), msg));
             }
-            InnerConnection::new(db, true)
+            InnerConnection::new(db, Arc::new(ArrowTables::default()), true)
         }
     }
 
@@ -52,6 +74,10 @@ impl InnerConnection {
         if self.con.is_null() {
             return Ok(());
         }
+        // no more interrupts once the connection is gone
+        let mut shared_handle = self.interrupt_lock.lock().unwrap();
+        *shared_handle = ptr::null_mut();
+        self.arrow_tables.remove_owned_by(self.con as usize);
         unsafe {
             ffi::duckdb_disconnect(&mut self.con);
             self.con = ptr::null_mut();
@@ -66,11 +92,12 @@ impl InnerConnection {
 
     /// Creates a new connection to the already-opened database.
     pub fn try_clone(&self) -> Result<Self> {
-        unsafe { InnerConnection::new(self.db, false) }
+        unsafe { InnerConnection::new(self.db, self.arrow_tables.clone(), false) }
     }
 
     pub fn execute(&mut self, sql: &str) -> Result<()> {
         let c_str = CString::new(sql).unwrap();
+        self.get_interrupt_handle().enable_requested_progress();
         unsafe {
             let mut out = mem::zeroed();
             let r = ffi::duckdb_query_arrow(self.con, c_str.as_ptr() as *const c_char, &mut out);
@@ -85,23 +112,64 @@ impl InnerConnection {
         let c_str = CString::new(sql).unwrap();
         let r = unsafe { ffi::duckdb_prepare(self.con, c_str.as_ptr() as *const c_char, &mut c_stmt) };
         result_from_duckdb_prepare(r, c_stmt)?;
-        Ok(Statement::new(conn, unsafe { RawStatement::new(c_stmt) }))
+        let mut stmt = unsafe { RawStatement::new(c_stmt) };
+        stmt.set_interrupt_handle(self.get_interrupt_handle());
+        Ok(Statement::new(conn, stmt))
     }
 
-    pub fn appender<'a>(&mut self, conn: &'a Connection, table: &str, schema: &str) -> Result<Appender<'a>> {
+    #[inline]
+    pub fn get_interrupt_handle(&self) -> InterruptHandle {
+        InterruptHandle {
+            conn_lock: Arc::clone(&self.interrupt_lock),
+            progress: Arc::clone(&self.progress),
+        }
+    }
+
+    pub fn appender<'a>(
+        &mut self,
+        conn: &'a Connection,
+        table: &str,
+        schema: &str,
+        options: &AppenderOptions,
+    ) -> Result<Appender<'a>> {
         let mut c_app: ffi::duckdb_appender = ptr::null_mut();
         let c_table = CString::new(table).unwrap();
         let c_schema = CString::new(schema).unwrap();
         let r = unsafe {
-            ffi::duckdb_appender_create(
+            ffi::duckdb_appender_create_ext(
                 self.con,
                 c_schema.as_ptr() as *const c_char,
                 c_table.as_ptr() as *const c_char,
+                options.manual_flush(),
+                options.background_flush,
                 &mut c_app,
             )
         };
         result_from_duckdb_appender(r, c_app)?;
-        Ok(Appender::new(conn, c_app))
+        Ok(Appender::new(conn, c_app, options))
+    }
+
+    pub fn parallel_appender<'a>(
+        &mut self,
+        conn: &'a Connection,
+        table: &str,
+        schema: &str,
+    ) -> Result<ParallelAppender<'a>> {
+        let mut c_app: ffi::duckdb_parallel_appender = ptr::null_mut();
+        let c_table = CString::new(table).unwrap();
+        let c_schema = CString::new(schema).unwrap();
+        let r = unsafe {
+            ffi::duckdb_parallel_appender_create(
+                self.con,
+                c_schema.as_ptr() as *const c_char,
+                c_table.as_ptr() as *const c_char,
+                &mut c_app,
+            )
+        };
+        // destroyed on drop, failed or not
+        let appender = ParallelAppender::new(conn, c_app);
+        result_from_duckdb_parallel_appender(r, c_app)?;
+        Ok(appender)
     }
 
     #[inline]
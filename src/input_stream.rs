@@ -0,0 +1,508 @@
+//! Ingest of CSV and NDJSON read from any [`Read`], e.g. a pipe.
+
+use std::ffi::{CStr, CString};
+use std::io::{self, Read};
+use std::os::raw::c_void;
+use std::panic;
+use std::ptr;
+use std::thread;
+
+use super::ffi;
+use super::{Connection, Error, Result};
+use crate::pragma::Sql;
+
+#[cfg(feature = "serde_json")]
+use crate::types::{Value, ValueRef};
+#[cfg(feature = "serde_json")]
+use crate::Appender;
+#[cfg(feature = "serde_json")]
+use std::sync::mpsc::{self, SyncSender};
+
+/// Options of the ingest of the bytes of a [`Read`], see
+/// [`Connection::read_stream`]
+#[derive(Debug, Clone, Copy)]
+pub struct StreamOptions {
+    pub(crate) window: usize,
+    pub(crate) read_size: usize,
+}
+
+impl Default for StreamOptions {
+    #[inline]
+    fn default() -> StreamOptions {
+        StreamOptions {
+            window: 16 << 20,
+            read_size: 1 << 20,
+        }
+    }
+}
+
+impl StreamOptions {
+    /// Buffer at most about this many bytes read from the reader but not
+    /// parsed yet, 16 MiB by default
+    ///
+    /// The reader waits for the parser once the window is full.
+    pub fn window(mut self, bytes: usize) -> StreamOptions {
+        self.window = bytes.max(1);
+        self
+    }
+
+    /// Read this many bytes at a time from the reader, 1 MiB by default
+    pub fn read_size(mut self, bytes: usize) -> StreamOptions {
+        self.read_size = bytes.max(1);
+        self
+    }
+}
+
+impl Connection {
+    /// Run queries reading the bytes of `reader` as a file, without writing
+    /// them anywhere
+    ///
+    /// `f` gets the path of the file, to read with e.g. `read_csv_auto` or
+    /// `COPY ... FROM`. The file is read like a pipe, by a single query: only
+    /// its first [`StreamOptions::window`] bytes can be read again, e.g. to
+    /// auto-detect the format of a CSV file. Meanwhile another thread reads
+    /// `reader`, so that reading, parsing and appending the rows overlap,
+    /// with at most a window of bytes in between.
+    ///
+    /// ## Example
+    ///
+    /// ```rust,no_run
+    /// # use duckdb::{Connection, Result, StreamOptions};
+    /// # use std::io;
+    /// fn load_stdin(conn: &Connection) -> Result<usize> {
+    ///     conn.read_stream(io::stdin(), StreamOptions::default(), |path| {
+    ///         conn.execute(&format!("CREATE TABLE foo AS SELECT * FROM read_csv_auto('{}')", path), [])
+    ///     })
+    /// }
+    /// ```
+    ///
+    /// # Failure
+    ///
+    /// Will return `Err` if `reader` fails, or with the error of `f`
+    pub fn read_stream<R, F, T>(&self, reader: R, options: StreamOptions, f: F) -> Result<T>
+    where
+        R: Read + Send,
+        F: FnOnce(&str) -> Result<T>,
+    {
+        let stream = InputStream::new(self, options.window)?;
+        let (result, read) = thread::scope(|s| {
+            let writer = s.spawn(|| stream.write_from(reader, options.read_size));
+            let result = {
+                // a query done before the end of the stream, or that never
+                // read it, leaves the writer waiting otherwise
+                let _stop = StopOnDrop(&stream);
+                f(stream.path())
+            };
+            match writer.join() {
+                Ok(read) => (result, read),
+                Err(panic) => panic::resume_unwind(panic),
+            }
+        });
+        // the query only knows the message of a read error
+        read.map_err(Error::ReadError)?;
+        result
+    }
+
+    /// Append the CSV rows read from `reader` to `table`, returning the
+    /// number of rows appended
+    ///
+    /// `csv_options` are the options of `COPY ... FROM`, e.g.
+    /// `"HEADER, DELIMITER '|'"`, see [`read_stream`](Connection::read_stream).
+    ///
+    /// ## Example
+    ///
+    /// ```rust,no_run
+    /// # use duckdb::{Connection, Result, StreamOptions};
+    /// # use std::io;
+    /// fn load_stdin(conn: &Connection) -> Result<usize> {
+    ///     conn.copy_csv_from_reader("foo", io::stdin(), "HEADER", StreamOptions::default().window(64 << 20))
+    /// }
+    /// ```
+    ///
+    /// # Failure
+    ///
+    /// Will return `Err` if `reader` fails, or if the rows can't be parsed or
+    /// appended to the table, in which case none of them are
+    pub fn copy_csv_from_reader<R: Read + Send>(
+        &self,
+        table: &str,
+        reader: R,
+        csv_options: &str,
+        options: StreamOptions,
+    ) -> Result<usize> {
+        self.read_stream(reader, options, |path| {
+            let mut target = Sql::new();
+            target.push_identifier(table);
+            let mut source = Sql::new();
+            source.push_string_literal(path);
+            let mut sql = format!("COPY {} FROM {}", &*target, &*source);
+            if !csv_options.is_empty() {
+                sql = format!("{} ({})", sql, csv_options);
+            }
+            self.execute(&sql, [])
+        })
+    }
+
+    /// Append the rows of the newline-delimited JSON objects read from
+    /// `reader` to `table`, returning the number of rows appended
+    ///
+    /// The fields of the objects are matched with the columns of the table by
+    /// name: missing fields are NULL, other fields are ignored. Nested arrays
+    /// and objects are appended as their JSON text. The lines are parsed and
+    /// appended while another thread reads `reader`, with at most
+    /// [`StreamOptions::window`] bytes in between.
+    ///
+    /// # Failure
+    ///
+    /// Will return `Err` if `reader` fails, if a line isn't a JSON object or if
+    /// the rows can't be appended to the table. The rows appended before are
+    /// kept.
+    #[cfg(feature = "serde_json")]
+    pub fn copy_ndjson_from_reader<R: Read + Send>(
+        &self,
+        table: &str,
+        reader: R,
+        options: StreamOptions,
+    ) -> Result<usize> {
+        let names = {
+            let mut target = Sql::new();
+            target.push_identifier(table);
+            let sql = format!("SELECT * FROM {} LIMIT 0", &*target);
+            let mut stmt = self.prepare(&sql)?;
+            stmt.query([])?;
+            stmt.column_names()
+        };
+        let mut app = self.appender(table)?;
+        let (sender, receiver) = mpsc::sync_channel((options.window / options.read_size).max(1));
+        let (result, read) = thread::scope(|s| {
+            let reader = s.spawn(move || read_lines(reader, options.read_size, sender));
+            let mut rows = 0;
+            let mut line_number = 0;
+            let mut result = Ok(());
+            for batch in receiver.iter() {
+                match append_ndjson(&mut app, &names, &batch, &mut line_number) {
+                    Ok(appended) => rows += appended,
+                    Err(err) => {
+                        result = Err(err);
+                        break;
+                    }
+                }
+            }
+            // stops the reader if the rows failed to append
+            drop(receiver);
+            match reader.join() {
+                Ok(read) => (result.map(|_| rows), read),
+                Err(panic) => panic::resume_unwind(panic),
+            }
+        });
+        read.map_err(Error::ReadError)?;
+        let rows = result?;
+        app.flush()?;
+        Ok(rows)
+    }
+}
+
+// Bytes written by a thread reading a `Read` while a query reads them through
+// the path of the stream.
+struct InputStream {
+    ptr: ffi::duckdb_input_stream,
+}
+
+// Everything but destroying the stream, which takes `&mut self`, is thread
+// safe.
+unsafe impl Send for InputStream {}
+unsafe impl Sync for InputStream {}
+
+impl InputStream {
+    fn new(conn: &Connection, window: usize) -> Result<InputStream> {
+        let mut ptr: ffi::duckdb_input_stream = ptr::null_mut();
+        let r = unsafe { ffi::duckdb_input_stream_create(conn.db.borrow().con, window as ffi::idx_t, &mut ptr) };
+        if r != ffi::DuckDBSuccess {
+            return Err(Error::DuckDBFailure(
+                ffi::Error::new(r),
+                Some("can't create input stream".to_owned()),
+            ));
+        }
+        Ok(InputStream { ptr })
+    }
+
+    fn path(&self) -> &str {
+        unsafe { CStr::from_ptr(ffi::duckdb_input_stream_path(self.ptr)) }
+            .to_str()
+            .unwrap()
+    }
+
+    // Write all the bytes of `reader` and end the stream, or stop early once
+    // the stream is no longer read.
+    fn write_from<R: Read>(&self, mut reader: R, read_size: usize) -> io::Result<()> {
+        let mut buf = vec![0u8; read_size];
+        loop {
+            let len = match reader.read(&mut buf) {
+                Ok(0) => break,
+                Ok(len) => len,
+                Err(err) if err.kind() == io::ErrorKind::Interrupted => continue,
+                Err(err) => {
+                    self.close(Some(&err.to_string()));
+                    return Err(err);
+                }
+            };
+            let r =
+                unsafe { ffi::duckdb_input_stream_write(self.ptr, buf.as_ptr() as *const c_void, len as ffi::idx_t) };
+            if r != ffi::DuckDBSuccess {
+                return Ok(());
+            }
+        }
+        self.close(None);
+        Ok(())
+    }
+
+    fn close(&self, error: Option<&str>) {
+        let c_error = error.map(|error| CString::new(error.replace('\0', "")).unwrap());
+        let error_ptr = c_error.as_ref().map_or(ptr::null(), |error| error.as_ptr());
+        unsafe { ffi::duckdb_input_stream_close(self.ptr, error_ptr) };
+    }
+
+    fn stop(&self) {
+        unsafe { ffi::duckdb_input_stream_stop(self.ptr) };
+    }
+}
+
+impl Drop for InputStream {
+    fn drop(&mut self) {
+        unsafe { ffi::duckdb_input_stream_destroy(&mut self.ptr) };
+    }
+}
+
+struct StopOnDrop<'a>(&'a InputStream);
+
+impl Drop for StopOnDrop<'_> {
+    fn drop(&mut self) {
+        self.0.stop();
+    }
+}
+
+// Send the bytes of `reader` in batches of whole lines of at least
+// `read_size` bytes, but for the last one. Stops early once the batches are no
+// longer received.
+#[cfg(feature = "serde_json")]
+fn read_lines<R: Read>(mut reader: R, read_size: usize, sender: SyncSender<Vec<u8>>) -> io::Result<()> {
+    let mut batch = Vec::with_capacity(read_size);
+    loop {
+        let start = batch.len();
+        batch.resize(start + read_size, 0);
+        let read = reader.read(&mut batch[start..]);
+        batch.truncate(start + *read.as_ref().unwrap_or(&0));
+        match read {
+            Ok(0) => break,
+            Ok(_) => {}
+            Err(err) if err.kind() == io::ErrorKind::Interrupted => continue,
+            Err(err) => return Err(err),
+        }
+        if batch.len() < read_size {
+            continue;
+        }
+        if let Some(end) = memchr::memrchr(b'\n', &batch) {
+            let rest = batch.split_off(end + 1);
+            if sender.send(std::mem::replace(&mut batch, rest)).is_err() {
+                return Ok(());
+            }
+        }
+    }
+    if !batch.is_empty() {
+        let _ = sender.send(batch);
+    }
+    Ok(())
+}
+
+// Append the rows of a batch of lines, counting the lines in `line_number`.
+#[cfg(feature = "serde_json")]
+fn append_ndjson(app: &mut Appender<'_>, names: &[String], batch: &[u8], line_number: &mut usize) -> Result<usize> {
+    let batch = batch.strip_suffix(b"\n").unwrap_or(batch);
+    let mut rows = Vec::new();
+    for line in batch.split(|&b| b == b'\n') {
+        *line_number += 1;
+        let line = line.strip_suffix(b"\r").unwrap_or(line);
+        if line.iter().all(u8::is_ascii_whitespace) {
+            continue;
+        }
+        let mut object = match serde_json::from_slice(line) {
+            Ok(serde_json::Value::Object(object)) => object,
+            Ok(_) => return Err(invalid_line(*line_number, "not a JSON object")),
+            Err(err) => return Err(invalid_line(*line_number, err)),
+        };
+        let row: Vec<Value> = names
+            .iter()
+            .map(|name| object.remove(name).map_or(Value::Null, json_to_value))
+            .collect();
+        rows.push(row);
+    }
+    app.append_rows_borrowed(
+        rows.iter()
+            .map(|row| row.iter().map(ValueRef::from).collect::<Vec<_>>()),
+    )?;
+    Ok(rows.len())
+}
+
+#[cfg(feature = "serde_json")]
+fn json_to_value(value: serde_json::Value) -> Value {
+    match value {
+        serde_json::Value::Null => Value::Null,
+        serde_json::Value::Bool(b) => Value::Boolean(b),
+        serde_json::Value::Number(n) => match (n.as_i64(), n.as_u64()) {
+            (Some(i), _) => Value::BigInt(i),
+            (None, Some(u)) => Value::UBigInt(u),
+            _ => Value::Double(n.as_f64().unwrap_or(f64::NAN)),
+        },
+        serde_json::Value::String(s) => Value::Text(s),
+        nested => Value::Text(nested.to_string()),
+    }
+}
+
+#[cfg(feature = "serde_json")]
+#[cold]
+fn invalid_line<E: std::fmt::Display>(line_number: usize, err: E) -> Error {
+    Error::ReadError(io::Error::new(
+        io::ErrorKind::InvalidData,
+        format!("line {}: {}", line_number, err),
+    ))
+}
+
+#[cfg(test)]
+mod test {
+    use std::io::{self, Read};
+
+    use crate::{Connection, Error, Result, StreamOptions};
+
+    // Fails once `len` bytes of `data` are read.
+    struct FailingReader<'a> {
+        data: &'a [u8],
+        len: usize,
+    }
+
+    impl Read for FailingReader<'_> {
+        fn read(&mut self, buf: &mut [u8]) -> io::Result<usize> {
+            if self.len == 0 {
+                return Err(io::Error::new(io::ErrorKind::BrokenPipe, "pipe closed"));
+            }
+            let len = buf.len().min(self.len).min(self.data.len());
+            buf[..len].copy_from_slice(&self.data[..len]);
+            self.data = &self.data[len..];
+            self.len -= len;
+            Ok(len)
+        }
+    }
+
+    fn csv(rows: i64) -> String {
+        let mut csv = "id,name\n".to_owned();
+        for i in 0..rows {
+            csv.push_str(&format!("{},name {}\n", i, i));
+        }
+        csv
+    }
+
+    #[test]
+    fn test_copy_csv_from_reader() -> Result<()> {
+        let db = Connection::open_in_memory()?;
+        db.execute_batch("CREATE TABLE foo(id INTEGER, name VARCHAR)")?;
+
+        // a small window, for the reader to wait for the parser many times
+        let options = StreamOptions::default().window(4096).read_size(1000);
+        let csv = csv(100_000);
+        let rows = db.copy_csv_from_reader("foo", csv.as_bytes(), "HEADER", options)?;
+        assert_eq!(rows, 100_000);
+
+        let (count, sum): (i64, i64) = db.query_row("SELECT count(*), sum(id)::BIGINT FROM foo", [], |r| {
+            Ok((r.get(0)?, r.get(1)?))
+        })?;
+        assert_eq!(count, 100_000);
+        assert_eq!(sum, (0..100_000).sum::<i64>());
+        let name: String = db.query_row("SELECT name FROM foo WHERE id = 99999", [], |r| r.get(0))?;
+        assert_eq!(name, "name 99999");
+        Ok(())
+    }
+
+    #[test]
+    fn test_read_stream_auto_detect() -> Result<()> {
+        let db = Connection::open_in_memory()?;
+        let csv = csv(1000);
+        db.read_stream(csv.as_bytes(), StreamOptions::default(), |path| {
+            db.execute_batch(&format!("CREATE TABLE foo AS SELECT * FROM read_csv_auto('{}')", path))
+        })?;
+
+        let (count, name): (i64, String) =
+            db.query_row("SELECT count(*), max(name) FILTER (WHERE id = 999) FROM foo", [], |r| {
+                Ok((r.get(0)?, r.get(1)?))
+            })?;
+        assert_eq!(count, 1000);
+        assert_eq!(name, "name 999");
+        Ok(())
+    }
+
+    #[test]
+    fn test_read_stream_errors() -> Result<()> {
+        let db = Connection::open_in_memory()?;
+        db.execute_batch("CREATE TABLE foo(id INTEGER, name VARCHAR)")?;
+
+        // the error of the reader, instead of the one of the query
+        let csv = csv(10_000);
+        let reader = FailingReader {
+            data: csv.as_bytes(),
+            len: 50_000,
+        };
+        match db.copy_csv_from_reader("foo", reader, "HEADER", StreamOptions::default()) {
+            Err(Error::ReadError(err)) => assert_eq!(err.kind(), io::ErrorKind::BrokenPipe),
+            other => panic!("unexpected result {:?}", other),
+        }
+        let count: i64 = db.query_row("SELECT count(*) FROM foo", [], |r| r.get(0))?;
+        assert_eq!(count, 0);
+
+        // the stream is never read, the endless reader stops anyway
+        let options = StreamOptions::default().window(1024);
+        assert!(db.copy_csv_from_reader("bar", io::repeat(b'1'), "", options).is_err());
+
+        // parse errors
+        assert!(db
+            .copy_csv_from_reader("foo", "1,a\nb,2\n".as_bytes(), "", StreamOptions::default())
+            .is_err());
+        Ok(())
+    }
+
+    #[test]
+    #[cfg(feature = "serde_json")]
+    fn test_copy_ndjson_from_reader() -> Result<()> {
+        let db = Connection::open_in_memory()?;
+        db.execute_batch("CREATE TABLE foo(id BIGINT, name VARCHAR, score DOUBLE, tags VARCHAR)")?;
+
+        let mut ndjson = String::new();
+        for i in 0..10_000 {
+            ndjson.push_str(&format!(
+                "{{\"id\": {}, \"name\": \"name {}\", \"score\": {}.5, \"tags\": [{}], \"other\": true}}\r\n",
+                i, i, i, i
+            ));
+        }
+        ndjson.push_str("\n{\"id\": -1}");
+        let options = StreamOptions::default().window(8192).read_size(1000);
+        let rows = db.copy_ndjson_from_reader("foo", ndjson.as_bytes(), options)?;
+        assert_eq!(rows, 10_001);
+
+        let (count, sum): (i64, f64) = db.query_row("SELECT count(*), sum(score) FROM foo WHERE id >= 0", [], |r| {
+            Ok((r.get(0)?, r.get(1)?))
+        })?;
+        assert_eq!(count, 10_000);
+        assert_eq!(sum, (0..10_000).map(|i| i as f64 + 0.5).sum::<f64>());
+        let (name, tags): (Option<String>, String) =
+            db.query_row("SELECT name, tags FROM foo WHERE id = 42", [], |r| {
+                Ok((r.get(0)?, r.get(1)?))
+            })?;
+        assert_eq!(name.as_deref(), Some("name 42"));
+        assert_eq!(tags, "[42]");
+        let name: Option<String> = db.query_row("SELECT name FROM foo WHERE id = -1", [], |r| r.get(0))?;
+        assert_eq!(name, None);
+
+        match db.copy_ndjson_from_reader("foo", "{\"id\": 1}\n[1]\n".as_bytes(), StreamOptions::default()) {
+            Err(Error::ReadError(err)) => assert_eq!(err.to_string(), "line 2: not a JSON object"),
+            other => panic!("unexpected result {:?}", other),
+        }
+        Ok(())
+    }
+}
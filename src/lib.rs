@@ -57,7 +57,7 @@
 
 pub use libduckdb_sys as ffi;
 
-use std::cell::RefCell;
+use std::cell::{Cell, RefCell};
 use std::convert;
 use std::default::Default;
 use std::ffi::CString;
@@ -65,21 +65,28 @@ use std::fmt;
 use std::path::{Path, PathBuf};
 use std::result;
 use std::str;
+use std::sync::atomic::{AtomicU8, Ordering};
+use std::sync::{Arc, Mutex};
 
 use crate::cache::StatementCache;
 use crate::inner_connection::InnerConnection;
 use crate::raw_statement::RawStatement;
 use crate::types::ValueRef;
 
-pub use crate::appender::Appender;
+pub use crate::appender::{Appender, AppenderOptions, FlushStats};
+pub use crate::appender_columns::ColumnSlice;
 pub use crate::appender_params::{appender_params_from_iter, AppenderParams, AppenderParamsFromIter};
 pub use crate::arrow_batch::Arrow;
 pub use crate::cache::CachedStatement;
-pub use crate::column::Column;
+pub use crate::column::{Column, ColumnHandle};
 pub use crate::config::{AccessMode, Config, DefaultNullOrder, DefaultOrder};
+pub use crate::data_chunk::{Chunks, DataChunk, FlatVector, FlatVectorMut, VectorValue};
 pub use crate::error::Error;
 pub use crate::ffi::ErrorCode;
+pub use crate::input_stream::StreamOptions;
+pub use crate::parallel_appender::{LocalAppender, ParallelAppender};
 pub use crate::params::{params_from_iter, Params, ParamsFromIter};
+pub use crate::pending_query::PendingQuery;
 #[cfg(feature = "r2d2")]
 pub use crate::r2d2::DuckdbConnectionManager;
 pub use crate::row::{AndThenRows, Map, MappedRows, Row, RowIndex, Rows};
@@ -90,14 +97,21 @@ pub use crate::types::ToSql;
 #[macro_use]
 mod error;
 mod appender;
+mod appender_columns;
 mod appender_params;
 mod arrow_batch;
+mod arrow_scan;
 mod cache;
 mod column;
 mod config;
+mod data_chunk;
 mod inner_connection;
+mod input_stream;
+mod parallel_appender;
 mod params;
+mod pending_query;
 mod pragma;
+mod prepared_batch;
 #[cfg(feature = "r2d2")]
 mod r2d2;
 mod raw_statement;
@@ -106,6 +120,8 @@ mod statement;
 mod transaction;
 
 pub mod types;
+pub mod vscalar;
+pub mod vtab;
 
 pub(crate) mod util;
 
@@ -200,6 +216,7 @@ pub struct Connection {
     db: RefCell<InnerConnection>,
     cache: StatementCache,
     path: Option<PathBuf>,
+    arrow_batch_size: Cell<Option<usize>>,
 }
 
 unsafe impl Send for Connection {}
@@ -265,6 +282,7 @@ impl Connection {
             db: RefCell::new(db),
             cache: StatementCache::with_capacity(STATEMENT_CACHE_DEFAULT_CAPACITY),
             path: Some(path.as_ref().to_path_buf()),
+            arrow_batch_size: Cell::new(None),
         })
     }
 
@@ -446,6 +464,18 @@ impl Connection {
         self.db.borrow_mut().prepare(self, sql)
     }
 
+    /// Set the maximum number of rows of the Arrow record batches returned by
+    /// [`Statement::query_arrow`] and [`Statement::stream_arrow`] for the
+    /// statements of this connection. By default a batch holds one DuckDB
+    /// vector (1024 rows); larger batches mean fewer, bigger arrays for the
+    /// consumer. A size of 0 is treated as 1.
+    ///
+    /// [`Statement::set_arrow_batch_size`] overrides this for one statement.
+    #[inline]
+    pub fn set_arrow_batch_size(&self, batch_size: usize) {
+        self.arrow_batch_size.set(Some(batch_size.max(1)));
+    }
+
     /// Create an Appender for fast import data
     /// default to use `DatabaseName::Main`
     ///
@@ -484,7 +514,78 @@ impl Connection {
     ///
     /// Will return `Err` if `table` not exists
     pub fn appender_to_db(&self, table: &str, schema: &str) -> Result<Appender<'_>> {
-        self.db.borrow_mut().appender(self, table, schema)
+        self.db
+            .borrow_mut()
+            .appender(self, table, schema, &AppenderOptions::default())
+    }
+
+    /// Create an Appender for fast import data, with control over when it
+    /// flushes
+    /// default to use `DatabaseName::Main`
+    ///
+    /// ## Example
+    ///
+    /// ```rust,no_run
+    /// # use duckdb::{AppenderOptions, Connection, Result};
+    /// fn insert_rows(conn: &Connection) -> Result<()> {
+    ///     let options = AppenderOptions::default()
+    ///         .flush_bytes(64 << 20)
+    ///         .background_flush(true);
+    ///     let mut app = conn.appender_with_options("foo", options)?;
+    ///     for i in 0..10_000_000 {
+    ///         app.append_row([i, i * 2])?;
+    ///     }
+    ///     let stats = app.flush()?;
+    ///     println!("{} rows in {} flushes, {:?}", stats.rows, stats.flushes, stats.duration);
+    ///     Ok(())
+    /// }
+    /// ```
+    ///
+    /// # Failure
+    ///
+    /// Will return `Err` if `table` not exists
+    pub fn appender_with_options(&self, table: &str, options: AppenderOptions) -> Result<Appender<'_>> {
+        self.db
+            .borrow_mut()
+            .appender(self, table, &DatabaseName::Main.to_string(), &options)
+    }
+
+    /// Create a ParallelAppender to import data from many threads at once
+    /// default to use `DatabaseName::Main`
+    ///
+    /// ## Example
+    ///
+    /// ```rust,no_run
+    /// # use duckdb::{Connection, Result};
+    /// # use std::thread;
+    /// fn insert_parts(conn: &Connection, parts: Vec<Vec<i64>>) -> Result<()> {
+    ///     let parallel = conn.parallel_appender("foo")?;
+    ///     thread::scope(|s| -> Result<()> {
+    ///         let mut handles = Vec::new();
+    ///         for part in &parts {
+    ///             let mut app = parallel.appender()?;
+    ///             handles.push(s.spawn(move || app.append_columns(&[part])));
+    ///         }
+    ///         handles.into_iter().try_for_each(|h| h.join().unwrap())
+    ///     })?;
+    ///     parallel.commit()
+    /// }
+    /// ```
+    ///
+    /// # Failure
+    ///
+    /// Will return `Err` if `table` not exists
+    pub fn parallel_appender(&self, table: &str) -> Result<ParallelAppender<'_>> {
+        self.parallel_appender_to_db(table, &DatabaseName::Main.to_string())
+    }
+
+    /// Create a ParallelAppender to import data from many threads at once
+    ///
+    /// # Failure
+    ///
+    /// Will return `Err` if `table` not exists
+    pub fn parallel_appender_to_db(&self, table: &str, schema: &str) -> Result<ParallelAppender<'_>> {
+        self.db.borrow_mut().parallel_appender(self, table, schema)
     }
 
     /// Close the DuckDB connection.
@@ -516,8 +617,95 @@ impl Connection {
             db: RefCell::new(inner),
             cache: StatementCache::with_capacity(STATEMENT_CACHE_DEFAULT_CAPACITY),
             path: self.path.clone(),
+            arrow_batch_size: self.arrow_batch_size.clone(),
         })
     }
+
+    /// Get access to a handle that can be used to interrupt long running
+    /// queries from another thread.
+    #[inline]
+    pub fn get_interrupt_handle(&self) -> InterruptHandle {
+        self.db.borrow().get_interrupt_handle()
+    }
+}
+
+/// Allows interrupting a long-running query, see
+/// [`Connection::get_interrupt_handle`].
+#[derive(Clone, Debug)]
+pub struct InterruptHandle {
+    conn_lock: Arc<Mutex<ffi::duckdb_connection>>,
+    // whether the connection tracks the progress of its queries, see
+    // `request_progress`
+    progress: Arc<AtomicU8>,
+}
+
+// Tracking the progress costs every query of the connection, so it is only
+// enabled once it is asked for: the connection enables it on its own thread
+// before its next query.
+const PROGRESS_OFF: u8 = 0;
+const PROGRESS_REQUESTED: u8 = 1;
+const PROGRESS_ON: u8 = 2;
+
+unsafe impl Send for InterruptHandle {}
+unsafe impl Sync for InterruptHandle {}
+
+impl InterruptHandle {
+    /// Interrupt the query currently executing on another thread. This will
+    /// cause that query to fail with an `ErrorCode::OperationInterrupted`
+    /// error, and does nothing if the connection is idle or closed.
+    pub fn interrupt(&self) {
+        let conn = self.conn_lock.lock().unwrap();
+        if !conn.is_null() {
+            unsafe { ffi::duckdb_interrupt(*conn) }
+        }
+    }
+
+    /// The progress of the query currently executing on another thread, as a
+    /// percentage between 0 and 100, or of the last query once it finished.
+    ///
+    /// The progress is estimated from how far the query has read its sources,
+    /// so it is coarse for queries that do most of their work after reading
+    /// them (e.g. a large sort). The connection only tracks the progress once
+    /// asked for it: the first call enables the tracking for the queries the
+    /// connection starts after it, and returns `None` until then. Also returns
+    /// `None` if the connection is closed.
+    pub fn query_progress(&self) -> Option<f64> {
+        if self.progress.load(Ordering::Acquire) != PROGRESS_ON {
+            self.request_progress();
+            return None;
+        }
+        let conn = self.conn_lock.lock().unwrap();
+        if conn.is_null() {
+            return None;
+        }
+        let progress = unsafe { ffi::duckdb_query_progress(*conn) };
+        if progress < 0.0 {
+            None
+        } else {
+            Some(progress)
+        }
+    }
+
+    // Ask the connection to track the progress of its next queries.
+    #[inline]
+    pub(crate) fn request_progress(&self) {
+        let _ = self
+            .progress
+            .compare_exchange(PROGRESS_OFF, PROGRESS_REQUESTED, Ordering::Relaxed, Ordering::Relaxed);
+    }
+
+    // Enable the progress tracking if it was requested, on the thread of the
+    // connection before it starts a query.
+    pub(crate) fn enable_requested_progress(&self) {
+        if self.progress.load(Ordering::Relaxed) != PROGRESS_REQUESTED {
+            return;
+        }
+        let conn = self.conn_lock.lock().unwrap();
+        if !conn.is_null() {
+            unsafe { ffi::duckdb_enable_query_progress(*conn) };
+            self.progress.store(PROGRESS_ON, Ordering::Release);
+        }
+    }
 }
 
 impl fmt::Debug for Connection {
@@ -1254,6 +1442,164 @@ mod test {
         Ok(())
     }
 
+    #[test]
+    fn test_query_arrow_error() -> Result<()> {
+        let db = checked_memory_handle();
+        db.execute_batch("PRAGMA threads=1")?;
+        // the cast only fails once the first vectors are streamed
+        let sql = "SELECT (CASE WHEN i < 10000 THEN '1' ELSE 'x' END)::INTEGER AS v FROM range(0, 20000) t(i)";
+        let mut stmt = db.prepare(sql)?;
+        let mut arrow = stmt.query_arrow([])?;
+        let rows: usize = arrow.by_ref().map(|rb| rb.num_rows()).sum();
+        assert!(rows > 0 && rows < 20000);
+        assert!(arrow.take_error().is_some());
+        assert!(arrow.next().is_none());
+
+        let mut arrow = stmt.query_arrow([])?;
+        let mut rows = 0;
+        let result = loop {
+            match arrow.try_next() {
+                Ok(Some(rb)) => rows += rb.num_rows(),
+                Ok(None) => break Ok(rows),
+                Err(err) => break Err(err),
+            }
+        };
+        assert!(result.is_err());
+        assert!(rows > 0 && rows < 20000);
+        Ok(())
+    }
+
+    const SLOW_QUERY: &str = "SELECT sum(a.i * b.i) FROM range(0, 1000000) a(i), range(0, 1000000) b(i)";
+
+    fn assert_interrupted<T: fmt::Debug>(result: Result<T>) {
+        match result.unwrap_err() {
+            Error::DuckDBFailure(err, _) => assert_eq!(err.code, ErrorCode::OperationInterrupted),
+            err => panic!("Unexpected error: {}", err),
+        }
+    }
+
+    #[test]
+    fn test_interrupt() -> Result<()> {
+        use std::time::Duration;
+
+        let db = checked_memory_handle();
+        let handle = db.get_interrupt_handle();
+        let interrupter = std::thread::spawn(move || {
+            std::thread::sleep(Duration::from_millis(100));
+            handle.interrupt();
+        });
+        assert_interrupted(db.query_row(SLOW_QUERY, [], |r| r.get::<_, i128>(0)));
+        interrupter.join().unwrap();
+        // the connection is free to run the next query
+        assert_eq!(db.query_row("SELECT 42", [], |r| r.get::<_, i32>(0))?, 42);
+
+        // interrupting a closed connection does nothing
+        let handle = db.get_interrupt_handle();
+        db.close().unwrap();
+        handle.interrupt();
+        Ok(())
+    }
+
+    #[test]
+    fn test_statement_timeout() -> Result<()> {
+        use std::time::Duration;
+
+        let db = checked_memory_handle();
+        let mut stmt = db.prepare(SLOW_QUERY)?;
+        stmt.set_timeout(Some(Duration::from_millis(100)));
+        assert_interrupted(stmt.query_row([], |r| r.get::<_, i128>(0)));
+
+        // a fast query is not affected by its timeout
+        let mut stmt = db.prepare("SELECT count(*) FROM range(0, 1000) t(i)")?;
+        stmt.set_timeout(Some(Duration::from_secs(60)));
+        assert_eq!(stmt.query_row([], |r| r.get::<_, i64>(0))?, 1000);
+        Ok(())
+    }
+
+    #[test]
+    fn test_statement_timeout_arrow() -> Result<()> {
+        use std::time::Duration;
+
+        // streamed, so the query runs while its batches are fetched
+        let db = checked_memory_handle();
+        let mut stmt = db.prepare("SELECT i FROM range(0, 1000000000) t(i)")?;
+        stmt.set_timeout(Some(Duration::from_millis(100)));
+        let mut arrow = stmt.query_arrow([])?;
+        let rows: usize = arrow.by_ref().map(|rb| rb.num_rows()).sum();
+        assert!(rows < 1000000000);
+        assert_interrupted(arrow.take_error().map_or(Ok(rows), Err));
+
+        let mut arrow = stmt.query_arrow([])?;
+        assert_interrupted((|| -> Result<()> {
+            while arrow.try_next()?.is_some() {}
+            Ok(())
+        })());
+        Ok(())
+    }
+
+    #[test]
+    fn test_progress_handler() -> Result<()> {
+        use std::cell::RefCell;
+        use std::rc::Rc;
+
+        let db = checked_memory_handle();
+        let reported = Rc::new(RefCell::new(Vec::new()));
+        let mut stmt = db.prepare(SLOW_QUERY)?;
+        let handler_reported = Rc::clone(&reported);
+        stmt.set_progress_handler(Some(move |progress: f64| {
+            let mut reported = handler_reported.borrow_mut();
+            reported.push(progress);
+            // give up once the query is estimated to take a while
+            progress > 0.0 || reported.len() >= 1000
+        }));
+        assert_interrupted(stmt.query_row([], |r| r.get::<_, i128>(0)));
+        let reported = reported.borrow();
+        assert!(!reported.is_empty());
+        assert!(reported.iter().all(|p| (0.0..=100.0).contains(p)));
+        assert!(reported.windows(2).all(|w| w[0] <= w[1]));
+
+        // without a handler the statement runs as before
+        let mut stmt = db.prepare("SELECT count(*) FROM range(0, 1000) t(i)")?;
+        stmt.set_progress_handler(None::<fn(f64) -> bool>);
+        assert_eq!(stmt.query_row([], |r| r.get::<_, i64>(0))?, 1000);
+        Ok(())
+    }
+
+    #[test]
+    fn test_query_progress() -> Result<()> {
+        let db = Connection::open_in_memory()?;
+        let handle = db.get_interrupt_handle();
+        // the progress is only tracked once asked for, from the next query on
+        assert_eq!(handle.query_progress(), None);
+        db.query_row("SELECT count(*) FROM range(0, 100000) t(i)", [], |r| r.get::<_, i64>(0))?;
+        let progress = handle.query_progress().unwrap();
+        assert!((0.0..=100.0).contains(&progress));
+        db.close().unwrap();
+        assert_eq!(handle.query_progress(), None);
+        Ok(())
+    }
+
+    #[test]
+    fn test_query_arrow_batch_size() -> Result<()> {
+        let db = checked_memory_handle();
+        let sql = "SELECT i FROM range(0, 10000) t(i)";
+
+        db.set_arrow_batch_size(4096);
+        let rbs: Vec<RecordBatch> = db.prepare(sql)?.query_arrow([])?.collect();
+        assert_eq!(
+            rbs.iter().map(|rb| rb.num_rows()).collect::<Vec<_>>(),
+            vec![4096, 4096, 1808]
+        );
+
+        let mut stmt = db.prepare(sql)?;
+        stmt.set_arrow_batch_size(10000);
+        let rbs: Vec<RecordBatch> = stmt.query_arrow([])?.collect();
+        assert_eq!(rbs.len(), 1);
+        assert_eq!(rbs[0].num_rows(), 10000);
+        assert_eq!(stmt.stream_arrow([])?.count(), 1);
+        Ok(())
+    }
+
     #[test]
     fn test_database_name_to_string() -> Result<()> {
         assert_eq!(DatabaseName::Main.to_string(), "main");
@@ -0,0 +1,226 @@
+use std::fmt;
+use std::marker::PhantomData;
+use std::ptr;
+
+use super::ffi;
+use super::{AppenderParams, ColumnSlice, Connection, Result, ValueRef};
+use crate::appender::RawAppender;
+use crate::error::{result_from_duckdb_appender, result_from_duckdb_parallel_appender};
+
+use arrow::record_batch::RecordBatch;
+
+/// Appender filled by many threads at once, see
+/// [`Connection::parallel_appender`].
+///
+/// Every thread appends to its own [`LocalAppender`], which buffers the rows
+/// without taking any lock of the table. [`commit`](ParallelAppender::commit)
+/// then appends the rows of all of them to the table at once, so the rows are
+/// buffered in memory until then.
+pub struct ParallelAppender<'conn> {
+    conn: &'conn Connection,
+    ptr: ffi::duckdb_parallel_appender,
+}
+
+impl<'conn> ParallelAppender<'conn> {
+    #[inline]
+    pub(crate) fn new(conn: &'conn Connection, ptr: ffi::duckdb_parallel_appender) -> ParallelAppender<'conn> {
+        ParallelAppender { conn, ptr }
+    }
+
+    /// Create a local appender, to be moved to the thread that fills it
+    ///
+    /// # Failure
+    ///
+    /// Will return `Err` if the table no longer exists
+    pub fn appender(&self) -> Result<LocalAppender<'_>> {
+        let mut c_app: ffi::duckdb_appender = ptr::null_mut();
+        let r = unsafe { ffi::duckdb_parallel_appender_local(self.ptr, &mut c_app) };
+        result_from_duckdb_appender(r, c_app)?;
+        Ok(LocalAppender {
+            raw: RawAppender::new(c_app),
+            _parallel: PhantomData,
+        })
+    }
+
+    /// Append the rows of all local appenders to the table, in a single
+    /// append
+    ///
+    /// The local appenders borrow the parallel appender, so they all have
+    /// been dropped, and their rows flushed, by now. Without a transaction
+    /// started on the connection, the rows are committed in a transaction of
+    /// their own.
+    ///
+    /// ## Example
+    ///
+    /// ```rust,no_run
+    /// # use duckdb::{Connection, Result};
+    /// # use std::thread;
+    /// fn insert_parts(conn: &Connection, parts: Vec<Vec<i64>>) -> Result<()> {
+    ///     let parallel = conn.parallel_appender("foo")?;
+    ///     thread::scope(|s| -> Result<()> {
+    ///         let mut handles = Vec::new();
+    ///         for part in &parts {
+    ///             let mut app = parallel.appender()?;
+    ///             handles.push(s.spawn(move || app.append_columns(&[part])));
+    ///         }
+    ///         handles.into_iter().try_for_each(|h| h.join().unwrap())
+    ///     })?;
+    ///     parallel.commit()
+    /// }
+    /// ```
+    ///
+    /// # Failure
+    ///
+    /// Will return `Err` if the rows can't be appended to the table, e.g. if
+    /// they violate a constraint, in which case none of them are
+    pub fn commit(self) -> Result<()> {
+        let r = unsafe { ffi::duckdb_parallel_appender_commit(self.ptr) };
+        result_from_duckdb_parallel_appender(r, self.ptr)
+    }
+}
+
+impl Drop for ParallelAppender<'_> {
+    fn drop(&mut self) {
+        unsafe { ffi::duckdb_parallel_appender_destroy(&mut self.ptr) };
+    }
+}
+
+impl fmt::Debug for ParallelAppender<'_> {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        f.debug_struct("ParallelAppender").field("conn", self.conn).finish()
+    }
+}
+
+/// Appender of one thread of a [`ParallelAppender`]
+///
+/// It appends like an [`Appender`](crate::Appender), but its rows only reach
+/// the table once the parallel appender is committed. Dropping it flushes the
+/// rows it still buffers to the parallel appender.
+pub struct LocalAppender<'p> {
+    raw: RawAppender,
+    // the handle is only ever used by the thread owning the local appender
+    _parallel: PhantomData<&'p ()>,
+}
+
+unsafe impl Send for LocalAppender<'_> {}
+
+impl LocalAppender<'_> {
+    /// Append multiple rows from Iterator, see
+    /// [`Appender::append_rows`](crate::Appender::append_rows)
+    #[inline]
+    pub fn append_rows<P, I>(&mut self, rows: I) -> Result<()>
+    where
+        I: IntoIterator<Item = P>,
+        P: AppenderParams,
+    {
+        for row in rows {
+            self.append_row(row)?;
+        }
+        Ok(())
+    }
+
+    /// Append one row, see
+    /// [`Appender::append_row`](crate::Appender::append_row)
+    #[inline]
+    pub fn append_row<P: AppenderParams>(&mut self, params: P) -> Result<()> {
+        self.raw.append_row(params)
+    }
+
+    /// Append multiple rows of values without copying their strings and
+    /// blobs, see
+    /// [`Appender::append_rows_borrowed`](crate::Appender::append_rows_borrowed)
+    #[inline]
+    pub fn append_rows_borrowed<'buf, I, R>(&mut self, rows: I) -> Result<()>
+    where
+        I: IntoIterator<Item = R>,
+        R: AsRef<[ValueRef<'buf>]>,
+    {
+        self.raw.append_rows_borrowed(rows)
+    }
+
+    /// Append whole columns at once, see
+    /// [`Appender::append_columns`](crate::Appender::append_columns)
+    #[inline]
+    pub fn append_columns(&mut self, columns: &[&dyn ColumnSlice]) -> Result<()> {
+        self.raw.append_columns(columns)
+    }
+
+    /// Append the rows of an Arrow record batch, see
+    /// [`Appender::append_record_batch`](crate::Appender::append_record_batch)
+    #[inline]
+    pub fn append_record_batch(&mut self, record_batch: &RecordBatch) -> Result<()> {
+        self.raw.append_record_batch(record_batch)
+    }
+
+    /// Hand the buffered rows over to the parallel appender
+    #[inline]
+    pub fn flush(&mut self) -> Result<()> {
+        self.raw.flush().map(|_| ())
+    }
+}
+
+impl fmt::Debug for LocalAppender<'_> {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        f.debug_struct("LocalAppender").finish()
+    }
+}
+
+#[cfg(test)]
+mod test {
+    use std::thread;
+
+    use crate::{params, Connection, Result};
+
+    #[test]
+    fn test_parallel_appender() -> Result<()> {
+        let db = Connection::open_in_memory()?;
+        db.execute_batch("CREATE TABLE foo(id BIGINT, name VARCHAR)")?;
+
+        let parts: Vec<Vec<i64>> = (0..4).map(|p| (p * 10000..(p + 1) * 10000).collect()).collect();
+        let parallel = db.parallel_appender("foo")?;
+        thread::scope(|s| -> Result<()> {
+            let mut handles = Vec::new();
+            for part in &parts {
+                let mut app = parallel.appender()?;
+                handles.push(s.spawn(move || -> Result<()> {
+                    let names: Vec<String> = part.iter().map(|id| format!("name {}", id)).collect();
+                    app.append_columns(&[part, &names])?;
+                    app.append_row(params![-1 - part[0], "row"])
+                }));
+            }
+            handles.into_iter().try_for_each(|handle| handle.join().unwrap())
+        })?;
+
+        // nothing reaches the table before the commit
+        let count: i64 = db.query_row("SELECT count(*) FROM foo", [], |r| r.get(0))?;
+        assert_eq!(count, 0);
+        parallel.commit()?;
+
+        let (count, sum): (i64, i64) =
+            db.query_row("SELECT count(*), sum(id)::BIGINT FROM foo WHERE id >= 0", [], |r| {
+                Ok((r.get(0)?, r.get(1)?))
+            })?;
+        assert_eq!(count, 40000);
+        assert_eq!(sum, (0..40000).sum::<i64>());
+        let rows: i64 = db.query_row("SELECT count(*) FROM foo WHERE name = 'row'", [], |r| r.get(0))?;
+        assert_eq!(rows, 4);
+        Ok(())
+    }
+
+    #[test]
+    fn test_parallel_appender_discard() -> Result<()> {
+        let db = Connection::open_in_memory()?;
+        db.execute_batch("CREATE TABLE foo(x INTEGER)")?;
+        assert!(db.parallel_appender("bar").is_err());
+
+        {
+            let parallel = db.parallel_appender("foo")?;
+            let mut app = parallel.appender()?;
+            app.append_row([1])?;
+            // dropped without committing
+        }
+        let count: i64 = db.query_row("SELECT count(*) FROM foo", [], |r| r.get(0))?;
+        assert_eq!(count, 0);
+        Ok(())
+    }
+}
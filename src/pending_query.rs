@@ -0,0 +1,221 @@
+use std::future::Future;
+use std::pin::Pin;
+use std::sync::mpsc::{self, Sender};
+use std::task::{Context, Poll, Waker};
+use std::thread;
+use std::time::{Duration, Instant};
+
+use super::{Error, Result, Rows, Statement};
+
+/// A query that runs while it is polled, see
+/// [`Statement::query_async`](Statement::query_async).
+///
+/// Every poll runs a single DuckDB task of the query, then yields back to the
+/// executor, so that many queries can share a few threads without any of
+/// them blocking the others for long.
+///
+/// A task that returns at once means the query is waiting on DuckDB's own
+/// threads; rather than being polled again straight away, the future then
+/// backs off, waking itself from a helper thread after a delay that doubles
+/// up to 5 ms and resets as soon as a task does some work.
+#[must_use = "futures do nothing unless you `.await` or poll them"]
+pub struct PendingQuery<'stmt, 'conn> {
+    stmt: Option<&'stmt mut Statement<'conn>>,
+    error: Option<Error>,
+    backoff: Backoff,
+}
+
+/// A task running at least this long did some work, so the query is polled
+/// again right away.
+const BUSY_TASK: Duration = Duration::from_micros(100);
+const MIN_BACKOFF: Duration = Duration::from_micros(50);
+/// The longest a waiting query sleeps between two polls, which is also the
+/// most its result can be delayed by backing off.
+const MAX_BACKOFF: Duration = Duration::from_millis(5);
+
+/// Wakes a pending query after a delay. The helper thread is only started
+/// the first time the query has to wait, and exits once the query is done.
+#[derive(Default)]
+struct Backoff {
+    delay: Duration,
+    timer: Option<Sender<(Duration, Waker)>>,
+}
+
+impl Backoff {
+    fn wake(&mut self, waker: &Waker, task_time: Duration) {
+        self.delay = if task_time >= BUSY_TASK {
+            Duration::ZERO
+        } else {
+            (self.delay * 2).clamp(MIN_BACKOFF, MAX_BACKOFF)
+        };
+        if self.delay.is_zero() {
+            waker.wake_by_ref();
+            return;
+        }
+        if self.timer.is_none() {
+            let (sender, receiver) = mpsc::channel::<(Duration, Waker)>();
+            let spawned = thread::Builder::new()
+                .name("duckdb-pending-query".to_owned())
+                .spawn(move || {
+                    for (delay, waker) in receiver {
+                        thread::sleep(delay);
+                        waker.wake();
+                    }
+                });
+            if spawned.is_ok() {
+                self.timer = Some(sender);
+            }
+        }
+        let sent = match self.timer {
+            Some(ref timer) => timer.send((self.delay, waker.clone())).is_ok(),
+            None => false,
+        };
+        if !sent {
+            // no helper thread: fall back to being polled again right away
+            waker.wake_by_ref();
+        }
+    }
+}
+
+impl<'stmt, 'conn> PendingQuery<'stmt, 'conn> {
+    #[inline]
+    pub(crate) fn new(stmt: &'stmt mut Statement<'conn>) -> PendingQuery<'stmt, 'conn> {
+        PendingQuery {
+            stmt: Some(stmt),
+            error: None,
+            backoff: Backoff::default(),
+        }
+    }
+
+    #[inline]
+    pub(crate) fn failed(error: Error) -> PendingQuery<'stmt, 'conn> {
+        PendingQuery {
+            stmt: None,
+            error: Some(error),
+            backoff: Backoff::default(),
+        }
+    }
+}
+
+impl<'stmt, 'conn> Future for PendingQuery<'stmt, 'conn> {
+    type Output = Result<Rows<'stmt>>;
+
+    fn poll(mut self: Pin<&mut Self>, cx: &mut Context<'_>) -> Poll<Self::Output> {
+        if let Some(error) = self.error.take() {
+            return Poll::Ready(Err(error));
+        }
+        let stmt = self.stmt.as_mut().expect("PendingQuery polled after completion");
+        let started = Instant::now();
+        match stmt.stmt.execute_task() {
+            Ok(false) => {
+                // there is more to run: yield, but ask to be polled again
+                self.backoff.wake(cx.waker(), started.elapsed());
+                Poll::Pending
+            }
+            Ok(true) => {
+                let stmt = self.stmt.take().unwrap();
+                if let Err(error) = stmt.stmt.finish_pending(None) {
+                    return Poll::Ready(Err(error));
+                }
+                Poll::Ready(Ok(Rows::new(stmt)))
+            }
+            Err(error) => {
+                self.stmt = None;
+                Poll::Ready(Err(error))
+            }
+        }
+    }
+}
+
+#[cfg(test)]
+mod test {
+    use std::future::Future;
+    use std::pin::Pin;
+    use std::ptr;
+    use std::task::{Context, Poll, RawWaker, RawWakerVTable, Waker};
+    use std::time::Duration;
+
+    use super::{Backoff, BUSY_TASK, MAX_BACKOFF, MIN_BACKOFF};
+    use crate::{Connection, Result};
+
+    fn noop_waker() -> Waker {
+        fn clone(_: *const ()) -> RawWaker {
+            RawWaker::new(ptr::null(), &VTABLE)
+        }
+        fn noop(_: *const ()) {}
+        static VTABLE: RawWakerVTable = RawWakerVTable::new(clone, noop, noop, noop);
+        unsafe { Waker::from_raw(RawWaker::new(ptr::null(), &VTABLE)) }
+    }
+
+    // Poll the futures round robin on this thread, returning their results and
+    // the number of polls.
+    fn run_all<F: Future + Unpin>(mut futures: Vec<F>) -> (Vec<F::Output>, usize) {
+        let waker = noop_waker();
+        let mut cx = Context::from_waker(&waker);
+        let mut outputs: Vec<Option<F::Output>> = futures.iter().map(|_| None).collect();
+        let mut polls = 0;
+        while outputs.iter().any(Option::is_none) {
+            for (future, output) in futures.iter_mut().zip(outputs.iter_mut()) {
+                if output.is_none() {
+                    polls += 1;
+                    if let Poll::Ready(value) = Pin::new(future).poll(&mut cx) {
+                        *output = Some(value);
+                    }
+                }
+            }
+        }
+        (outputs.into_iter().map(Option::unwrap).collect(), polls)
+    }
+
+    #[test]
+    fn test_query_async() -> Result<()> {
+        let db1 = Connection::open_in_memory()?;
+        let db2 = Connection::open_in_memory()?;
+        let mut stmt1 = db1.prepare("SELECT sum(i) FROM range(0, 10000000) t(i)")?;
+        let mut stmt2 = db2.prepare("SELECT count(*) FROM range(0, ?) t(i)")?;
+
+        let (results, polls) = run_all(vec![stmt1.query_async([]), stmt2.query_async([1000])]);
+        assert!(polls >= 2);
+        let mut sums = Vec::new();
+        for rows in results {
+            let mut rows = rows?;
+            sums.push(rows.next()?.unwrap().get::<_, i128>(0)?);
+        }
+        assert_eq!(sums, vec![49999995000000, 1000]);
+        Ok(())
+    }
+
+    #[test]
+    fn test_backoff() {
+        let waker = noop_waker();
+        let mut backoff = Backoff::default();
+        backoff.wake(&waker, Duration::ZERO);
+        assert_eq!(backoff.delay, MIN_BACKOFF);
+        backoff.wake(&waker, Duration::ZERO);
+        assert_eq!(backoff.delay, MIN_BACKOFF * 2);
+        for _ in 0..20 {
+            backoff.wake(&waker, Duration::ZERO);
+        }
+        assert_eq!(backoff.delay, MAX_BACKOFF);
+        backoff.wake(&waker, BUSY_TASK);
+        assert_eq!(backoff.delay, Duration::ZERO);
+    }
+
+    #[test]
+    fn test_query_async_error() -> Result<()> {
+        let db = Connection::open_in_memory()?;
+        let mut stmt = db.prepare("SELECT CAST(? AS INTEGER)")?;
+        let (mut results, _) = run_all(vec![stmt.query_async(["not a number"])]);
+        assert!(results.pop().unwrap().is_err());
+
+        // binding errors are reported by the future too
+        let (mut results, polls) = run_all(vec![stmt.query_async([1, 2])]);
+        assert!(results.pop().unwrap().is_err());
+        assert_eq!(polls, 1);
+
+        let (mut results, _) = run_all(vec![stmt.query_async(["42"])]);
+        let mut rows = results.pop().unwrap()?;
+        assert_eq!(rows.next()?.unwrap().get::<_, i32>(0)?, 42);
+        Ok(())
+    }
+}
@@ -0,0 +1,76 @@
+use std::ptr;
+
+use super::ffi;
+use super::{Error, Result};
+use crate::appender::export_record_batch;
+use crate::appender_columns::{ColumnChunk, ColumnSlice};
+use crate::error::result_from_duckdb_prepared_batch;
+
+use arrow::ffi::{FFI_ArrowArray, FFI_ArrowSchema};
+use arrow::record_batch::RecordBatch;
+
+/// Rows of parameters of a prepared statement, executed at once by
+/// [`Statement::execute_columns`](crate::Statement::execute_columns) and
+/// [`Statement::execute_record_batch`](crate::Statement::execute_record_batch).
+pub(crate) struct PreparedBatch {
+    ptr: ffi::duckdb_prepared_batch,
+}
+
+impl PreparedBatch {
+    /// A batch for the parameters of `stmt`, which must outlive it.
+    pub(crate) unsafe fn new(stmt: ffi::duckdb_prepared_statement) -> Result<PreparedBatch> {
+        let mut c_batch: ffi::duckdb_prepared_batch = ptr::null_mut();
+        let r = ffi::duckdb_prepared_batch_create(stmt, &mut c_batch);
+        // destroyed on drop even if the creation failed
+        let batch = PreparedBatch { ptr: c_batch };
+        result_from_duckdb_prepared_batch(r, batch.ptr)?;
+        Ok(batch)
+    }
+
+    /// Append `len` rows of `columns`, one column per parameter, a vector
+    /// size at a time.
+    pub(crate) fn append_columns(&mut self, columns: &[&dyn ColumnSlice], len: usize) -> Result<()> {
+        let vector_size = unsafe { ffi::duckdb_vector_size() as usize };
+        let mut chunk = unsafe { ColumnChunk::for_columns(columns) };
+        for start in (0..len).step_by(vector_size) {
+            let rows = start..len.min(start + vector_size);
+            if let Err(idx) = unsafe { chunk.fill(columns, rows) } {
+                return Err(Error::DuckDBFailure(
+                    ffi::Error::new(ffi::DuckDBError),
+                    Some(format!("column {} can't be bound as a parameter", idx)),
+                ));
+            }
+            let r = unsafe { ffi::duckdb_prepared_batch_append_data_chunk(self.ptr, chunk.ptr()) };
+            result_from_duckdb_prepared_batch(r, self.ptr)?;
+        }
+        Ok(())
+    }
+
+    /// Append the rows of `record_batch`, one column per parameter.
+    pub(crate) fn append_record_batch(&mut self, record_batch: &RecordBatch) -> Result<()> {
+        let (schema, array) = export_record_batch(record_batch)?;
+        let r = unsafe {
+            ffi::duckdb_prepared_batch_append_arrow_array(
+                self.ptr,
+                &schema as *const FFI_ArrowSchema as ffi::duckdb_arrow_schema,
+                &array as *const FFI_ArrowArray as ffi::duckdb_arrow_array,
+            )
+        };
+        result_from_duckdb_prepared_batch(r, self.ptr)
+    }
+
+    /// Execute the statement for every row, returning the number of rows
+    /// changed.
+    pub(crate) fn execute(&mut self) -> Result<usize> {
+        let mut rows_changed = 0;
+        let r = unsafe { ffi::duckdb_prepared_batch_execute(self.ptr, &mut rows_changed) };
+        result_from_duckdb_prepared_batch(r, self.ptr)?;
+        Ok(rows_changed as usize)
+    }
+}
+
+impl Drop for PreparedBatch {
+    fn drop(&mut self) {
+        unsafe { ffi::duckdb_prepared_batch_destroy(&mut self.ptr) };
+    }
+}
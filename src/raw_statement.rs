@@ -1,24 +1,46 @@
 use std::convert::TryFrom;
 use std::ffi::CStr;
-use std::os::raw::c_void;
-use std::ptr;
+use std::fmt;
 use std::sync::Arc;
+use std::time::{Duration, Instant};
+use std::{mem, ptr};
 
 use super::ffi;
-use super::Result;
-use crate::error::result_from_duckdb_arrow;
+use super::{Error, InterruptHandle, Result};
+use crate::column::ColumnIndex;
+use crate::error::{
+    error_from_duckdb_code, error_timed_out, result_from_duckdb_arrow_stream, result_from_duckdb_pending,
+    result_from_duckdb_result,
+};
 
 use arrow::array::{ArrayData, StructArray};
 use arrow::datatypes::{DataType, Schema, SchemaRef};
 use arrow::ffi::{ArrowArray, FFI_ArrowArray, FFI_ArrowSchema};
+use arrow::ffi_stream::{ArrowArrayStreamReader, FFI_ArrowArrayStream};
 
 // Private newtype for raw sqlite3_stmts that finalize themselves when dropped.
 // TODO: destroy statement and result
 #[derive(Debug)]
 pub struct RawStatement {
     ptr: ffi::duckdb_prepared_statement,
-    result: Option<ffi::duckdb_arrow>,
+    result: Option<ffi::duckdb_arrow_stream>,
+    // Query started by `start_pending` that did not produce `result` yet.
+    pending: Option<ffi::duckdb_pending_result>,
     schema: Option<SchemaRef>,
+    // Case-insensitive index of the column names of `schema`.
+    column_index: Option<ColumnIndex>,
+    // Maximum number of rows of the arrow batches, None for one vector.
+    arrow_batch_size: Option<usize>,
+    // Interrupts the queries of the connection once `deadline` has passed.
+    interrupt: Option<InterruptHandle>,
+    timeout: Option<Duration>,
+    // Deadline of the running query, cleared once it no longer runs.
+    deadline: Option<Instant>,
+    // Called between the tasks of the query with its progress, returning
+    // true interrupts it.
+    progress_handler: Option<ProgressHandler>,
+    // Whether the current result (or pending query) is streaming.
+    streaming: bool,
     // Cached SQL (trimmed) that we use as the key when we're in the statement
     // cache. This is None for statements which didn't come from the statement
     // cache.
@@ -38,7 +60,15 @@ impl RawStatement {
         RawStatement {
             ptr: stmt,
             result: None,
+            pending: None,
             schema: None,
+            column_index: None,
+            arrow_batch_size: None,
+            interrupt: None,
+            timeout: None,
+            deadline: None,
+            progress_handler: None,
+            streaming: false,
             statement_cache_key: None,
         }
     }
@@ -63,56 +93,98 @@ impl RawStatement {
         self.statement_cache_key.clone()
     }
 
+    #[inline]
+    pub(crate) fn set_arrow_batch_size(&mut self, batch_size: usize) {
+        self.arrow_batch_size = Some(batch_size.max(1));
+    }
+
+    #[inline]
+    pub(crate) fn arrow_batch_size(&self) -> Option<usize> {
+        self.arrow_batch_size
+    }
+
+    #[inline]
+    pub(crate) fn set_interrupt_handle(&mut self, interrupt: InterruptHandle) {
+        self.interrupt = Some(interrupt);
+    }
+
+    #[inline]
+    pub(crate) fn set_timeout(&mut self, timeout: Option<Duration>) {
+        self.timeout = timeout;
+    }
+
+    #[inline]
+    pub(crate) fn set_progress_handler(&mut self, handler: Option<Box<dyn FnMut(f64) -> bool>>) {
+        if let (Some(_), Some(interrupt)) = (handler.as_ref(), self.interrupt.as_ref()) {
+            interrupt.request_progress();
+        }
+        self.progress_handler = handler.map(ProgressHandler);
+    }
+
+    #[inline]
+    fn deadline_passed(&self) -> bool {
+        matches!(self.deadline, Some(deadline) if Instant::now() >= deadline)
+    }
+
     #[inline]
     pub fn clear_bindings(&self) -> ffi::duckdb_state {
         unsafe { ffi::duckdb_clear_bindings(self.ptr) }
     }
 
     #[inline]
-    pub fn result_unwrap(&self) -> ffi::duckdb_arrow {
+    pub fn result_unwrap(&self) -> ffi::duckdb_arrow_stream {
         self.result.unwrap()
     }
 
+    /// Number of rows of a materialized result, or the number of rows fetched
+    /// so far for a streaming one.
     #[inline]
     pub fn row_count(&self) -> usize {
-        unsafe { ffi::duckdb_arrow_row_count(self.result_unwrap()) as usize }
+        unsafe { ffi::duckdb_arrow_stream_row_count(self.result_unwrap()) as usize }
     }
 
+    /// Fetch the next batch of the result, `Ok(None)` once the result is
+    /// exhausted (or if the statement was never executed).
     #[inline]
-    pub fn step(&self) -> Option<StructArray> {
-        self.result?;
+    pub fn step(&self) -> Result<Option<StructArray>> {
+        let result = match self.result {
+            Some(result) => result,
+            None => return Ok(None),
+        };
+        // a streaming result runs the query as it is fetched: stop fetching
+        // once the deadline has passed, dropping the result frees the query
+        if self.deadline_passed() {
+            return Err(error_timed_out());
+        }
         unsafe {
-            let mut arrays = &FFI_ArrowArray::empty();
-            let arrays = &mut arrays;
-            if ffi::duckdb_query_arrow_array(self.result_unwrap(), arrays as *mut _ as *mut *mut c_void)
-                != ffi::DuckDBSuccess
-            {
-                return None;
-            }
-            if (**arrays).is_empty() {
-                return None;
+            let mut array = FFI_ArrowArray::empty();
+            let mut array_ptr = &mut array as *mut FFI_ArrowArray;
+            let rc = ffi::duckdb_arrow_stream_array(result, &mut array_ptr as *mut _ as *mut ffi::duckdb_arrow_array);
+            if rc != ffi::DuckDBSuccess {
+                let c_err = ffi::duckdb_arrow_stream_error(result);
+                let message = CStr::from_ptr(c_err).to_string_lossy().to_string();
+                return error_from_duckdb_code(rc, Some(message)).map(|_| None);
             }
-
-            let mut schema = &FFI_ArrowSchema::empty();
-            let schema = &mut schema;
-            if ffi::duckdb_query_arrow_schema(self.result_unwrap(), schema as *mut _ as *mut *mut c_void)
-                != ffi::DuckDBSuccess
-            {
-                return None;
+            if array.is_empty() {
+                return Ok(None);
             }
 
-            let arrow_array =
-                ArrowArray::try_from_raw(*arrays as *const FFI_ArrowArray, *schema as *const FFI_ArrowSchema)
-                    .expect("ok");
-            let array_data = ArrayData::try_from(arrow_array).expect("ok");
+            // the import takes ownership of its schema: every batch gets its
+            // own, converted from the schema fetched (and checked) by execute
+            // instead of asking DuckDB again
+            let schema = FFI_ArrowSchema::try_from(self.schema.as_ref().unwrap().as_ref())?;
+            let arrow_array = ArrowArray::try_from_raw(&array, &schema)?;
+            let array_data = ArrayData::try_from(arrow_array)?;
             let struct_array = StructArray::from(array_data);
-            Some(struct_array)
+            Ok(Some(struct_array))
         }
     }
 
     #[inline]
     pub fn column_count(&self) -> usize {
-        unsafe { ffi::duckdb_arrow_column_count(self.result_unwrap()) as usize }
+        // the schema is fetched along with the result, no need to ask DuckDB
+        // again for every cell read through `RowIndex`
+        self.schema.as_ref().unwrap().fields().len()
     }
 
     #[inline]
@@ -139,6 +211,11 @@ impl RawStatement {
         Some(self.schema.as_ref().unwrap().field(idx).name())
     }
 
+    #[inline]
+    pub fn column_index(&self, name: &str) -> Option<usize> {
+        self.column_index.as_ref().and_then(|index| index.get(name))
+    }
+
     #[allow(dead_code)]
     unsafe fn print_result(&self, mut result: ffi::duckdb_result) {
         use ffi::duckdb_column_count;
@@ -169,34 +246,210 @@ impl RawStatement {
     }
 
     /// NOTE: if execute failed, we shouldn't call any other methods which depends on result
+    ///
+    /// The result is fully materialized, so that the number of changed rows is
+    /// known once this returns.
     pub fn execute(&mut self) -> Result<usize> {
+        self.execute_pending(false, None)
+    }
+
+    /// Like [`execute`](RawStatement::execute), but the rows are only produced
+    /// as [`step`](RawStatement::step) pulls them.
+    ///
+    /// The streaming result is invalidated as soon as another query runs on
+    /// the same connection. `arrow_batch_size` caps the rows of each batch,
+    /// one vector if `None`.
+    pub fn execute_streaming(&mut self, arrow_batch_size: Option<usize>) -> Result<usize> {
+        self.execute_pending(true, arrow_batch_size)
+    }
+
+    fn execute_pending(&mut self, streaming: bool, arrow_batch_size: Option<usize>) -> Result<usize> {
+        self.start_pending(streaming)?;
+        self.finish_pending(arrow_batch_size)
+    }
+
+    /// Start executing the statement without running any of the query yet,
+    /// see [`execute_task`](RawStatement::execute_task).
+    pub fn start_pending(&mut self, streaming: bool) -> Result<()> {
         self.reset_result();
+        if let Some(ref interrupt) = self.interrupt {
+            interrupt.enable_requested_progress();
+        }
         unsafe {
-            let mut out: ffi::duckdb_arrow = ptr::null_mut();
-            let rc = ffi::duckdb_execute_prepared_arrow(self.ptr, &mut out);
-            result_from_duckdb_arrow(rc, out)?;
+            let mut pending: ffi::duckdb_pending_result = ptr::null_mut();
+            let rc = if streaming {
+                ffi::duckdb_pending_prepared_streaming(self.ptr, &mut pending)
+            } else {
+                ffi::duckdb_pending_prepared(self.ptr, &mut pending)
+            };
+            result_from_duckdb_pending(rc, pending)?;
+            self.pending = Some(pending);
+        }
+        self.streaming = streaming;
+        self.deadline = self.timeout.map(|timeout| Instant::now() + timeout);
+        Ok(())
+    }
 
-            let rows_changed = ffi::duckdb_arrow_rows_changed(out);
+    // With a deadline or a progress handler, run the query a task at a time so
+    // that they are checked in between; otherwise DuckDB runs it in one go.
+    fn drive_pending(&mut self) -> Result<()> {
+        if self.deadline.is_some() || self.progress_handler.is_some() {
+            while !self.execute_task()? {}
+        }
+        Ok(())
+    }
+
+    /// Run one task of the query started by
+    /// [`start_pending`](RawStatement::start_pending), returning whether the
+    /// result is ready to be fetched with
+    /// [`finish_pending`](RawStatement::finish_pending).
+    pub fn execute_task(&mut self) -> Result<bool> {
+        let pending = self.pending.expect("no pending query");
+        if self.deadline_passed() {
+            // the query fails within its next task, and frees what it holds
+            if let Some(ref interrupt) = self.interrupt {
+                interrupt.interrupt();
+            }
+        }
+        unsafe {
+            match ffi::duckdb_pending_execute_task(pending) {
+                ffi::duckdb_pending_state_DUCKDB_PENDING_RESULT_READY => Ok(true),
+                ffi::duckdb_pending_state_DUCKDB_PENDING_RESULT_NOT_READY => {
+                    self.report_progress();
+                    Ok(false)
+                }
+                _ => {
+                    self.pending = None;
+                    result_from_duckdb_pending(ffi::DuckDBError, pending).map(|_| false)
+                }
+            }
+        }
+    }
+
+    // Pass the progress of the query to the handler, interrupting the query
+    // (within its next task) if the handler asks for it.
+    fn report_progress(&mut self) {
+        if let (Some(handler), Some(interrupt)) = (self.progress_handler.as_mut(), self.interrupt.as_ref()) {
+            let progress = interrupt.query_progress().unwrap_or(0.0);
+            if (handler.0)(progress) {
+                interrupt.interrupt();
+            }
+        }
+    }
+
+    /// Run what is left of the query started by
+    /// [`start_pending`](RawStatement::start_pending) and capture its result.
+    pub fn finish_pending(&mut self, arrow_batch_size: Option<usize>) -> Result<usize> {
+        self.drive_pending()?;
+        if !self.streaming {
+            // the result is materialized, the query is done
+            self.deadline = None;
+        }
+        let mut pending = self.pending.take().expect("no pending query");
+        unsafe {
+            let mut out: ffi::duckdb_arrow_stream = ptr::null_mut();
+            let rc = ffi::duckdb_execute_pending_arrow(pending, &mut out);
+            ffi::duckdb_destroy_pending(&mut pending);
+            result_from_duckdb_arrow_stream(rc, out)?;
+            set_arrow_batch_size(out, arrow_batch_size)?;
+
+            let rows_changed = ffi::duckdb_arrow_stream_rows_changed(out);
             let mut c_schema = Arc::into_raw(Arc::new(FFI_ArrowSchema::empty()));
-            let rc = ffi::duckdb_query_arrow_schema(out, &mut c_schema as *mut _ as *mut *mut c_void);
+            let rc = ffi::duckdb_arrow_stream_schema(out, &mut c_schema as *mut _ as *mut ffi::duckdb_arrow_schema);
             if rc != ffi::DuckDBSuccess {
                 Arc::from_raw(c_schema);
-                result_from_duckdb_arrow(rc, out)?;
+                result_from_duckdb_arrow_stream(rc, out)?;
             }
-            self.schema = Some(Arc::new(Schema::try_from(&*c_schema).unwrap()));
+            let schema = Schema::try_from(&*c_schema);
             Arc::from_raw(c_schema);
+            // fail here rather than on the first batch if a column type has
+            // no Arrow export
+            let schema = match schema.and_then(|schema| FFI_ArrowSchema::try_from(&schema).map(|_| schema)) {
+                Ok(schema) => schema,
+                Err(err) => {
+                    ffi::duckdb_destroy_arrow_stream(&mut out);
+                    return Err(err.into());
+                }
+            };
+            self.column_index = Some(ColumnIndex::new(&schema));
+            self.schema = Some(Arc::new(schema));
 
             self.result = Some(out);
             Ok(rows_changed as usize)
         }
     }
 
+    /// Like [`execute`](RawStatement::execute), but the materialized result
+    /// is converted to Arrow on the DuckDB worker threads as
+    /// [`step`](RawStatement::step) pulls the batches.
+    pub fn execute_parallel(&mut self, arrow_batch_size: Option<usize>) -> Result<usize> {
+        let rows_changed = self.execute_pending(false, arrow_batch_size)?;
+        unsafe {
+            let rc = ffi::duckdb_arrow_stream_set_parallel(self.result_unwrap(), self.ptr);
+            if rc != ffi::DuckDBSuccess {
+                self.reset_result();
+                return Err(Error::DuckDBFailure(ffi::Error::new(rc), None));
+            }
+        }
+        Ok(rows_changed)
+    }
+
+    /// Execute into a materialized `duckdb_result`, read through data chunks
+    /// instead of Arrow. The caller owns the result.
+    pub fn execute_result(&mut self) -> Result<ffi::duckdb_result> {
+        self.start_pending(false)?;
+        self.drive_pending()?;
+        self.deadline = None;
+        let mut pending = self.pending.take().unwrap();
+        unsafe {
+            let mut out: ffi::duckdb_result = mem::zeroed();
+            let rc = ffi::duckdb_execute_pending(pending, &mut out);
+            ffi::duckdb_destroy_pending(&mut pending);
+            result_from_duckdb_result(rc, &mut out)?;
+            Ok(out)
+        }
+    }
+
+    /// Execute as a streaming result exported through the Arrow C stream
+    /// interface. The stream owns the result, `self.result` is left unset.
+    pub fn execute_arrow_stream(&mut self, arrow_batch_size: Option<usize>) -> Result<ArrowArrayStreamReader> {
+        self.start_pending(true)?;
+        // the reader fetches on its own, the deadline only covers the query
+        // until its first batch is ready
+        self.drive_pending()?;
+        self.deadline = None;
+        let mut pending = self.pending.take().unwrap();
+        unsafe {
+            let mut out: ffi::duckdb_arrow_stream = ptr::null_mut();
+            let rc = ffi::duckdb_execute_pending_arrow(pending, &mut out);
+            ffi::duckdb_destroy_pending(&mut pending);
+            result_from_duckdb_arrow_stream(rc, out)?;
+            set_arrow_batch_size(out, arrow_batch_size)?;
+
+            let mut stream = FFI_ArrowArrayStream::empty();
+            let rc = ffi::duckdb_arrow_stream_export(
+                &mut out,
+                &mut stream as *mut FFI_ArrowArrayStream as ffi::duckdb_arrow_array_stream,
+            );
+            result_from_duckdb_arrow_stream(rc, out)?;
+            ArrowArrayStreamReader::from_raw(&mut stream)
+                .map_err(|e| Error::DuckDBFailure(ffi::Error::new(ffi::DuckDBError), Some(e.to_string())))
+        }
+    }
+
     #[inline]
     pub fn reset_result(&mut self) {
+        self.deadline = None;
         self.schema = None;
+        self.column_index = None;
+        if let Some(mut pending) = self.pending.take() {
+            unsafe {
+                ffi::duckdb_destroy_pending(&mut pending);
+            }
+        }
         if self.result.is_some() {
             unsafe {
-                ffi::duckdb_destroy_arrow(&mut self.result_unwrap());
+                ffi::duckdb_destroy_arrow_stream(&mut self.result_unwrap());
             }
             self.result = None;
         }
@@ -213,6 +466,26 @@ impl RawStatement {
     }
 }
 
+#[inline]
+unsafe fn set_arrow_batch_size(out: ffi::duckdb_arrow_stream, arrow_batch_size: Option<usize>) -> Result<()> {
+    match arrow_batch_size {
+        Some(batch_size) => {
+            let rc = ffi::duckdb_arrow_stream_set_batch_size(out, batch_size as u64);
+            result_from_duckdb_arrow_stream(rc, out)
+        }
+        None => Ok(()),
+    }
+}
+
+// Boxed progress handler, so that `RawStatement` can still derive `Debug`.
+struct ProgressHandler(Box<dyn FnMut(f64) -> bool>);
+
+impl fmt::Debug for ProgressHandler {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        f.write_str("ProgressHandler")
+    }
+}
+
 impl Drop for RawStatement {
     fn drop(&mut self) {
         self.reset_result();
@@ -1,33 +1,26 @@
 use std::convert;
-use std::sync::Arc;
 
 use super::{Error, Result, Statement};
 use crate::types::{self, FromSql, FromSqlError, ValueRef};
 
-use arrow::array::{self, Array, StructArray};
+use arrow::array::{self, Array, ArrayRef, StructArray};
 use arrow::datatypes::*;
 use fallible_iterator::FallibleIterator;
 use fallible_streaming_iterator::FallibleStreamingIterator;
 use rust_decimal::prelude::*;
 
 /// An handle for the resulting rows of a query.
+///
+/// Rows are read one batch (a DuckDB vector) at a time: the current batch is
+/// owned by the single [`Row`] cursor, which advancing simply moves to the
+/// next row until the batch is exhausted.
 #[must_use = "Rows is lazy and will do nothing unless consumed"]
 pub struct Rows<'stmt> {
     pub(crate) stmt: Option<&'stmt Statement<'stmt>>,
-    arr: Arc<Option<StructArray>>,
     row: Option<Row<'stmt>>,
-    current_row: usize,
-    current_batch_row: usize,
 }
 
 impl<'stmt> Rows<'stmt> {
-    #[inline]
-    fn reset(&mut self) {
-        self.current_row = 0;
-        self.current_batch_row = 0;
-        self.arr = Arc::new(None);
-    }
-
     /// Attempt to get the next row from the query. Returns `Ok(Some(Row))` if
     /// there is another row, `Err(...)` if there was an error
     /// getting the next row, and `Ok(None)` if all rows have been retrieved.
@@ -47,14 +40,6 @@ impl<'stmt> Rows<'stmt> {
         Ok((*self).get())
     }
 
-    #[inline]
-    fn batch_row_count(&self) -> usize {
-        if self.arr.is_none() {
-            return 0;
-        }
-        self.arr.as_ref().as_ref().unwrap().len()
-    }
-
     /// Map over this `Rows`, converting it to a [`Map`], which
     /// implements `FallibleIterator`.
     /// ```rust,no_run
@@ -106,10 +91,7 @@ impl<'stmt> Rows<'stmt> {
     pub(crate) fn new(stmt: &'stmt Statement<'stmt>) -> Rows<'stmt> {
         Rows {
             stmt: Some(stmt),
-            arr: Arc::new(None),
             row: None,
-            current_row: 0,
-            current_batch_row: 0,
         }
     }
 
@@ -220,28 +202,23 @@ impl<'stmt> FallibleStreamingIterator for Rows<'stmt> {
     fn advance(&mut self) -> Result<()> {
         match self.stmt {
             Some(stmt) => {
-                if self.current_row < stmt.row_count() {
-                    if self.current_batch_row >= self.batch_row_count() {
-                        self.arr = Arc::new(stmt.step());
-                        if self.arr.is_none() {
-                            self.row = None;
-                            return Ok(());
-                        }
-                        self.current_batch_row = 0;
+                if let Some(ref mut row) = self.row {
+                    if row.current_row + 1 < row.len {
+                        row.current_row += 1;
+                        return Ok(());
                     }
-                    self.row = Some(Row {
-                        stmt,
-                        arr: self.arr.clone(),
-                        current_row: self.current_batch_row,
-                    });
-                    self.current_row += 1;
-                    self.current_batch_row += 1;
-                    Ok(())
-                } else {
-                    self.reset();
-                    self.row = None;
-                    Ok(())
                 }
+                // the current batch is exhausted; the result may be streaming,
+                // so its size isn't known up front: fetch until DuckDB has no
+                // more batches
+                self.row = None;
+                while let Some(arr) = stmt.stmt.step()? {
+                    if !arr.is_empty() {
+                        self.row = Some(Row::new(stmt, &arr));
+                        break;
+                    }
+                }
+                Ok(())
             }
             None => {
                 self.row = None;
@@ -259,11 +236,22 @@ impl<'stmt> FallibleStreamingIterator for Rows<'stmt> {
 /// A single result row of a query.
 pub struct Row<'stmt> {
     pub(crate) stmt: &'stmt Statement<'stmt>,
-    arr: Arc<Option<StructArray>>,
+    columns: Vec<ColumnReader>,
+    len: usize,
     current_row: usize,
 }
 
 impl<'stmt> Row<'stmt> {
+    #[inline]
+    fn new(stmt: &'stmt Statement<'stmt>, arr: &StructArray) -> Row<'stmt> {
+        Row {
+            stmt,
+            columns: arr.columns().iter().map(ColumnReader::new).collect(),
+            len: arr.len(),
+            current_row: 0,
+        }
+    }
+
     /// Get the value of a particular column of the result row.
     ///
     /// ## Failure
@@ -298,7 +286,7 @@ impl<'stmt> Row<'stmt> {
     /// 16 bytes, `Error::InvalidColumnType` will also be returned.
     pub fn get<I: RowIndex, T: FromSql>(&self, idx: I) -> Result<T> {
         let idx = idx.idx(self.stmt)?;
-        let value = self.value_ref(self.current_row, idx);
+        let value = self.value_ref(self.current_row, idx)?;
         FromSql::column_result(value).map_err(|err| match err {
             FromSqlError::InvalidType => {
                 Error::InvalidColumnType(idx, self.stmt.column_name_unwrap(idx).into(), value.data_type())
@@ -327,223 +315,118 @@ impl<'stmt> Row<'stmt> {
     ///
     /// Returns an `Error::InvalidColumnName` if `idx` is not a valid column
     /// name for this row.
+    ///
+    /// Returns an `Error::InvalidColumnType` if the cell is not NULL and its
+    /// DuckDB column type can't be read yet.
     pub fn get_ref<I: RowIndex>(&self, idx: I) -> Result<ValueRef<'_>> {
         let idx = idx.idx(self.stmt)?;
         // Narrowing from `ValueRef<'stmt>` (which `self.stmt.value_ref(idx)`
         // returns) to `ValueRef<'a>` is needed because it's only valid until
         // the next call to sqlite3_step.
-        let val_ref = self.value_ref(self.current_row, idx);
-        Ok(val_ref)
+        self.value_ref(self.current_row, idx)
     }
 
-    fn value_ref(&self, row: usize, col: usize) -> ValueRef<'_> {
-        let column = self.arr.as_ref().as_ref().unwrap().column(col);
-        if column.is_null(row) {
-            return ValueRef::Null;
-        }
-        // duckdb.cpp SetArrowFormat
-        // https://github.com/duckdb/duckdb/blob/71f1c7a7e4b8737cff5e78d1f090c54f5e78e17b/src/main/query_result.cpp#L148
-        match column.data_type() {
-            DataType::Utf8 => {
-                let array = column.as_any().downcast_ref::<array::StringArray>().unwrap();
-
-                if array.is_null(row) {
-                    return ValueRef::Null;
-                }
-                ValueRef::from(array.value(row))
-            }
-            DataType::LargeUtf8 => {
-                let array = column.as_any().downcast_ref::<array::LargeStringArray>().unwrap();
-
-                if array.is_null(row) {
-                    return ValueRef::Null;
-                }
-                ValueRef::from(array.value(row))
-            }
-            DataType::Binary => {
-                let array = column.as_any().downcast_ref::<array::BinaryArray>().unwrap();
-
-                if array.is_null(row) {
-                    return ValueRef::Null;
-                }
-                ValueRef::Blob(array.value(row))
-            }
-            DataType::LargeBinary => {
-                let array = column.as_any().downcast_ref::<array::LargeBinaryArray>().unwrap();
-
-                if array.is_null(row) {
-                    return ValueRef::Null;
-                }
-                ValueRef::Blob(array.value(row))
-            }
-            DataType::Boolean => {
-                let array = column.as_any().downcast_ref::<array::BooleanArray>().unwrap();
-
-                if array.is_null(row) {
-                    return ValueRef::Null;
-                }
-                ValueRef::Boolean(array.value(row))
-            }
-            DataType::Int8 => {
-                let array = column.as_any().downcast_ref::<array::Int8Array>().unwrap();
-
-                if array.is_null(row) {
-                    return ValueRef::Null;
-                }
-                ValueRef::TinyInt(array.value(row))
-            }
-            DataType::Int16 => {
-                let array = column.as_any().downcast_ref::<array::Int16Array>().unwrap();
-
-                if array.is_null(row) {
-                    return ValueRef::Null;
-                }
-                ValueRef::SmallInt(array.value(row))
-            }
-            DataType::Int32 => {
-                let array = column.as_any().downcast_ref::<array::Int32Array>().unwrap();
-
-                if array.is_null(row) {
-                    return ValueRef::Null;
-                }
-                ValueRef::Int(array.value(row))
-            }
-            DataType::Int64 => {
-                let array = column.as_any().downcast_ref::<array::Int64Array>().unwrap();
-
-                if array.is_null(row) {
-                    return ValueRef::Null;
-                }
-                ValueRef::BigInt(array.value(row))
-            }
-            DataType::UInt8 => {
-                let array = column.as_any().downcast_ref::<array::UInt8Array>().unwrap();
-
-                if array.is_null(row) {
-                    return ValueRef::Null;
-                }
-                ValueRef::UTinyInt(array.value(row))
-            }
-            DataType::UInt16 => {
-                let array = column.as_any().downcast_ref::<array::UInt16Array>().unwrap();
-
-                if array.is_null(row) {
-                    return ValueRef::Null;
-                }
-                ValueRef::USmallInt(array.value(row))
-            }
-            DataType::UInt32 => {
-                let array = column.as_any().downcast_ref::<array::UInt32Array>().unwrap();
-
-                if array.is_null(row) {
-                    return ValueRef::Null;
-                }
-                ValueRef::UInt(array.value(row))
-            }
-            DataType::UInt64 => {
-                let array = column.as_any().downcast_ref::<array::UInt64Array>().unwrap();
-
-                if array.is_null(row) {
-                    return ValueRef::Null;
-                }
-                ValueRef::UBigInt(array.value(row))
-            }
-            DataType::Float16 => {
-                let array = column.as_any().downcast_ref::<array::Float32Array>().unwrap();
-
-                if array.is_null(row) {
-                    return ValueRef::Null;
-                }
-                ValueRef::Float(array.value(row))
-            }
-            DataType::Float32 => {
-                let array = column.as_any().downcast_ref::<array::Float32Array>().unwrap();
-
-                if array.is_null(row) {
-                    return ValueRef::Null;
-                }
-                ValueRef::Float(array.value(row))
-            }
-            DataType::Float64 => {
-                let array = column.as_any().downcast_ref::<array::Float64Array>().unwrap();
+    #[inline]
+    fn value_ref(&self, row: usize, col: usize) -> Result<ValueRef<'_>> {
+        self.columns[col].value_ref(row).map_err(|data_type| {
+            Error::InvalidColumnType(col, self.stmt.column_name_unwrap(col).into(), data_type.into())
+        })
+    }
 
-                if array.is_null(row) {
-                    return ValueRef::Null;
-                }
-                ValueRef::Double(array.value(row))
-            }
-            DataType::Decimal128(..) => {
-                let array = column.as_any().downcast_ref::<array::Decimal128Array>().unwrap();
+    /// Get the value of a particular column of the result row as a `ValueRef`,
+    /// allowing data to be read out of a row without copying.
+    ///
+    /// This `ValueRef` is valid only as long as this Row, which is enforced by
+    /// it's lifetime. This means that while this method is completely safe,
+    /// it can be difficult to use, and most callers will be better served by
+    /// [`get`](Row::get) or [`get_unwrap`](Row::get_unwrap).
+    ///
+    /// ## Failure
+    ///
+    /// Panics if calling [`row.get_ref(idx)`](Row::get_ref) would return an
+    /// error, including:
+    ///
+    /// * If `idx` is outside the range of columns in the returned query.
+    /// * If `idx` is not a valid column name for this row.
+    /// * If the cell is not NULL and its column type can't be read yet.
+    pub fn get_ref_unwrap<I: RowIndex>(&self, idx: I) -> ValueRef<'_> {
+        self.get_ref(idx).unwrap()
+    }
+}
 
-                if array.is_null(row) {
-                    return ValueRef::Null;
-                }
-                // hugeint: d:38,0
-                if array.scale() == 0 {
-                    return ValueRef::HugeInt(array.value(row).into());
-                }
-                ValueRef::Decimal(Decimal::from_i128_with_scale(
-                    array.value(row).into(),
-                    array.scale() as u32,
-                ))
-            }
-            DataType::Timestamp(unit, _) if *unit == TimeUnit::Second => {
-                let array = column.as_any().downcast_ref::<array::TimestampSecondArray>().unwrap();
+impl<'stmt> AsRef<Statement<'stmt>> for Row<'stmt> {
+    fn as_ref(&self) -> &Statement<'stmt> {
+        self.stmt
+    }
+}
 
-                if array.is_null(row) {
-                    return ValueRef::Null;
-                }
-                ValueRef::Timestamp(types::TimeUnit::Second, array.value(row))
-            }
-            DataType::Timestamp(unit, _) if *unit == TimeUnit::Millisecond => {
-                let array = column
-                    .as_any()
-                    .downcast_ref::<array::TimestampMillisecondArray>()
-                    .unwrap();
-
-                if array.is_null(row) {
-                    return ValueRef::Null;
-                }
-                ValueRef::Timestamp(types::TimeUnit::Millisecond, array.value(row))
-            }
-            DataType::Timestamp(unit, _) if *unit == TimeUnit::Microsecond => {
-                let array = column
-                    .as_any()
-                    .downcast_ref::<array::TimestampMicrosecondArray>()
-                    .unwrap();
-
-                if array.is_null(row) {
-                    return ValueRef::Null;
-                }
-                ValueRef::Timestamp(types::TimeUnit::Microsecond, array.value(row))
-            }
-            DataType::Timestamp(unit, _) if *unit == TimeUnit::Nanosecond => {
-                let array = column
-                    .as_any()
-                    .downcast_ref::<array::TimestampNanosecondArray>()
-                    .unwrap();
-
-                if array.is_null(row) {
-                    return ValueRef::Null;
-                }
-                ValueRef::Timestamp(types::TimeUnit::Nanosecond, array.value(row))
-            }
-            DataType::Date32 => {
-                let array = column.as_any().downcast_ref::<array::Date32Array>().unwrap();
+/// A column of the current batch, resolved to its concrete arrow array once
+/// per batch. Reading a cell is then a match on the variant plus a slice
+/// load, instead of comparing the `DataType` and downcasting for every cell.
+enum ColumnReader {
+    Utf8(array::StringArray),
+    LargeUtf8(array::LargeStringArray),
+    Binary(array::BinaryArray),
+    LargeBinary(array::LargeBinaryArray),
+    Boolean(array::BooleanArray),
+    Int8(array::Int8Array),
+    Int16(array::Int16Array),
+    Int32(array::Int32Array),
+    Int64(array::Int64Array),
+    UInt8(array::UInt8Array),
+    UInt16(array::UInt16Array),
+    UInt32(array::UInt32Array),
+    UInt64(array::UInt64Array),
+    Float32(array::Float32Array),
+    Float64(array::Float64Array),
+    // hugeint: d:38,0
+    HugeInt(array::Decimal128Array),
+    Decimal(array::Decimal128Array, u32),
+    TimestampSecond(array::TimestampSecondArray),
+    TimestampMillisecond(array::TimestampMillisecondArray),
+    TimestampMicrosecond(array::TimestampMicrosecondArray),
+    TimestampNanosecond(array::TimestampNanosecondArray),
+    Date32(array::Date32Array),
+    Time64Microsecond(array::Time64MicrosecondArray),
+    // kept whole so NULL cells still read as `ValueRef::Null`
+    Unsupported(ArrayRef),
+}
 
-                if array.is_null(row) {
-                    return ValueRef::Null;
-                }
-                ValueRef::Date32(array.value(row))
-            }
-            DataType::Time64(TimeUnit::Microsecond) => {
-                let array = column.as_any().downcast_ref::<array::Time64MicrosecondArray>().unwrap();
+macro_rules! read_value {
+    ($array:expr, $row:expr, $value:expr) => {
+        Ok(if $array.is_null($row) { ValueRef::Null } else { $value })
+    };
+}
 
-                if array.is_null(row) {
-                    return ValueRef::Null;
-                }
-                ValueRef::Time64(types::TimeUnit::Microsecond, array.value(row))
-            }
+impl ColumnReader {
+    fn new(column: &ArrayRef) -> ColumnReader {
+        let data = column.data().clone();
+        // duckdb.cpp SetArrowFormat
+        // https://github.com/duckdb/duckdb/blob/71f1c7a7e4b8737cff5e78d1f090c54f5e78e17b/src/main/query_result.cpp#L148
+        match column.data_type() {
+            DataType::Utf8 => ColumnReader::Utf8(data.into()),
+            DataType::LargeUtf8 => ColumnReader::LargeUtf8(data.into()),
+            DataType::Binary => ColumnReader::Binary(data.into()),
+            DataType::LargeBinary => ColumnReader::LargeBinary(data.into()),
+            DataType::Boolean => ColumnReader::Boolean(data.into()),
+            DataType::Int8 => ColumnReader::Int8(data.into()),
+            DataType::Int16 => ColumnReader::Int16(data.into()),
+            DataType::Int32 => ColumnReader::Int32(data.into()),
+            DataType::Int64 => ColumnReader::Int64(data.into()),
+            DataType::UInt8 => ColumnReader::UInt8(data.into()),
+            DataType::UInt16 => ColumnReader::UInt16(data.into()),
+            DataType::UInt32 => ColumnReader::UInt32(data.into()),
+            DataType::UInt64 => ColumnReader::UInt64(data.into()),
+            DataType::Float16 | DataType::Float32 => ColumnReader::Float32(data.into()),
+            DataType::Float64 => ColumnReader::Float64(data.into()),
+            DataType::Decimal128(_, 0) => ColumnReader::HugeInt(data.into()),
+            DataType::Decimal128(_, scale) => ColumnReader::Decimal(data.into(), *scale as u32),
+            DataType::Timestamp(TimeUnit::Second, _) => ColumnReader::TimestampSecond(data.into()),
+            DataType::Timestamp(TimeUnit::Millisecond, _) => ColumnReader::TimestampMillisecond(data.into()),
+            DataType::Timestamp(TimeUnit::Microsecond, _) => ColumnReader::TimestampMicrosecond(data.into()),
+            DataType::Timestamp(TimeUnit::Nanosecond, _) => ColumnReader::TimestampNanosecond(data.into()),
+            DataType::Date32 => ColumnReader::Date32(data.into()),
+            DataType::Time64(TimeUnit::Microsecond) => ColumnReader::Time64Microsecond(data.into()),
             // TODO: support more data types
             // DataType::Interval(unit) => match unit {
             //     IntervalUnit::DayTime => {
@@ -580,33 +463,70 @@ impl<'stmt> Row<'stmt> {
             // DataType::Time64(unit) if *unit == TimeUnit::Nanosecond => {
             //     make_string_time!(array::Time64NanosecondArray, column, row)
             // }
-            _ => unreachable!("invalid value: {}, {}", col, self.stmt.column_type(col)),
+            _ => ColumnReader::Unsupported(column.clone()),
         }
     }
 
-    /// Get the value of a particular column of the result row as a `ValueRef`,
-    /// allowing data to be read out of a row without copying.
-    ///
-    /// This `ValueRef` is valid only as long as this Row, which is enforced by
-    /// it's lifetime. This means that while this method is completely safe,
-    /// it can be difficult to use, and most callers will be better served by
-    /// [`get`](Row::get) or [`get_unwrap`](Row::get_unwrap).
-    ///
-    /// ## Failure
-    ///
-    /// Panics if calling [`row.get_ref(idx)`](Row::get_ref) would return an
-    /// error, including:
-    ///
-    /// * If `idx` is outside the range of columns in the returned query.
-    /// * If `idx` is not a valid column name for this row.
-    pub fn get_ref_unwrap<I: RowIndex>(&self, idx: I) -> ValueRef<'_> {
-        self.get_ref(idx).unwrap()
-    }
-}
-
-impl<'stmt> AsRef<Statement<'stmt>> for Row<'stmt> {
-    fn as_ref(&self) -> &Statement<'stmt> {
-        self.stmt
+    /// The value of `row`, or the column type if the cell is not NULL but the
+    /// type is unsupported.
+    #[inline]
+    fn value_ref(&self, row: usize) -> std::result::Result<ValueRef<'_>, &DataType> {
+        match self {
+            ColumnReader::Utf8(array) => read_value!(array, row, ValueRef::from(array.value(row))),
+            ColumnReader::LargeUtf8(array) => read_value!(array, row, ValueRef::from(array.value(row))),
+            ColumnReader::Binary(array) => read_value!(array, row, ValueRef::Blob(array.value(row))),
+            ColumnReader::LargeBinary(array) => read_value!(array, row, ValueRef::Blob(array.value(row))),
+            ColumnReader::Boolean(array) => read_value!(array, row, ValueRef::Boolean(array.value(row))),
+            ColumnReader::Int8(array) => read_value!(array, row, ValueRef::TinyInt(array.values()[row])),
+            ColumnReader::Int16(array) => read_value!(array, row, ValueRef::SmallInt(array.values()[row])),
+            ColumnReader::Int32(array) => read_value!(array, row, ValueRef::Int(array.values()[row])),
+            ColumnReader::Int64(array) => read_value!(array, row, ValueRef::BigInt(array.values()[row])),
+            ColumnReader::UInt8(array) => read_value!(array, row, ValueRef::UTinyInt(array.values()[row])),
+            ColumnReader::UInt16(array) => read_value!(array, row, ValueRef::USmallInt(array.values()[row])),
+            ColumnReader::UInt32(array) => read_value!(array, row, ValueRef::UInt(array.values()[row])),
+            ColumnReader::UInt64(array) => read_value!(array, row, ValueRef::UBigInt(array.values()[row])),
+            ColumnReader::Float32(array) => read_value!(array, row, ValueRef::Float(array.values()[row])),
+            ColumnReader::Float64(array) => read_value!(array, row, ValueRef::Double(array.values()[row])),
+            ColumnReader::HugeInt(array) => read_value!(array, row, ValueRef::HugeInt(array.value(row).into())),
+            ColumnReader::Decimal(array, scale) => read_value!(
+                array,
+                row,
+                ValueRef::Decimal(Decimal::from_i128_with_scale(array.value(row).into(), *scale))
+            ),
+            ColumnReader::TimestampSecond(array) => read_value!(
+                array,
+                row,
+                ValueRef::Timestamp(types::TimeUnit::Second, array.values()[row])
+            ),
+            ColumnReader::TimestampMillisecond(array) => read_value!(
+                array,
+                row,
+                ValueRef::Timestamp(types::TimeUnit::Millisecond, array.values()[row])
+            ),
+            ColumnReader::TimestampMicrosecond(array) => read_value!(
+                array,
+                row,
+                ValueRef::Timestamp(types::TimeUnit::Microsecond, array.values()[row])
+            ),
+            ColumnReader::TimestampNanosecond(array) => read_value!(
+                array,
+                row,
+                ValueRef::Timestamp(types::TimeUnit::Nanosecond, array.values()[row])
+            ),
+            ColumnReader::Date32(array) => read_value!(array, row, ValueRef::Date32(array.values()[row])),
+            ColumnReader::Time64Microsecond(array) => read_value!(
+                array,
+                row,
+                ValueRef::Time64(types::TimeUnit::Microsecond, array.values()[row])
+            ),
+            ColumnReader::Unsupported(column) => {
+                if column.is_null(row) {
+                    Ok(ValueRef::Null)
+                } else {
+                    Err(column.data_type())
+                }
+            }
+        }
     }
 }
 
@@ -616,11 +536,12 @@ mod sealed {
     pub trait Sealed {}
     impl Sealed for usize {}
     impl Sealed for &str {}
+    impl Sealed for crate::ColumnHandle {}
 }
 
 /// A trait implemented by types that can index into columns of a row.
 ///
-/// It is only implemented for `usize` and `&str`.
+/// It is only implemented for `usize`, `&str` and [`ColumnHandle`](crate::ColumnHandle).
 pub trait RowIndex: sealed::Sealed {
     /// Returns the index of the appropriate column, or `None` if no such
     /// column exists.
@@ -645,6 +566,13 @@ impl RowIndex for &'_ str {
     }
 }
 
+impl RowIndex for crate::ColumnHandle {
+    #[inline]
+    fn idx(&self, stmt: &Statement<'_>) -> Result<usize> {
+        self.index().idx(stmt)
+    }
+}
+
 macro_rules! tuple_try_from_row {
     ($($field:ident),*) => {
         impl<'a, $($field,)*> convert::TryFrom<&'a Row<'a>> for ($($field,)*) where $($field: FromSql,)* {
@@ -684,6 +612,48 @@ mod tests {
     #![allow(clippy::redundant_closure)] // false positives due to lifetime issues; clippy issue #5594
     use crate::{Connection, Result};
 
+    #[test]
+    fn test_rows_across_batches() -> Result<()> {
+        let conn = Connection::open_in_memory()?;
+        let mut stmt = conn.prepare(
+            "SELECT i, CASE WHEN i % 2 = 0 THEN NULL ELSE i::VARCHAR END FROM range(0, 3000) t(i) ORDER BY i",
+        )?;
+        let mut rows = stmt.query([])?;
+        let mut expected = 0i64;
+        while let Some(row) = rows.next()? {
+            assert_eq!(row.get::<_, i64>(0)?, expected);
+            let text: Option<String> = row.get(1)?;
+            let expected_text = if expected % 2 == 0 {
+                None
+            } else {
+                Some(expected.to_string())
+            };
+            assert_eq!(text, expected_text);
+            expected += 1;
+        }
+        assert_eq!(expected, 3000);
+        // an exhausted result stays exhausted
+        assert!(rows.next()?.is_none());
+        Ok(())
+    }
+
+    #[test]
+    fn test_unsupported_column_type() -> Result<()> {
+        use crate::{types::ValueRef, Error};
+
+        let conn = Connection::open_in_memory()?;
+        let mut stmt = conn.prepare("SELECT NULL::INTERVAL, INTERVAL 1 DAY")?;
+        let mut rows = stmt.query([])?;
+        let row = rows.next()?.unwrap();
+        // a NULL cell reads fine whatever its column type
+        assert_eq!(row.get_ref(0)?, ValueRef::Null);
+        assert_eq!(row.get::<_, Option<i64>>(0)?, None);
+        // the value itself is an error, not a panic
+        assert!(matches!(row.get_ref(1), Err(Error::InvalidColumnType(1, ..))));
+        assert!(matches!(row.get::<_, i64>(1), Err(Error::InvalidColumnType(1, ..))));
+        Ok(())
+    }
+
     #[test]
     fn test_try_from_row_for_tuple_1() -> Result<()> {
         use crate::ToSql;
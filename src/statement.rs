@@ -1,16 +1,24 @@
 use std::ffi::c_void;
 use std::iter::IntoIterator;
 use std::os::raw::c_char;
+use std::time::Duration;
 use std::{convert, fmt, mem, ptr, str};
 
 use super::ffi;
-use super::{AndThenRows, Connection, Error, MappedRows, Params, RawStatement, Result, Row, Rows, ValueRef};
+use super::{
+    AndThenRows, Chunks, ColumnSlice, Connection, Error, MappedRows, Params, PendingQuery, RawStatement, Result, Row,
+    Rows, ValueRef,
+};
+use crate::appender_columns::columns_len;
 use crate::arrow_batch::Arrow;
 use crate::error::result_from_duckdb_prepare;
-use crate::types::{ToSql, ToSqlOutput};
+use crate::prepared_batch::PreparedBatch;
+use crate::types::{decimal_to_ffi, hugeint_to_ffi, ColumnBatch, Columns, FromColumns, ToSql, ToSqlOutput};
 
 use arrow::array::StructArray;
 use arrow::datatypes::DataType;
+use arrow::ffi_stream::ArrowArrayStreamReader;
+use arrow::record_batch::RecordBatch;
 
 /// A prepared statement.
 pub struct Statement<'conn> {
@@ -18,7 +26,7 @@ pub struct Statement<'conn> {
     pub(crate) stmt: RawStatement,
 }
 
-impl Statement<'_> {
+impl<'conn> Statement<'conn> {
     /// Execute the prepared statement.
     ///
     /// On success, returns the number of rows that were changed or inserted or
@@ -88,9 +96,76 @@ impl Statement<'_> {
         }
     }
 
+    /// Execute the prepared statement once per row of `columns`, with one
+    /// column per parameter, returning the total number of rows changed.
+    ///
+    /// The parameters are handed to DuckDB a vector at a time rather than
+    /// bound one by one, and all the rows are executed in one transaction
+    /// (the one started on the connection, if any). An `INSERT ... VALUES`
+    /// of a single row of parameters inserts all the rows in a single
+    /// vectorized pass; other statements are executed row by row.
+    ///
+    /// ## Example
+    ///
+    /// ```rust,no_run
+    /// # use duckdb::{Connection, Result};
+    /// fn insert_people(conn: &Connection, ids: &[i64], names: &[&str]) -> Result<usize> {
+    ///     let mut stmt = conn.prepare("INSERT INTO people (id, name) VALUES (?, ?)")?;
+    ///     stmt.execute_columns(&[&ids, &names])
+    /// }
+    /// ```
+    ///
+    /// # Failure
+    ///
+    /// Will return `Err` if the number of columns is not the parameter count,
+    /// if the columns have different lengths, if their values can't be cast
+    /// to the parameter types, or if executing a row fails, in which case
+    /// none of the rows are.
+    pub fn execute_columns(&mut self, columns: &[&dyn ColumnSlice]) -> Result<usize> {
+        let len = columns_len(columns, self.parameter_count())?;
+        if len == 0 {
+            return Ok(0);
+        }
+        self.stmt.reset_result();
+        let mut batch = unsafe { PreparedBatch::new(self.stmt.ptr())? };
+        batch.append_columns(columns, len)?;
+        batch.execute()
+    }
+
+    /// Execute the prepared statement once per row of an Arrow record batch,
+    /// with one column per parameter, returning the total number of rows
+    /// changed.
+    ///
+    /// See [`execute_columns`](Statement::execute_columns), the batch columns
+    /// being cast to the parameter types.
+    ///
+    /// # Failure
+    ///
+    /// Will return `Err` if the number of columns is not the parameter count,
+    /// if a column has an Arrow type that is not supported, or if executing a
+    /// row fails, in which case none of the rows are.
+    pub fn execute_record_batch(&mut self, record_batch: &RecordBatch) -> Result<usize> {
+        let column_count = record_batch.num_columns();
+        if column_count != self.parameter_count() {
+            return Err(Error::InvalidParameterCount(column_count, self.parameter_count()));
+        }
+        if record_batch.num_rows() == 0 {
+            return Ok(0);
+        }
+        self.stmt.reset_result();
+        let mut batch = unsafe { PreparedBatch::new(self.stmt.ptr())? };
+        batch.append_record_batch(record_batch)?;
+        batch.execute()
+    }
+
     /// Execute the prepared statement, returning a handle to the resulting
     /// vector of arrow RecordBatch
     ///
+    /// The batches are streamed from DuckDB as they are consumed, see
+    /// [`query`](Statement::query). Their size is one DuckDB vector (1024
+    /// rows) unless set with [`set_arrow_batch_size`](Statement::set_arrow_batch_size)
+    /// or [`Connection::set_arrow_batch_size`].
+    ///
     /// ## Example
     ///
     /// ```rust,no_run
@@ -106,10 +181,188 @@ impl Statement<'_> {
     /// Will return `Err` if binding parameters fails.
     #[inline]
     pub fn query_arrow<P: Params>(&mut self, params: P) -> Result<Arrow<'_>> {
-        self.execute(params)?;
+        params.__bind_in(self)?;
+        let arrow_batch_size = self.arrow_batch_size();
+        self.stmt.execute_streaming(arrow_batch_size)?;
         Ok(Arrow::new(self))
     }
 
+    /// Execute the prepared statement, returning the result as an Arrow C
+    /// stream.
+    ///
+    /// The schema is exchanged once and every batch is produced by DuckDB as
+    /// the reader pulls it, which makes it a good fit for handing results to
+    /// other Arrow consumers. The reader owns the result: it stays valid after
+    /// the statement is dropped, but running another query on the same
+    /// connection ends the stream early.
+    ///
+    /// ## Example
+    ///
+    /// ```rust,no_run
+    /// # use duckdb::{Result, Connection};
+    /// # use arrow::record_batch::RecordBatch;
+    /// fn get_arrow_data(conn: &Connection) -> Result<Vec<RecordBatch>> {
+    ///     let reader = conn.prepare("SELECT * FROM test")?.stream_arrow([])?;
+    ///     Ok(reader.map(|rb| rb.unwrap()).collect())
+    /// }
+    /// ```
+    ///
+    /// # Failure
+    ///
+    /// Will return `Err` if binding parameters fails.
+    #[inline]
+    pub fn stream_arrow<P: Params>(&mut self, params: P) -> Result<ArrowArrayStreamReader> {
+        params.__bind_in(self)?;
+        let arrow_batch_size = self.arrow_batch_size();
+        self.stmt.execute_arrow_stream(arrow_batch_size)
+    }
+
+    /// Execute the prepared statement, returning a handle to the resulting
+    /// Arrow record batches, converted in parallel.
+    ///
+    /// Unlike [`query_arrow`](Statement::query_arrow) the result is first
+    /// materialized, then converted to Arrow on the DuckDB worker threads
+    /// while the batches are consumed, so exporting a large result is not
+    /// bound by a single core. The batches are still returned in the order of
+    /// the result. Batches hold whole DuckDB vectors: with a batch size below
+    /// one vector, every batch holds one vector.
+    ///
+    /// ## Example
+    ///
+    /// ```rust,no_run
+    /// # use duckdb::{Result, Connection};
+    /// # use arrow::record_batch::RecordBatch;
+    /// fn get_arrow_data(conn: &Connection) -> Result<Vec<RecordBatch>> {
+    ///     let mut stmt = conn.prepare("SELECT * FROM test")?;
+    ///     stmt.set_arrow_batch_size(64 * 1024);
+    ///     let batches = stmt.query_arrow_parallel([])?.collect();
+    ///     Ok(batches)
+    /// }
+    /// ```
+    ///
+    /// # Failure
+    ///
+    /// Will return `Err` if binding parameters fails.
+    #[inline]
+    pub fn query_arrow_parallel<P: Params>(&mut self, params: P) -> Result<Arrow<'_>> {
+        params.__bind_in(self)?;
+        let arrow_batch_size = self.arrow_batch_size();
+        self.stmt.execute_parallel(arrow_batch_size)?;
+        Ok(Arrow::new(self))
+    }
+
+    /// Set how long every execution of this statement may run, `None` (the
+    /// default) for no limit.
+    ///
+    /// Once the timeout has passed, the query is interrupted within one of
+    /// its tasks and fails with an `ErrorCode::OperationInterrupted` error,
+    /// freeing the threads and memory it held. For a streaming result the
+    /// timeout also covers fetching it: fetching fails once it has passed.
+    /// [`stream_arrow`](Statement::stream_arrow) readers are only covered
+    /// until their first batch is ready.
+    ///
+    /// ## Example
+    ///
+    /// ```rust,no_run
+    /// # use duckdb::{Connection, Result};
+    /// # use std::time::Duration;
+    /// fn count(conn: &Connection) -> Result<i64> {
+    ///     let mut stmt = conn.prepare("SELECT count(*) FROM big_table")?;
+    ///     stmt.set_timeout(Some(Duration::from_secs(10)));
+    ///     stmt.query_row([], |row| row.get(0))
+    /// }
+    /// ```
+    #[inline]
+    pub fn set_timeout(&mut self, timeout: Option<Duration>) {
+        self.stmt.set_timeout(timeout);
+    }
+
+    /// Register a handler called with the progress of every execution of this
+    /// statement, as a percentage between 0 and 100, or `None` (the default)
+    /// to remove it.
+    ///
+    /// The handler is called between the tasks of the query, on the thread
+    /// executing it. If it returns `true`, the query is interrupted and fails
+    /// with an `ErrorCode::OperationInterrupted` error. Setting a handler
+    /// enables the progress tracking of the connection, for all its queries
+    /// from then on. To follow a query from another thread instead, see
+    /// [`InterruptHandle::query_progress`](crate::InterruptHandle::query_progress).
+    ///
+    /// ## Example
+    ///
+    /// ```rust,no_run
+    /// # use duckdb::{Connection, Result};
+    /// fn count(conn: &Connection) -> Result<i64> {
+    ///     let mut stmt = conn.prepare("SELECT count(*) FROM big_table")?;
+    ///     stmt.set_progress_handler(Some(|progress: f64| {
+    ///         println!("{:.0}%", progress);
+    ///         false
+    ///     }));
+    ///     stmt.query_row([], |row| row.get(0))
+    /// }
+    /// ```
+    #[inline]
+    pub fn set_progress_handler<F>(&mut self, handler: Option<F>)
+    where
+        F: FnMut(f64) -> bool + 'static,
+    {
+        self.stmt
+            .set_progress_handler(handler.map(|handler| Box::new(handler) as Box<dyn FnMut(f64) -> bool>));
+    }
+
+    /// Set the maximum number of rows of the Arrow record batches produced by
+    /// [`query_arrow`](Statement::query_arrow) and
+    /// [`stream_arrow`](Statement::stream_arrow), overriding
+    /// [`Connection::set_arrow_batch_size`] for this statement.
+    ///
+    /// Larger batches amortize the per-batch overhead of the consumer, at the
+    /// cost of buffering more rows at once. A size of 0 is treated as 1.
+    #[inline]
+    pub fn set_arrow_batch_size(&mut self, batch_size: usize) {
+        self.stmt.set_arrow_batch_size(batch_size);
+    }
+
+    #[inline]
+    fn arrow_batch_size(&self) -> Option<usize> {
+        self.stmt
+            .arrow_batch_size()
+            .or_else(|| self.conn.arrow_batch_size.get())
+    }
+
+    /// Execute the prepared statement, returning a handle to the resulting
+    /// DuckDB data chunks.
+    ///
+    /// This skips the conversion to Arrow entirely: the values are read in
+    /// place from the DuckDB vectors, which suits consumers that don't need
+    /// Arrow. The result is materialized.
+    ///
+    /// ## Example
+    ///
+    /// ```rust,no_run
+    /// # use duckdb::{Connection, Result};
+    /// fn sum(conn: &Connection) -> Result<i64> {
+    ///     let mut stmt = conn.prepare("SELECT x FROM test")?;
+    ///     let mut chunks = stmt.query_chunks([])?;
+    ///     let mut sum = 0;
+    ///     while let Some(chunk) = chunks.next() {
+    ///         let vector = chunk.vector(0);
+    ///         let values = vector.values::<i64>().unwrap();
+    ///         sum += (0..vector.len()).filter(|&i| vector.is_valid(i)).map(|i| values[i]).sum::<i64>();
+    ///     }
+    ///     Ok(sum)
+    /// }
+    /// ```
+    ///
+    /// # Failure
+    ///
+    /// Will return `Err` if binding parameters fails.
+    #[inline]
+    pub fn query_chunks<P: Params>(&mut self, params: P) -> Result<Chunks<'_>> {
+        params.__bind_in(self)?;
+        let result = self.stmt.execute_result()?;
+        Ok(Chunks::new(result))
+    }
+
     /// Execute the prepared statement, returning a handle to the resulting
     /// rows.
     ///
@@ -118,6 +371,11 @@ impl Statement<'_> {
     /// [`query_map`](Statement::query_map) or
     /// [`query_and_then`](Statement::query_and_then) instead, which do.
     ///
+    /// The result is streamed: rows are produced by DuckDB as they are
+    /// consumed rather than materialized up front. Running another query on
+    /// the same connection invalidates the returned rows, so finish reading
+    /// them (or drop them) first.
+    ///
     /// ## Example
     ///
     /// ### Use without parameters
@@ -170,10 +428,126 @@ impl Statement<'_> {
     /// Will return `Err` if binding parameters fails.
     #[inline]
     pub fn query<P: Params>(&mut self, params: P) -> Result<Rows<'_>> {
-        self.execute(params)?;
+        params.__bind_in(self)?;
+        self.stmt.execute_streaming(None)?;
         Ok(Rows::new(self))
     }
 
+    /// Execute the prepared statement without blocking, returning a future
+    /// of the resulting rows.
+    ///
+    /// The query runs while the future is polled, one DuckDB task per poll,
+    /// yielding to the executor in between; it doesn't depend on any
+    /// particular async runtime. The result is materialized before the future
+    /// completes, so that reading the rows afterwards doesn't run the query.
+    ///
+    /// While the query only waits on DuckDB's own threads, the future backs
+    /// off instead of asking to be polled again at once: it wakes itself
+    /// from a helper thread, started on the first wait, after up to 5 ms.
+    /// That costs one extra thread per waiting query and can delay the
+    /// result by as much, in exchange for not spinning the executor.
+    ///
+    /// Dropping the future before it completes abandons the query.
+    ///
+    /// ## Example
+    ///
+    /// ```rust,no_run
+    /// # use duckdb::{Connection, Result};
+    /// async fn get_names(conn: &Connection) -> Result<Vec<String>> {
+    ///     let mut stmt = conn.prepare("SELECT name FROM people")?;
+    ///     let mut rows = stmt.query_async([]).await?;
+    ///
+    ///     let mut names = Vec::new();
+    ///     while let Some(row) = rows.next()? {
+    ///         names.push(row.get(0)?);
+    ///     }
+    ///     Ok(names)
+    /// }
+    /// ```
+    ///
+    /// ## Failure
+    ///
+    /// The future resolves to `Err` if binding parameters or the query fails.
+    pub fn query_async<P: Params>(&mut self, params: P) -> PendingQuery<'_, 'conn> {
+        if let Err(error) = params.__bind_in(self) {
+            return PendingQuery::failed(error);
+        }
+        if let Err(error) = self.stmt.start_pending(false) {
+            return PendingQuery::failed(error);
+        }
+        PendingQuery::new(self)
+    }
+
+    /// Executes the prepared statement, returning the whole result as
+    /// columns.
+    ///
+    /// The columns are copied out of the Arrow record batches a batch at a
+    /// time instead of converting every value on its own, see
+    /// [`FromColumn`](crate::types::FromColumn). The `n`th `Vec` of the tuple
+    /// holds the `n`th column of the result, extra columns are ignored.
+    ///
+    /// ## Example
+    ///
+    /// ```rust,no_run
+    /// # use duckdb::{Connection, Result};
+    /// fn get_prices(conn: &Connection) -> Result<(Vec<i64>, Vec<f64>)> {
+    ///     let mut stmt = conn.prepare("SELECT id, price FROM items")?;
+    ///     stmt.query_columns([])
+    /// }
+    /// ```
+    ///
+    /// ## Failure
+    ///
+    /// Will return `Err` if binding parameters fails, or if a column can't be
+    /// converted to the element type of its `Vec`.
+    pub fn query_columns<C: Columns, P: Params>(&mut self, params: P) -> Result<C> {
+        params.__bind_in(self)?;
+        let arrow_batch_size = self.arrow_batch_size();
+        self.stmt.execute_streaming(arrow_batch_size)?;
+        let mut columns = C::default();
+        while let Some(batch) = self.stmt.step()? {
+            columns.extend_from_batch(&ColumnBatch::new(&batch, self))?;
+        }
+        Ok(columns)
+    }
+
+    /// Executes the prepared statement, returning the rows as structs
+    /// declared with [`from_columns!`](crate::from_columns).
+    ///
+    /// Like [`query_columns`](Statement::query_columns), every batch is read
+    /// a column at a time.
+    ///
+    /// ## Example
+    ///
+    /// ```rust,no_run
+    /// # use duckdb::{Connection, Result};
+    /// duckdb::from_columns! {
+    ///     struct Item {
+    ///         id: i64,
+    ///         price: f64,
+    ///     }
+    /// }
+    ///
+    /// fn get_items(conn: &Connection) -> Result<Vec<Item>> {
+    ///     conn.prepare("SELECT id, price FROM items")?.query_as([])
+    /// }
+    /// ```
+    ///
+    /// ## Failure
+    ///
+    /// Will return `Err` if binding parameters fails, or if a field has no
+    /// column of the same name or can't be converted from it.
+    pub fn query_as<T: FromColumns, P: Params>(&mut self, params: P) -> Result<Vec<T>> {
+        params.__bind_in(self)?;
+        let arrow_batch_size = self.arrow_batch_size();
+        self.stmt.execute_streaming(arrow_batch_size)?;
+        let mut rows = Vec::new();
+        while let Some(batch) = self.stmt.step()? {
+            T::extend_from_batch(&mut rows, &ColumnBatch::new(&batch, self))?;
+        }
+        Ok(rows)
+    }
+
     /// Executes the prepared statement and maps a function over the resulting
     /// rows, returning an iterator over the mapped function results.
     ///
@@ -283,14 +657,22 @@ impl Statement<'_> {
     }
 
     /// Return the row count
+    ///
+    /// For a streaming result (see [`query`](Statement::query)) this is the
+    /// number of rows fetched so far.
     #[inline]
     pub fn row_count(&self) -> usize {
         self.stmt.row_count()
     }
 
-    /// Get next batch records
+    /// Get next batch records, `None` once the result is exhausted
+    ///
+    /// # Failure
+    ///
+    /// Will return `Err` if the query fails while the batch is fetched, e.g.
+    /// for a streaming result, or if its timeout has passed
     #[inline]
-    pub fn step(&self) -> Option<StructArray> {
+    pub fn step(&self) -> Result<Option<StructArray>> {
         self.stmt.step()
     }
 
@@ -411,7 +793,6 @@ impl Statement<'_> {
             ToSqlOutput::Borrowed(v) => v,
             ToSqlOutput::Owned(ref v) => ValueRef::from(v),
         };
-        // TODO: bind more
         let rc = match value {
             ValueRef::Null => unsafe { ffi::duckdb_bind_null(ptr, col as u64) },
             ValueRef::Boolean(i) => unsafe { ffi::duckdb_bind_boolean(ptr, col as u64, i) },
@@ -419,22 +800,36 @@ impl Statement<'_> {
             ValueRef::SmallInt(i) => unsafe { ffi::duckdb_bind_int16(ptr, col as u64, i) },
             ValueRef::Int(i) => unsafe { ffi::duckdb_bind_int32(ptr, col as u64, i) },
             ValueRef::BigInt(i) => unsafe { ffi::duckdb_bind_int64(ptr, col as u64, i) },
-            ValueRef::HugeInt(i) => unsafe {
-                let hi = ffi::duckdb_hugeint {
-                    lower: i as u64,
-                    upper: (i >> 64) as i64,
-                };
-                ffi::duckdb_bind_hugeint(ptr, col as u64, hi)
-            },
+            ValueRef::HugeInt(i) => unsafe { ffi::duckdb_bind_hugeint(ptr, col as u64, hugeint_to_ffi(i)) },
+            ValueRef::UTinyInt(i) => unsafe { ffi::duckdb_bind_uint8(ptr, col as u64, i) },
+            ValueRef::USmallInt(i) => unsafe { ffi::duckdb_bind_uint16(ptr, col as u64, i) },
+            ValueRef::UInt(i) => unsafe { ffi::duckdb_bind_uint32(ptr, col as u64, i) },
+            ValueRef::UBigInt(i) => unsafe { ffi::duckdb_bind_uint64(ptr, col as u64, i) },
             ValueRef::Float(r) => unsafe { ffi::duckdb_bind_float(ptr, col as u64, r) },
             ValueRef::Double(r) => unsafe { ffi::duckdb_bind_double(ptr, col as u64, r) },
+            ValueRef::Decimal(d) => unsafe { ffi::duckdb_bind_decimal(ptr, col as u64, decimal_to_ffi(d)) },
+            ValueRef::Timestamp(unit, t) => unsafe {
+                let ts = ffi::duckdb_timestamp {
+                    micros: unit.to_micros(t)?,
+                };
+                ffi::duckdb_bind_timestamp(ptr, col as u64, ts)
+            },
+            ValueRef::Date32(days) => unsafe { ffi::duckdb_bind_date(ptr, col as u64, ffi::duckdb_date { days }) },
+            ValueRef::Time64(unit, t) => unsafe {
+                ffi::duckdb_bind_time(
+                    ptr,
+                    col as u64,
+                    ffi::duckdb_time {
+                        micros: unit.to_micros(t)?,
+                    },
+                )
+            },
             ValueRef::Text(s) => unsafe {
                 ffi::duckdb_bind_varchar_length(ptr, col as u64, s.as_ptr() as *const c_char, s.len() as u64)
             },
             ValueRef::Blob(b) => unsafe {
                 ffi::duckdb_bind_blob(ptr, col as u64, b.as_ptr() as *const c_void, b.len() as u64)
             },
-            _ => unreachable!("not supported"),
         };
         result_from_duckdb_prepare(rc, ptr)
     }
@@ -525,6 +920,214 @@ mod test {
         Ok(())
     }
 
+    #[test]
+    fn test_bind_native_types() -> Result<()> {
+        use crate::types::{TimeUnit, Value};
+        use rust_decimal::Decimal;
+
+        let db = Connection::open_in_memory()?;
+        db.execute_batch("CREATE TABLE foo(ub UBIGINT, d DECIMAL(18, 3), ts TIMESTAMP, t TIME)")?;
+        db.execute(
+            "INSERT INTO foo VALUES (?, ?, ?, ?)",
+            crate::params![
+                u64::MAX,
+                Decimal::new(-123456, 2),
+                Value::Timestamp(TimeUnit::Second, 1_649_519_797),
+                Value::Time64(TimeUnit::Nanosecond, 57_397_544_000_999),
+            ],
+        )?;
+        let (ub, d, ts, t): (u64, String, String, String) =
+            db.query_row("SELECT ub, d::VARCHAR, ts::VARCHAR, t::VARCHAR FROM foo", [], |r| {
+                Ok((r.get(0)?, r.get(1)?, r.get(2)?, r.get(3)?))
+            })?;
+        assert_eq!(ub, u64::MAX);
+        assert_eq!(d, "-1234.560");
+        assert_eq!(ts, "2022-04-09 15:56:37");
+        // truncated to microseconds
+        assert_eq!(t, "15:56:37.544");
+
+        let count: i64 = db.query_row("SELECT count(*) FROM foo WHERE d < ?", [Decimal::new(-1, 0)], |r| {
+            r.get(0)
+        })?;
+        assert_eq!(count, 1);
+
+        // nanoseconds before the epoch round down, not toward it
+        let ts: String = db.query_row(
+            "SELECT ?::TIMESTAMP::VARCHAR",
+            [Value::Timestamp(TimeUnit::Nanosecond, -1)],
+            |r| r.get(0),
+        )?;
+        assert_eq!(ts, "1969-12-31 23:59:59.999999");
+        let overflow = db.query_row(
+            "SELECT ?::TIMESTAMP::VARCHAR",
+            [Value::Timestamp(TimeUnit::Second, i64::MIN)],
+            |r| r.get::<_, String>(0),
+        );
+        assert!(matches!(overflow, Err(Error::ToSqlConversionFailure(_))));
+        Ok(())
+    }
+
+    #[test]
+    fn test_execute_columns_insert() -> Result<()> {
+        let db = Connection::open_in_memory()?;
+        db.execute_batch("CREATE TABLE foo(id BIGINT, name VARCHAR, flag INTEGER DEFAULT 7)")?;
+
+        let len = 3000;
+        let ids: Vec<i64> = (0..len).collect();
+        let names: Vec<Option<String>> = (0..len)
+            .map(|i| if i % 3 == 0 { None } else { Some(format!("name {}", i)) })
+            .collect();
+        // parameters in another order than the columns, and an expression
+        let mut stmt = db.prepare("INSERT INTO foo (name, id) VALUES (upper(?), ? + 1)")?;
+        assert_eq!(stmt.execute_columns(&[&names, &ids])?, len as usize);
+        assert_eq!(
+            stmt.execute_columns(&[&Vec::<Option<String>>::new(), &Vec::<i64>::new()])?,
+            0
+        );
+
+        let (count, sum, nulls, flags): (i64, i64, i64, i64) = db.query_row(
+            "SELECT count(*), sum(id)::BIGINT, count(*) - count(name), sum(flag)::BIGINT FROM foo",
+            [],
+            |r| Ok((r.get(0)?, r.get(1)?, r.get(2)?, r.get(3)?)),
+        )?;
+        assert_eq!(count, len);
+        assert_eq!(sum, (1..=len).sum::<i64>());
+        assert_eq!(nulls, len / 3);
+        assert_eq!(flags, 7 * len);
+        let name: String = db.query_row("SELECT name FROM foo WHERE id = 3", [], |r| r.get(0))?;
+        assert_eq!(name, "NAME 2");
+
+        // no temporary table is left behind
+        let temporary: i64 = db.query_row("SELECT count(*) FROM duckdb_tables() WHERE temporary", [], |r| r.get(0))?;
+        assert_eq!(temporary, 0);
+        Ok(())
+    }
+
+    #[test]
+    fn test_execute_columns_in_transaction() -> Result<()> {
+        let mut db = Connection::open_in_memory()?;
+        db.execute_batch("CREATE TABLE foo(id INTEGER)")?;
+        let ids: Vec<i32> = (0..1000).collect();
+
+        let tx = db.transaction()?;
+        assert_eq!(
+            tx.prepare("INSERT INTO foo VALUES (?)")?.execute_columns(&[&ids])?,
+            1000
+        );
+        // the rows are part of the transaction
+        let count: i64 = tx.query_row("SELECT count(*) FROM foo", [], |r| r.get(0))?;
+        assert_eq!(count, 1000);
+        tx.rollback()?;
+        let count: i64 = db.query_row("SELECT count(*) FROM foo", [], |r| r.get(0))?;
+        assert_eq!(count, 0);
+
+        let tx = db.transaction()?;
+        assert_eq!(
+            tx.prepare("INSERT INTO foo VALUES (?)")?.execute_columns(&[&ids])?,
+            1000
+        );
+        assert_eq!(
+            tx.prepare("INSERT INTO foo VALUES (?)")?.execute_columns(&[&ids])?,
+            1000
+        );
+        tx.commit()?;
+        let count: i64 = db.query_row("SELECT count(*) FROM foo", [], |r| r.get(0))?;
+        assert_eq!(count, 2000);
+        Ok(())
+    }
+
+    #[test]
+    fn test_execute_columns_quoted_identifiers() -> Result<()> {
+        let db = Connection::open_in_memory()?;
+        db.execute_batch(r#"CREATE TABLE "values ?" ("VALUES" INTEGER, "(?)" VARCHAR)"#)?;
+        let ids: Vec<i32> = (0..1000).collect();
+        let names: Vec<String> = (0..1000).map(|i| format!("name {}", i)).collect();
+
+        // identifiers, comments and strings that look like the values and parameters
+        let mut stmt = db.prepare(
+            r#"INSERT INTO "values ?" ("(?)", "VALUES") /* VALUES (?) */ VALUES (? || ' (?)', -- ?
+            ? * 2)"#,
+        )?;
+        assert_eq!(stmt.execute_columns(&[&names, &ids])?, 1000);
+        let (count, sum): (i64, i64) =
+            db.query_row(r#"SELECT count(*), sum("VALUES")::BIGINT FROM "values ?""#, [], |r| {
+                Ok((r.get(0)?, r.get(1)?))
+            })?;
+        assert_eq!(count, 1000);
+        assert_eq!(sum, 2 * (0..1000).sum::<i64>());
+        let name: String = db.query_row(r#"SELECT "(?)" FROM "values ?" WHERE "VALUES" = 20"#, [], |r| r.get(0))?;
+        assert_eq!(name, "name 10 (?)");
+        Ok(())
+    }
+
+    #[test]
+    fn test_execute_columns_row_by_row() -> Result<()> {
+        let db = Connection::open_in_memory()?;
+        db.execute_batch("CREATE TABLE foo(id INTEGER, x INTEGER); INSERT INTO foo SELECT range, 0 FROM range(100)")?;
+
+        let mut stmt = db.prepare("UPDATE foo SET x = ? WHERE id >= ? AND id < ?")?;
+        let values = vec![1, 2, 3];
+        let starts = vec![0, 10, 90];
+        let ends = vec![10, 20, 200];
+        assert_eq!(stmt.execute_columns(&[&values, &starts, &ends])?, 30);
+        let sum: i64 = db.query_row("SELECT sum(x)::BIGINT FROM foo", [], |r| r.get(0))?;
+        assert_eq!(sum, 10 + 20 + 30);
+
+        // a failing row rolls back the ones before it
+        db.execute_batch("CREATE TABLE bar(id INTEGER PRIMARY KEY)")?;
+        let mut stmt = db.prepare("INSERT INTO bar SELECT ?")?;
+        assert!(stmt.execute_columns(&[&vec![1, 2, 1]]).is_err());
+        let count: i64 = db.query_row("SELECT count(*) FROM bar", [], |r| r.get(0))?;
+        assert_eq!(count, 0);
+
+        let mut stmt = db.prepare("INSERT INTO bar VALUES (?)")?;
+        assert!(matches!(
+            stmt.execute_columns(&[&values, &values]),
+            Err(Error::InvalidParameterCount(2, 1))
+        ));
+        Ok(())
+    }
+
+    #[test]
+    fn test_execute_record_batch() -> Result<()> {
+        use arrow::array::{Int32Array, StringArray};
+        use arrow::datatypes::{DataType, Field, Schema};
+        use arrow::record_batch::RecordBatch;
+        use std::sync::Arc;
+
+        let db = Connection::open_in_memory()?;
+        db.execute_batch("CREATE TABLE foo(id BIGINT, name VARCHAR)")?;
+
+        let len = 2500;
+        let schema = Schema::new(vec![
+            Field::new("id", DataType::Int32, false),
+            Field::new("name", DataType::Utf8, true),
+        ]);
+        let batch = RecordBatch::try_new(
+            Arc::new(schema),
+            vec![
+                Arc::new(Int32Array::from((0..len).collect::<Vec<_>>())),
+                Arc::new(StringArray::from(
+                    (0..len)
+                        .map(|i| if i % 2 == 0 { Some("even") } else { None })
+                        .collect::<Vec<_>>(),
+                )),
+            ],
+        )
+        .unwrap();
+        let mut stmt = db.prepare("INSERT INTO foo VALUES (?, ?)")?;
+        assert_eq!(stmt.execute_record_batch(&batch)?, len as usize);
+
+        let (count, sum, evens): (i64, i64, i64) =
+            db.query_row("SELECT count(*), sum(id)::BIGINT, count(name) FROM foo", [], |r| {
+                Ok((r.get(0)?, r.get(1)?, r.get(2)?))
+            })?;
+        assert_eq!(count, len as i64);
+        assert_eq!(sum, (0..len as i64).sum::<i64>());
+        assert_eq!(evens, len as i64 / 2);
+        Ok(())
+    }
+
     #[test]
     fn test_query() -> Result<()> {
         let db = Connection::open_in_memory()?;
@@ -543,6 +1146,72 @@ mod test {
         Ok(())
     }
 
+    #[test]
+    fn test_query_streaming() -> Result<()> {
+        let db = Connection::open_in_memory()?;
+        let mut stmt = db.prepare("SELECT i FROM range(0, 10000) t(i)")?;
+        let mut rows = stmt.query([])?;
+        let (mut count, mut sum) = (0usize, 0i64);
+        while let Some(row) = rows.next()? {
+            count += 1;
+            sum += row.get::<_, i64>(0)?;
+        }
+        assert_eq!(count, 10000);
+        assert_eq!(sum, 49995000);
+        // a streaming result only knows the rows fetched so far
+        assert_eq!(stmt.row_count(), 10000);
+        Ok(())
+    }
+
+    #[test]
+    fn test_query_arrow_parallel() -> Result<()> {
+        use arrow::array::{Array, Int64Array};
+
+        let db = Connection::open_in_memory()?;
+        let mut stmt = db.prepare("SELECT i FROM range(0, 100000) t(i) ORDER BY i")?;
+        stmt.set_arrow_batch_size(4096);
+        let mut expected = 0i64;
+        for rb in stmt.query_arrow_parallel([])? {
+            assert!(rb.num_rows() <= 4096);
+            let column = rb.column(0).as_any().downcast_ref::<Int64Array>().unwrap();
+            for value in column.values().iter() {
+                assert_eq!(*value, expected);
+                expected += 1;
+            }
+        }
+        assert_eq!(expected, 100000);
+
+        // executing again half way through cancels the pending conversions
+        let mut arrow = stmt.query_arrow_parallel([])?;
+        assert!(arrow.next().is_some());
+        drop(arrow);
+        assert_eq!(
+            stmt.query_arrow_parallel([])?.map(|rb| rb.num_rows()).sum::<usize>(),
+            100000
+        );
+        Ok(())
+    }
+
+    #[test]
+    fn test_stream_arrow() -> Result<()> {
+        use arrow::array::{Array, Int64Array};
+        use arrow::datatypes::DataType;
+
+        let db = Connection::open_in_memory()?;
+        let reader = db.prepare("SELECT i FROM range(0, 3000) t(i)")?.stream_arrow([])?;
+        assert_eq!(reader.schema().field(0).data_type(), &DataType::Int64);
+        let (mut count, mut sum) = (0usize, 0i64);
+        for batch in reader {
+            let batch = batch.unwrap();
+            let column = batch.column(0).as_any().downcast_ref::<Int64Array>().unwrap();
+            count += column.len();
+            sum += column.values().iter().sum::<i64>();
+        }
+        assert_eq!(count, 3000);
+        assert_eq!(sum, 4498500);
+        Ok(())
+    }
+
     #[test]
     fn test_query_and_then() -> Result<()> {
         let db = Connection::open_in_memory()?;
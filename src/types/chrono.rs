@@ -1,16 +1,17 @@
 //! Convert most of the [Time Strings](http://sqlite.org/lang_datefunc.html) to chrono types.
 
-use chrono::{DateTime, Local, NaiveDate, NaiveDateTime, NaiveTime, TimeZone, Utc};
+use chrono::{DateTime, Local, NaiveDate, NaiveDateTime, NaiveTime, TimeZone, Timelike, Utc};
 
-use crate::types::{FromSql, FromSqlError, FromSqlResult, TimeUnit, ToSql, ToSqlOutput, ValueRef};
+use crate::types::{FromSql, FromSqlError, FromSqlResult, TimeUnit, ToSql, ToSqlOutput, Value, ValueRef};
 use crate::Result;
 
-/// ISO 8601 calendar date without timezone => "YYYY-MM-DD"
+/// ISO 8601 calendar date without timezone => DuckDB date, in days since the
+/// epoch
 impl ToSql for NaiveDate {
     #[inline]
     fn to_sql(&self) -> Result<ToSqlOutput<'_>> {
-        let date_str = self.format("%F").to_string();
-        Ok(ToSqlOutput::from(date_str))
+        let days = self.signed_duration_since(NaiveDate::from_ymd(1970, 1, 1)).num_days();
+        Ok(ToSqlOutput::Owned(Value::Date32(days as i32)))
     }
 }
 
@@ -22,12 +23,13 @@ impl FromSql for NaiveDate {
     }
 }
 
-/// ISO 8601 time without timezone => "HH:MM:SS.SSS"
+/// ISO 8601 time without timezone => DuckDB time, in microseconds since
+/// midnight
 impl ToSql for NaiveTime {
     #[inline]
     fn to_sql(&self) -> Result<ToSqlOutput<'_>> {
-        let date_str = self.format("%T%.f").to_string();
-        Ok(ToSqlOutput::from(date_str))
+        let micros = self.num_seconds_from_midnight() as i64 * 1_000_000 + (self.nanosecond() / 1_000) as i64;
+        Ok(ToSqlOutput::Owned(Value::Time64(TimeUnit::Microsecond, micros)))
     }
 }
 
@@ -38,16 +40,23 @@ impl FromSql for NaiveTime {
     }
 }
 
-/// ISO 8601 combined date and time without timezone =>
-/// "YYYY-MM-DD HH:MM:SS.SSS"
+/// ISO 8601 combined date and time without timezone => DuckDB timestamp, in
+/// microseconds since the epoch
 impl ToSql for NaiveDateTime {
     #[inline]
     fn to_sql(&self) -> Result<ToSqlOutput<'_>> {
-        let date_str = self.format("%F %T%.f").to_string();
-        Ok(ToSqlOutput::from(date_str))
+        Ok(ToSqlOutput::Owned(Value::Timestamp(
+            TimeUnit::Microsecond,
+            timestamp_micros(self),
+        )))
     }
 }
 
+#[inline]
+fn timestamp_micros(dt: &NaiveDateTime) -> i64 {
+    dt.timestamp() * 1_000_000 + dt.timestamp_subsec_micros() as i64
+}
+
 /// "YYYY-MM-DD HH:MM:SS"/"YYYY-MM-DD HH:MM:SS.SSS" => ISO 8601 combined date
 /// and time without timezone. ("YYYY-MM-DDTHH:MM:SS"/"YYYY-MM-DDTHH:MM:SS.SSS"
 /// also supported)
@@ -57,9 +66,10 @@ impl FromSql for NaiveDateTime {
             ValueRef::Timestamp(tu, t) => {
                 let (secs, nsecs) = match tu {
                     TimeUnit::Second => (t, 0),
-                    TimeUnit::Millisecond => (t / 1000, (t % 1000) * 1_000_000),
-                    TimeUnit::Microsecond => (t / 1_000_000, (t % 1_000_000) * 1000),
-                    TimeUnit::Nanosecond => (t / 1_000_000_000, t % 1_000_000_000),
+                    // rounded down so the sub-second part stays positive before the epoch
+                    TimeUnit::Millisecond => (t.div_euclid(1000), t.rem_euclid(1000) * 1_000_000),
+                    TimeUnit::Microsecond => (t.div_euclid(1_000_000), t.rem_euclid(1_000_000) * 1000),
+                    TimeUnit::Nanosecond => (t.div_euclid(1_000_000_000), t.rem_euclid(1_000_000_000)),
                 };
                 Ok(NaiveDateTime::from_timestamp(secs, nsecs as u32))
             }
@@ -96,13 +106,14 @@ impl FromSql for NaiveDateTime {
     }
 }
 
-/// Date and time with time zone => UTC RFC3339 timestamp
-/// ("YYYY-MM-DD HH:MM:SS.SSS+00:00").
+/// Date and time with time zone => DuckDB timestamp of the UTC date and time
 impl<Tz: TimeZone> ToSql for DateTime<Tz> {
     #[inline]
     fn to_sql(&self) -> Result<ToSqlOutput<'_>> {
-        let date_str = self.with_timezone(&Utc).format("%F %T%.f%:z").to_string();
-        Ok(ToSqlOutput::from(date_str))
+        Ok(ToSqlOutput::Owned(Value::Timestamp(
+            TimeUnit::Microsecond,
+            timestamp_micros(&self.naive_utc()),
+        )))
     }
 }
 
@@ -125,6 +136,7 @@ impl FromSql for DateTime<Local> {
 #[cfg(test)]
 mod test {
     use crate::{
+        params,
         types::{FromSql, ValueRef},
         Connection, Result,
     };
@@ -230,6 +242,26 @@ mod test {
         Ok(())
     }
 
+    #[test]
+    fn test_append_chrono() -> Result<()> {
+        let db = checked_memory_handle()?;
+        let date = NaiveDate::from_ymd(2021, 7, 20);
+        let time = NaiveTime::from_hms_micro(20, 17, 40, 123_456);
+        let dt = NaiveDateTime::new(date, time);
+        {
+            let mut app = db.appender("foo")?;
+            app.append_row(params![date, "", 0, 0.0, dt, time])?;
+        }
+
+        let (d, b, tt): (NaiveDate, NaiveDateTime, NaiveTime) = db.query_row("SELECT d, b, tt FROM foo", [], |r| {
+            Ok((r.get(0)?, r.get(1)?, r.get(2)?))
+        })?;
+        assert_eq!((d, b, tt), (date, dt, time));
+        let s: String = db.query_row("SELECT b::VARCHAR FROM foo", [], |r| r.get(0))?;
+        assert_eq!(s, "2021-07-20 20:17:40.123456");
+        Ok(())
+    }
+
     #[test]
     fn test_duckdb_datetime_functions() -> Result<()> {
         let db = checked_memory_handle()?;
@@ -269,6 +301,28 @@ mod test {
         Ok(())
     }
 
+    #[test]
+    fn test_date_time_before_epoch() -> Result<()> {
+        let db = checked_memory_handle()?;
+        let date = NaiveDate::from_ymd(1969, 12, 31);
+        let time = NaiveTime::from_hms_micro(23, 59, 59, 999_999);
+        let dt = NaiveDateTime::new(date, time);
+        let s: String = db.query_row("SELECT ?::TIMESTAMP::VARCHAR", [dt], |r| r.get(0))?;
+        assert_eq!(s, "1969-12-31 23:59:59.999999");
+        let v: NaiveDateTime = db.query_row("SELECT ?::TIMESTAMP", [dt], |r| r.get(0))?;
+        assert_eq!(v, dt);
+
+        let utc = Utc.from_utc_datetime(&NaiveDateTime::new(
+            NaiveDate::from_ymd(1900, 1, 1),
+            NaiveTime::from_hms_micro(0, 0, 0, 500_000),
+        ));
+        let s: String = db.query_row("SELECT ?::TIMESTAMP::VARCHAR", [utc], |r| r.get(0))?;
+        assert_eq!(s, "1900-01-01 00:00:00.5");
+        let v: DateTime<Utc> = db.query_row("SELECT ?::TIMESTAMP", [utc], |r| r.get(0))?;
+        assert_eq!(v, utc);
+        Ok(())
+    }
+
     #[test]
     #[ignore]
     fn test_lenient_parse_timezone() {
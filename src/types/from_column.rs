@@ -0,0 +1,386 @@
+use arrow::array::{
+    Array, ArrayRef, BinaryArray, BooleanArray, Decimal128Array, Float32Array, Float64Array, Int16Array, Int32Array,
+    Int64Array, Int8Array, LargeBinaryArray, LargeStringArray, StringArray, StructArray, UInt16Array, UInt32Array,
+    UInt64Array, UInt8Array,
+};
+use arrow::datatypes::DataType;
+
+use super::{FromSqlError, FromSqlResult, Type};
+use crate::{Error, Result, RowIndex, Statement};
+
+/// A trait for types whose values can be copied out of a whole column at
+/// once, see [`Statement::query_columns`].
+///
+/// Unlike [`FromSql`](crate::types::FromSql), which converts one value at a
+/// time, implementations convert a whole Arrow array per call, so that
+/// primitive columns are copied straight out of the Arrow buffers.
+pub trait FromColumn: Sized {
+    /// Whether NULLs can be represented, `true` for `Option<T>`. Extracting a
+    /// column holding NULLs into a type that can't represent them fails with
+    /// `Error::InvalidColumnType`.
+    const NULLABLE: bool = false;
+
+    /// Appends the values of `array` to `out`. The values of NULL slots are
+    /// unspecified unless the type is [`NULLABLE`](FromColumn::NULLABLE).
+    fn extend_from_array(out: &mut Vec<Self>, array: &ArrayRef) -> FromSqlResult<()>;
+}
+
+// The first array type is copied as is, the others are widened losslessly.
+macro_rules! from_column_primitive(
+    ($t:ty: $exact:ty $(, $wider:ty)*) => (
+        impl FromColumn for $t {
+            #[inline]
+            fn extend_from_array(out: &mut Vec<Self>, array: &ArrayRef) -> FromSqlResult<()> {
+                let array = array.as_any();
+                if let Some(array) = array.downcast_ref::<$exact>() {
+                    out.extend_from_slice(array.values());
+                    return Ok(());
+                }
+                $(
+                    if let Some(array) = array.downcast_ref::<$wider>() {
+                        out.extend(array.values().iter().map(|&v| v as $t));
+                        return Ok(());
+                    }
+                )*
+                Err(FromSqlError::InvalidType)
+            }
+        }
+    )
+);
+
+from_column_primitive!(i8: Int8Array);
+from_column_primitive!(i16: Int16Array, Int8Array, UInt8Array);
+from_column_primitive!(i32: Int32Array, Int8Array, Int16Array, UInt8Array, UInt16Array);
+from_column_primitive!(i64: Int64Array, Int8Array, Int16Array, Int32Array, UInt8Array, UInt16Array, UInt32Array);
+from_column_primitive!(u8: UInt8Array);
+from_column_primitive!(u16: UInt16Array, UInt8Array);
+from_column_primitive!(u32: UInt32Array, UInt8Array, UInt16Array);
+from_column_primitive!(u64: UInt64Array, UInt8Array, UInt16Array, UInt32Array);
+from_column_primitive!(f32: Float32Array, Int8Array, Int16Array, UInt8Array, UInt16Array);
+from_column_primitive!(
+    f64: Float64Array,
+    Float32Array,
+    Int8Array,
+    Int16Array,
+    Int32Array,
+    UInt8Array,
+    UInt16Array,
+    UInt32Array
+);
+
+impl FromColumn for i128 {
+    #[inline]
+    fn extend_from_array(out: &mut Vec<Self>, array: &ArrayRef) -> FromSqlResult<()> {
+        match array.data_type() {
+            // hugeint: d:38,0
+            DataType::Decimal128(_, 0) => {
+                let array = array.as_any().downcast_ref::<Decimal128Array>().unwrap();
+                out.extend((0..array.len()).map(|i| i128::from(array.value(i))));
+                Ok(())
+            }
+            _ => {
+                let mut values = Vec::with_capacity(array.len());
+                i64::extend_from_array(&mut values, array)?;
+                out.extend(values.into_iter().map(i128::from));
+                Ok(())
+            }
+        }
+    }
+}
+
+impl FromColumn for bool {
+    #[inline]
+    fn extend_from_array(out: &mut Vec<Self>, array: &ArrayRef) -> FromSqlResult<()> {
+        let array = array
+            .as_any()
+            .downcast_ref::<BooleanArray>()
+            .ok_or(FromSqlError::InvalidType)?;
+        out.extend((0..array.len()).map(|i| array.value(i)));
+        Ok(())
+    }
+}
+
+impl FromColumn for String {
+    #[inline]
+    fn extend_from_array(out: &mut Vec<Self>, array: &ArrayRef) -> FromSqlResult<()> {
+        let array = array.as_any();
+        if let Some(array) = array.downcast_ref::<StringArray>() {
+            out.extend((0..array.len()).map(|i| array.value(i).to_owned()));
+        } else if let Some(array) = array.downcast_ref::<LargeStringArray>() {
+            out.extend((0..array.len()).map(|i| array.value(i).to_owned()));
+        } else {
+            return Err(FromSqlError::InvalidType);
+        }
+        Ok(())
+    }
+}
+
+impl FromColumn for Vec<u8> {
+    #[inline]
+    fn extend_from_array(out: &mut Vec<Self>, array: &ArrayRef) -> FromSqlResult<()> {
+        let array = array.as_any();
+        if let Some(array) = array.downcast_ref::<BinaryArray>() {
+            out.extend((0..array.len()).map(|i| array.value(i).to_vec()));
+        } else if let Some(array) = array.downcast_ref::<LargeBinaryArray>() {
+            out.extend((0..array.len()).map(|i| array.value(i).to_vec()));
+        } else {
+            return Err(FromSqlError::InvalidType);
+        }
+        Ok(())
+    }
+}
+
+impl<T: FromColumn> FromColumn for Option<T> {
+    const NULLABLE: bool = true;
+
+    #[inline]
+    fn extend_from_array(out: &mut Vec<Self>, array: &ArrayRef) -> FromSqlResult<()> {
+        if array.data_type() == &DataType::Null {
+            out.extend((0..array.len()).map(|_| None));
+            return Ok(());
+        }
+        let mut values = Vec::with_capacity(array.len());
+        T::extend_from_array(&mut values, array)?;
+        if array.null_count() == 0 {
+            out.extend(values.into_iter().map(Some));
+        } else {
+            out.extend(
+                values
+                    .into_iter()
+                    .enumerate()
+                    .map(|(i, value)| if array.is_valid(i) { Some(value) } else { None }),
+            );
+        }
+        Ok(())
+    }
+}
+
+/// A batch of rows of a query result, read a whole column at a time.
+pub struct ColumnBatch<'a> {
+    batch: &'a StructArray,
+    stmt: &'a Statement<'a>,
+}
+
+impl<'a> ColumnBatch<'a> {
+    #[inline]
+    pub(crate) fn new(batch: &'a StructArray, stmt: &'a Statement<'a>) -> ColumnBatch<'a> {
+        ColumnBatch { batch, stmt }
+    }
+
+    /// Number of rows of the batch.
+    #[inline]
+    pub fn len(&self) -> usize {
+        self.batch.len()
+    }
+
+    /// Returns `true` if the batch has no rows.
+    #[inline]
+    pub fn is_empty(&self) -> bool {
+        self.batch.len() == 0
+    }
+
+    /// Get the values of a column of the batch.
+    ///
+    /// ## Failure
+    ///
+    /// Returns an `Error::InvalidColumnType` if the column can't be converted
+    /// to `T`, or holds NULLs that `T` can't represent.
+    ///
+    /// Returns an `Error::InvalidColumnIndex` or `Error::InvalidColumnName`
+    /// if `idx` doesn't name a column of the result.
+    #[inline]
+    pub fn column<T: FromColumn, I: RowIndex>(&self, idx: I) -> Result<Vec<T>> {
+        let mut out = Vec::with_capacity(self.len());
+        self.extend_column(idx, &mut out)?;
+        Ok(out)
+    }
+
+    /// Appends the values of a column of the batch to `out`, see
+    /// [`column`](ColumnBatch::column).
+    pub fn extend_column<T: FromColumn, I: RowIndex>(&self, idx: I, out: &mut Vec<T>) -> Result<()> {
+        let idx = idx.idx(self.stmt)?;
+        let array = self.batch.column(idx);
+        if !T::NULLABLE && array.null_count() > 0 {
+            return Err(Error::InvalidColumnType(
+                idx,
+                self.stmt.column_name_unwrap(idx).into(),
+                Type::Null,
+            ));
+        }
+        T::extend_from_array(out, array).map_err(|err| match err {
+            FromSqlError::OutOfRange(i) => Error::IntegralValueOutOfRange(idx, i),
+            FromSqlError::Other(err) => Error::FromSqlConversionFailure(idx, array.data_type().into(), err),
+            _ => Error::InvalidColumnType(idx, self.stmt.column_name_unwrap(idx).into(), array.data_type().into()),
+        })
+    }
+}
+
+/// A trait for collections of whole columns, filled by
+/// [`Statement::query_columns`].
+///
+/// It is implemented for tuples of `Vec<T>` where `T` implements
+/// [`FromColumn`], the `n`th element holding the `n`th column of the result.
+pub trait Columns: Default {
+    /// Appends the rows of `batch` to the columns.
+    fn extend_from_batch(&mut self, batch: &ColumnBatch<'_>) -> Result<()>;
+}
+
+macro_rules! columns_tuple {
+    ($($field:ident $index:tt),*) => {
+        impl<$($field: FromColumn,)*> Columns for ($(Vec<$field>,)*) {
+            #[inline]
+            fn extend_from_batch(&mut self, batch: &ColumnBatch<'_>) -> Result<()> {
+                $(batch.extend_column($index, &mut self.$index)?;)*
+                Ok(())
+            }
+        }
+    }
+}
+
+columns_tuple!(A 0);
+columns_tuple!(A 0, B 1);
+columns_tuple!(A 0, B 1, C 2);
+columns_tuple!(A 0, B 1, C 2, D 3);
+columns_tuple!(A 0, B 1, C 2, D 3, E 4);
+columns_tuple!(A 0, B 1, C 2, D 3, E 4, F 5);
+columns_tuple!(A 0, B 1, C 2, D 3, E 4, F 5, G 6);
+columns_tuple!(A 0, B 1, C 2, D 3, E 4, F 5, G 6, H 7);
+columns_tuple!(A 0, B 1, C 2, D 3, E 4, F 5, G 6, H 7, I 8);
+columns_tuple!(A 0, B 1, C 2, D 3, E 4, F 5, G 6, H 7, I 8, J 9);
+columns_tuple!(A 0, B 1, C 2, D 3, E 4, F 5, G 6, H 7, I 8, J 9, K 10);
+columns_tuple!(A 0, B 1, C 2, D 3, E 4, F 5, G 6, H 7, I 8, J 9, K 10, L 11);
+
+/// A trait for structs that are built from the rows of a result a batch at a
+/// time, see [`Statement::query_as`].
+///
+/// Implement it with the [`from_columns!`](crate::from_columns) macro, which
+/// matches the fields to the columns of the same name.
+pub trait FromColumns: Sized {
+    /// Appends one value per row of `batch` to `out`.
+    fn extend_from_batch(out: &mut Vec<Self>, batch: &ColumnBatch<'_>) -> Result<()>;
+}
+
+/// Declares a struct and implements [`FromColumns`](crate::types::FromColumns)
+/// for it, so that [`Statement::query_as`](crate::Statement::query_as) can
+/// fill it.
+///
+/// Every field is read from the column of the same name (ignoring ASCII
+/// case), and its type must implement
+/// [`FromColumn`](crate::types::FromColumn). The columns of a batch are
+/// extracted one after the other, then zipped into the structs.
+///
+/// ```rust,no_run
+/// # use duckdb::{Connection, Result};
+/// duckdb::from_columns! {
+///     #[derive(Debug)]
+///     pub struct Person {
+///         pub id: i64,
+///         pub name: String,
+///         pub email: Option<String>,
+///     }
+/// }
+///
+/// fn people(conn: &Connection) -> Result<Vec<Person>> {
+///     conn.prepare("SELECT id, name, email FROM people")?.query_as([])
+/// }
+/// ```
+#[macro_export]
+macro_rules! from_columns {
+    (
+        $(#[$meta:meta])*
+        $vis:vis struct $name:ident {
+            $($(#[$field_meta:meta])* $field_vis:vis $field:ident : $ty:ty),* $(,)?
+        }
+    ) => {
+        $(#[$meta])*
+        $vis struct $name {
+            $($(#[$field_meta])* $field_vis $field: $ty,)*
+        }
+
+        impl $crate::types::FromColumns for $name {
+            fn extend_from_batch(
+                out: &mut ::std::vec::Vec<Self>,
+                batch: &$crate::types::ColumnBatch<'_>,
+            ) -> $crate::Result<()> {
+                $(let mut $field = batch.column::<$ty, _>(stringify!($field))?.into_iter();)*
+                out.reserve(batch.len());
+                for _ in 0..batch.len() {
+                    out.push($name { $($field: $field.next().unwrap(),)* });
+                }
+                Ok(())
+            }
+        }
+    };
+}
+
+#[cfg(test)]
+mod test {
+    use crate::types::Type;
+    use crate::{Connection, Error, Result};
+
+    crate::from_columns! {
+        #[derive(Debug, PartialEq)]
+        struct Item {
+            id: i64,
+            name: String,
+            price: Option<f64>,
+        }
+    }
+
+    fn items() -> Result<Connection> {
+        let db = Connection::open_in_memory()?;
+        db.execute_batch(
+            "CREATE TABLE items(id INTEGER, name TEXT, price DOUBLE);
+             INSERT INTO items SELECT i, 'item ' || i, CASE WHEN i % 3 = 0 THEN NULL ELSE i * 1.5 END
+             FROM range(0, 3000) t(i);",
+        )?;
+        Ok(db)
+    }
+
+    #[test]
+    fn test_query_columns() -> Result<()> {
+        let db = items()?;
+        let mut stmt = db.prepare("SELECT id, name, price FROM items ORDER BY id")?;
+        let (ids, names, prices): (Vec<i64>, Vec<String>, Vec<Option<f64>>) = stmt.query_columns([])?;
+        assert_eq!(ids.len(), 3000);
+        assert_eq!(ids, (0..3000).collect::<Vec<i64>>());
+        assert_eq!(names[2999], "item 2999");
+        assert_eq!(prices[0], None);
+        assert_eq!(prices[1], Some(1.5));
+
+        // NULLs need an Option
+        match stmt.query_columns::<(Vec<i64>, Vec<String>, Vec<f64>), _>([]) {
+            Err(Error::InvalidColumnType(2, name, Type::Null)) => assert_eq!(name, "price"),
+            r => panic!("Unexpected result: {:?}", r.map(|_| ())),
+        }
+        match stmt.query_columns::<(Vec<String>,), _>([]) {
+            Err(Error::InvalidColumnType(0, _, Type::Int)) => {}
+            r => panic!("Unexpected result: {:?}", r.map(|_| ())),
+        }
+        Ok(())
+    }
+
+    #[test]
+    fn test_query_as() -> Result<()> {
+        let db = items()?;
+        let items: Vec<Item> = db
+            .prepare("SELECT price, id AS \"ID\", name FROM items ORDER BY id")?
+            .query_as([])?;
+        assert_eq!(items.len(), 3000);
+        assert_eq!(
+            items[4],
+            Item {
+                id: 4,
+                name: "item 4".to_owned(),
+                price: Some(6.0)
+            }
+        );
+        assert_eq!(items[3].price, None);
+
+        match db.prepare("SELECT id, name FROM items")?.query_as::<Item, _>([]) {
+            Err(Error::InvalidColumnName(name)) => assert_eq!(name, "price"),
+            r => panic!("Unexpected result: {:?}", r.map(|_| ())),
+        }
+        Ok(())
+    }
+}
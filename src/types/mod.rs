@@ -23,10 +23,11 @@
 //! * `INTEGER` to float: casts using `as` operator. Never fails.
 //! * `REAL` to float: casts using `as` operator. Never fails.
 //!
-//! [`ToSql`] always succeeds except when storing a `u64` or `usize` value that
-//! cannot fit in an `INTEGER` (`i64`). Also note that DuckDB ignores column
-//! types, so if you store an `i64` in a column with type `REAL` it will be
-//! stored as an `INTEGER`, not a `REAL`.
+//! [`ToSql`] always succeeds. Unsigned integers are stored as DuckDB unsigned
+//! integers, decimals as `DECIMAL(38, s)` and `chrono` dates and times as
+//! native dates, times and timestamps, cast to the column type if needed.
+//! Also note that DuckDB ignores column types, so if you store an `i64` in a
+//! column with type `REAL` it will be stored as an `INTEGER`, not a `REAL`.
 //!
 //! If the `time` feature is enabled, implementations are
 //! provided for `time::OffsetDateTime` that use the RFC 3339 date/time format,
@@ -67,15 +68,19 @@ impl ToSql for DateTimeSql {
 //! implements [`ToSql`] or [`FromSql`] for the cases where you want to know if
 //! a value was NULL (which gets translated to `None`).
 
+pub use self::from_column::{ColumnBatch, Columns, FromColumn, FromColumns};
 pub use self::from_sql::{FromSql, FromSqlError, FromSqlResult};
 pub use self::to_sql::{ToSql, ToSqlOutput};
 pub use self::value::Value;
+pub(crate) use self::value_ref::{decimal_to_ffi, hugeint_to_ffi};
 pub use self::value_ref::{TimeUnit, ValueRef};
 
+use arrow::datatypes::DataType;
 use std::fmt;
 
 #[cfg(feature = "chrono")]
 mod chrono;
+mod from_column;
 mod from_sql;
 #[cfg(feature = "serde_json")]
 mod serde_json;
@@ -173,6 +178,34 @@ impl fmt::Display for Type {
     }
 }
 
+impl From<&DataType> for Type {
+    fn from(data_type: &DataType) -> Type {
+        match data_type {
+            DataType::Null => Type::Null,
+            DataType::Boolean => Type::Boolean,
+            DataType::Int8 => Type::TinyInt,
+            DataType::Int16 => Type::SmallInt,
+            DataType::Int32 => Type::Int,
+            DataType::Int64 => Type::BigInt,
+            DataType::UInt8 => Type::UTinyInt,
+            DataType::UInt16 => Type::USmallInt,
+            DataType::UInt32 => Type::UInt,
+            DataType::UInt64 => Type::UBigInt,
+            DataType::Float32 => Type::Float,
+            DataType::Float64 => Type::Double,
+            // hugeint: d:38,0
+            DataType::Decimal128(38, 0) => Type::HugeInt,
+            DataType::Decimal128(..) => Type::Decimal,
+            DataType::Timestamp(..) => Type::Timestamp,
+            DataType::Utf8 | DataType::LargeUtf8 => Type::Text,
+            DataType::Binary | DataType::LargeBinary => Type::Blob,
+            DataType::Date32 => Type::Date32,
+            DataType::Time64(_) => Type::Time64,
+            _ => Type::Any,
+        }
+    }
+}
+
 #[cfg(test)]
 mod test {
     use super::Value;
@@ -1,5 +1,6 @@
 use super::{Null, Value, ValueRef};
 use crate::Result;
+use rust_decimal::Decimal;
 use std::borrow::Cow;
 
 /// `ToSqlOutput` represents the possible output types for implementers of the
@@ -56,6 +57,7 @@ from_value!(usize);
 from_value!(f32);
 from_value!(f64);
 from_value!(Vec<u8>);
+from_value!(Decimal);
 
 #[cfg(feature = "uuid")]
 from_value!(uuid::Uuid);
@@ -143,6 +145,7 @@ to_sql_self!(f32);
 to_sql_self!(f64);
 to_sql_self!(u64);
 to_sql_self!(usize);
+to_sql_self!(Decimal);
 
 #[cfg(feature = "uuid")]
 to_sql_self!(uuid::Uuid);
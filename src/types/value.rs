@@ -113,23 +113,28 @@ impl From<i64> for Value {
     }
 }
 
-macro_rules! from_i64(
-    ($t:ty) => (
+macro_rules! from_unsigned(
+    ($t:ty, $variant:ident) => (
         impl From<$t> for Value {
             #[inline]
             fn from(i: $t) -> Value {
-                Value::BigInt(i as i64)
+                Value::$variant(i)
             }
         }
     )
 );
 
-// TODO: need to update duckdb.h to support more type
-// so we can bind the value
-from_i64!(u8);
-from_i64!(u16);
-from_i64!(u32);
-from_i64!(u64);
+from_unsigned!(u8, UTinyInt);
+from_unsigned!(u16, USmallInt);
+from_unsigned!(u32, UInt);
+from_unsigned!(u64, UBigInt);
+
+impl From<Decimal> for Value {
+    #[inline]
+    fn from(d: Decimal) -> Value {
+        Value::Decimal(d)
+    }
+}
 
 impl From<i128> for Value {
     #[inline]
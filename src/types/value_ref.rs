@@ -1,5 +1,7 @@
 use super::{Type, Value};
+use crate::ffi;
 use crate::types::{FromSqlError, FromSqlResult};
+use crate::{Error, Result};
 
 use rust_decimal::prelude::*;
 
@@ -17,6 +19,43 @@ pub enum TimeUnit {
     Nanosecond,
 }
 
+impl TimeUnit {
+    /// `value` in this unit as microseconds, the resolution of DuckDB
+    /// timestamps and times: nanoseconds are rounded down, also before the
+    /// epoch, and seconds or milliseconds that don't fit are an error.
+    #[inline]
+    pub(crate) fn to_micros(self, value: i64) -> Result<i64> {
+        let micros = match self {
+            TimeUnit::Second => value.checked_mul(1_000_000),
+            TimeUnit::Millisecond => value.checked_mul(1_000),
+            TimeUnit::Microsecond => Some(value),
+            TimeUnit::Nanosecond => Some(value.div_euclid(1_000)),
+        };
+        micros.ok_or_else(|| {
+            Error::ToSqlConversionFailure(format!("{} {:?}s out of range of microseconds", value, self).into())
+        })
+    }
+}
+
+#[inline]
+pub(crate) fn hugeint_to_ffi(i: i128) -> ffi::duckdb_hugeint {
+    ffi::duckdb_hugeint {
+        lower: i as u64,
+        upper: (i >> 64) as i64,
+    }
+}
+
+/// A decimal of the widest width, cast by DuckDB to the type of the column or
+/// parameter it's appended to or bound as.
+#[inline]
+pub(crate) fn decimal_to_ffi(d: Decimal) -> ffi::duckdb_decimal {
+    ffi::duckdb_decimal {
+        width: 38,
+        scale: d.scale() as u8,
+        value: hugeint_to_ffi(d.mantissa()),
+    }
+}
+
 /// A non-owning [static type value](https://duckdb.org/docs/sql/data_types/overview). Typically the
 /// memory backing this value is owned by SQLite.
 ///
@@ -0,0 +1,311 @@
+//! Scalar functions implemented in Rust, see [`VScalar`].
+//!
+//! A scalar function is vectorized: it is called with whole chunks of
+//! arguments, one [vector](crate::FlatVector) per parameter, and writes the
+//! results of all their rows to an output vector at once. Many threads of a
+//! query call it at the same time, with different chunks.
+//!
+//! ```rust,no_run
+//! use duckdb::vscalar::VScalar;
+//! use duckdb::vtab::LogicalType;
+//! use duckdb::{ffi, Connection, DataChunk, FlatVectorMut, Result};
+//! use std::error::Error;
+//!
+//! struct Scale;
+//!
+//! impl VScalar for Scale {
+//!     type State = f64;
+//!
+//!     fn parameters() -> Vec<LogicalType> {
+//!         vec![LogicalType::new(ffi::DUCKDB_TYPE_DUCKDB_TYPE_DOUBLE)]
+//!     }
+//!
+//!     fn return_type() -> LogicalType {
+//!         LogicalType::new(ffi::DUCKDB_TYPE_DUCKDB_TYPE_DOUBLE)
+//!     }
+//!
+//!     fn invoke(factor: &f64, input: &DataChunk, output: &mut FlatVectorMut) -> Result<(), Box<dyn Error>> {
+//!         let input = input.vector(0);
+//!         if input.is_constant() {
+//!             output.set_constant();
+//!         }
+//!         let values = output.values_mut::<f64>().unwrap();
+//!         for (value, x) in values.iter_mut().zip(input.values::<f64>().unwrap()) {
+//!             *value = x * factor;
+//!         }
+//!         for row in (0..input.len()).filter(|&row| !input.is_valid(row)) {
+//!             output.set_null(row);
+//!         }
+//!         Ok(())
+//!     }
+//! }
+//!
+//! fn sum_scaled(conn: &Connection) -> Result<f64> {
+//!     conn.register_scalar_function::<Scale>("rust_scale", 2.5)?;
+//!     conn.query_row("SELECT sum(rust_scale(x)) FROM foo", [], |r| r.get(0))
+//! }
+//! ```
+
+use std::error::Error;
+use std::ffi::CString;
+
+use super::ffi;
+use super::{Connection, DataChunk, FlatVectorMut, Result};
+use crate::error::result_from_duckdb_scalar_function;
+use crate::vtab::{catch_errors, drop_raw, into_raw, set_error, LogicalType};
+
+/// A vectorized scalar function implemented in Rust, registered with
+/// [`Connection::register_scalar_function`]
+///
+/// The input chunk of [`invoke`](VScalar::invoke) holds one vector per
+/// parameter. They are flat, except for the constant ones, e.g. of literal
+/// arguments, which hold a single row standing for all of them, see
+/// [`FlatVector::is_constant`](crate::FlatVector::is_constant). NULL arguments
+/// are passed through as well: the function reads them with
+/// [`FlatVector::is_valid`](crate::FlatVector::is_valid) and decides the
+/// validity of its results with
+/// [`FlatVectorMut::set_null`](crate::FlatVectorMut::set_null). An error or a
+/// panic fails the query with its message.
+pub trait VScalar: 'static {
+    /// State of the function, given at its registration and shared by all its
+    /// calls
+    type State: Send + Sync + 'static;
+
+    /// Types of the positional parameters of the function
+    fn parameters() -> Vec<LogicalType>;
+
+    /// Type of the results of the function
+    fn return_type() -> LogicalType;
+
+    /// Whether the function has side effects, e.g. if it's random or reads
+    /// external state
+    ///
+    /// A function without side effects is computed once for constant
+    /// arguments, at planning, and may be reordered or removed by the
+    /// optimizer; one with side effects is called for every row.
+    fn has_side_effects() -> bool {
+        false
+    }
+
+    /// Write the results of the `input.len()` rows of `input` to `output`
+    fn invoke(state: &Self::State, input: &DataChunk, output: &mut FlatVectorMut) -> Result<(), Box<dyn Error>>;
+}
+
+impl Connection {
+    /// Register the scalar function `S` under `name`, with its `state`
+    ///
+    /// See the [module documentation](crate::vscalar) for an example.
+    ///
+    /// # Failure
+    ///
+    /// Will return `Err` if a function with the same name exists
+    pub fn register_scalar_function<S: VScalar>(&self, name: &str, state: S::State) -> Result<()> {
+        let c_name = CString::new(name)?;
+        unsafe {
+            let mut function = ffi::duckdb_create_scalar_function();
+            ffi::duckdb_scalar_function_set_name(function, c_name.as_ptr());
+            for parameter in S::parameters() {
+                ffi::duckdb_scalar_function_add_parameter(function, parameter.ptr);
+            }
+            ffi::duckdb_scalar_function_set_return_type(function, S::return_type().ptr);
+            ffi::duckdb_scalar_function_set_side_effects(
+                function,
+                if S::has_side_effects() {
+                    ffi::duckdb_function_side_effects_DUCKDB_HAS_SIDE_EFFECTS
+                } else {
+                    ffi::duckdb_function_side_effects_DUCKDB_NO_SIDE_EFFECTS
+                },
+            );
+            ffi::duckdb_scalar_function_set_extra_info(function, into_raw(state), Some(drop_raw::<S::State>));
+            ffi::duckdb_scalar_function_set_function(function, Some(invoke::<S>));
+            let r = ffi::duckdb_register_scalar_function(self.db.borrow().con, function);
+            let result = result_from_duckdb_scalar_function(r, function);
+            ffi::duckdb_destroy_scalar_function(&mut function);
+            result
+        }
+    }
+}
+
+unsafe extern "C" fn invoke<S: VScalar>(
+    info: ffi::duckdb_function_info,
+    input: ffi::duckdb_data_chunk,
+    output: ffi::duckdb_vector,
+) {
+    let state = &*(ffi::duckdb_scalar_function_get_extra_info(info) as *const S::State);
+    let input = DataChunk::new_borrowed(input);
+    let mut output = FlatVectorMut::new(output, input.len());
+    if let Err(message) = catch_errors(|| S::invoke(state, &input, &mut output)) {
+        set_error(message, |c_message| {
+            ffi::duckdb_scalar_function_set_error(info, c_message)
+        });
+    }
+}
+
+#[cfg(test)]
+mod test {
+    use std::error::Error;
+    use std::sync::atomic::{AtomicI64, Ordering};
+
+    use super::VScalar;
+    use crate::vtab::LogicalType;
+    use crate::{ffi, Connection, DataChunk, FlatVector, FlatVectorMut, Result};
+
+    // The row of a vector standing for `row` of its chunk.
+    fn row_of(vector: &FlatVector, row: usize) -> usize {
+        if vector.is_constant() {
+            0
+        } else {
+            row
+        }
+    }
+
+    struct Add;
+
+    impl VScalar for Add {
+        type State = ();
+
+        fn parameters() -> Vec<LogicalType> {
+            vec![
+                LogicalType::new(ffi::DUCKDB_TYPE_DUCKDB_TYPE_BIGINT),
+                LogicalType::new(ffi::DUCKDB_TYPE_DUCKDB_TYPE_BIGINT),
+            ]
+        }
+
+        fn return_type() -> LogicalType {
+            LogicalType::new(ffi::DUCKDB_TYPE_DUCKDB_TYPE_BIGINT)
+        }
+
+        fn invoke(_: &(), input: &DataChunk, output: &mut FlatVectorMut) -> Result<(), Box<dyn Error>> {
+            let (a, b) = (input.vector(0), input.vector(1));
+            if a.is_constant() && b.is_constant() {
+                output.set_constant();
+            }
+            let len = a.len().max(b.len());
+            let (a_values, b_values) = (a.values::<i64>().unwrap(), b.values::<i64>().unwrap());
+            for row in 0..len {
+                let (a_row, b_row) = (row_of(&a, row), row_of(&b, row));
+                if !a.is_valid(a_row) || !b.is_valid(b_row) {
+                    output.set_null(row);
+                    continue;
+                }
+                let sum = a_values[a_row]
+                    .checked_add(b_values[b_row])
+                    .ok_or("rust_add overflow")?;
+                output.values_mut::<i64>().unwrap()[row] = sum;
+            }
+            Ok(())
+        }
+    }
+
+    struct Shout;
+
+    impl VScalar for Shout {
+        type State = String;
+
+        fn parameters() -> Vec<LogicalType> {
+            vec![LogicalType::new(ffi::DUCKDB_TYPE_DUCKDB_TYPE_VARCHAR)]
+        }
+
+        fn return_type() -> LogicalType {
+            LogicalType::new(ffi::DUCKDB_TYPE_DUCKDB_TYPE_VARCHAR)
+        }
+
+        fn invoke(suffix: &String, input: &DataChunk, output: &mut FlatVectorMut) -> Result<(), Box<dyn Error>> {
+            let strings = input.vector(0);
+            for row in 0..strings.len() {
+                match strings.get_str(row) {
+                    Some(s) => output.set_str(row, &format!("{}{}", s.to_uppercase(), suffix)),
+                    None => output.set_null(row),
+                }
+            }
+            Ok(())
+        }
+    }
+
+    // Counts its calls, one per row.
+    struct Counter<const SIDE_EFFECTS: bool>;
+
+    impl<const SIDE_EFFECTS: bool> VScalar for Counter<SIDE_EFFECTS> {
+        type State = AtomicI64;
+
+        fn parameters() -> Vec<LogicalType> {
+            vec![LogicalType::new(ffi::DUCKDB_TYPE_DUCKDB_TYPE_BIGINT)]
+        }
+
+        fn return_type() -> LogicalType {
+            LogicalType::new(ffi::DUCKDB_TYPE_DUCKDB_TYPE_BIGINT)
+        }
+
+        fn has_side_effects() -> bool {
+            SIDE_EFFECTS
+        }
+
+        fn invoke(counter: &AtomicI64, input: &DataChunk, output: &mut FlatVectorMut) -> Result<(), Box<dyn Error>> {
+            let len = input.len();
+            let start = counter.fetch_add(len as i64, Ordering::Relaxed);
+            for (row, value) in output.values_mut::<i64>().unwrap()[..len].iter_mut().enumerate() {
+                *value = start + row as i64;
+            }
+            Ok(())
+        }
+    }
+
+    #[test]
+    fn test_scalar_function() -> Result<()> {
+        let db = Connection::open_in_memory()?;
+        db.register_scalar_function::<Add>("rust_add", ())?;
+        db.execute_batch(
+            "CREATE TABLE t AS SELECT CASE WHEN i % 10 = 0 THEN NULL ELSE i END AS i FROM range(10000) tbl(i)",
+        )?;
+
+        // a constant argument, and NULLs
+        let (count, sum): (i64, i64) = db.query_row(
+            "SELECT count(x), sum(x)::BIGINT FROM (SELECT rust_add(i, 10) AS x FROM t)",
+            [],
+            |r| Ok((r.get(0)?, r.get(1)?)),
+        )?;
+        assert_eq!(count, 9000);
+        assert_eq!(sum, (0..10000).filter(|i| i % 10 != 0).map(|i| i + 10).sum::<i64>());
+        let sum: i64 = db.query_row("SELECT sum(rust_add(i, i))::BIGINT FROM t", [], |r| r.get(0))?;
+        assert_eq!(sum, (0..10000).filter(|i| i % 10 != 0).map(|i| 2 * i).sum::<i64>());
+        let sum: i64 = db.query_row("SELECT rust_add(40, 2)", [], |r| r.get(0))?;
+        assert_eq!(sum, 42);
+
+        // errors fail the query
+        assert!(db
+            .query_row("SELECT sum(rust_add(i, 9223372036854775807)) FROM t", [], |r| r
+                .get::<_, i64>(0))
+            .is_err());
+        // with DuckDB's reason
+        let err = db.register_scalar_function::<Add>("rust_add", ()).unwrap_err();
+        assert!(err.to_string().contains("already exists"), "{}", err);
+
+        db.register_scalar_function::<Shout>("rust_shout", "!".to_owned())?;
+        let shouted: Vec<Option<String>> = db
+            .prepare("SELECT rust_shout(s) FROM (VALUES ('hello'), (NULL), ('a longer string')) v(s)")?
+            .query_map([], |r| r.get(0))?
+            .collect::<Result<_>>()?;
+        assert_eq!(
+            shouted,
+            vec![Some("HELLO!".to_owned()), None, Some("A LONGER STRING!".to_owned())]
+        );
+        Ok(())
+    }
+
+    #[test]
+    fn test_scalar_function_side_effects() -> Result<()> {
+        let db = Connection::open_in_memory()?;
+        db.register_scalar_function::<Counter<false>>("rust_pure", AtomicI64::new(0))?;
+        db.register_scalar_function::<Counter<true>>("rust_counter", AtomicI64::new(0))?;
+
+        // folded into a single call for its constant argument
+        let distinct: i64 = db.query_row("SELECT count(DISTINCT rust_pure(1)) FROM range(5000)", [], |r| r.get(0))?;
+        assert_eq!(distinct, 1);
+        // called for every row
+        let distinct: i64 = db.query_row("SELECT count(DISTINCT rust_counter(1)) FROM range(5000)", [], |r| {
+            r.get(0)
+        })?;
+        assert_eq!(distinct, 5000);
+        Ok(())
+    }
+}
@@ -0,0 +1,1053 @@
+//! Table functions implemented in Rust, see [`VTab`], and [`ParallelVTab`]
+//! for the ones scanned by many threads at once.
+//!
+//! A table function is called in the `FROM` clause of a query, like
+//! `SELECT * FROM my_function(42)`. DuckDB binds it once per query, to learn
+//! its columns, initializes the scan and then calls it for chunks of rows until
+//! it returns an empty one. The rows are written straight into the vectors of
+//! the output chunk, without any intermediate table.
+//!
+//! ```rust,no_run
+//! use duckdb::vtab::{BindInfo, InitInfo, LogicalType, VTab};
+//! use duckdb::{ffi, Connection, DataChunk, Result};
+//! use std::error::Error;
+//! use std::sync::atomic::{AtomicI64, Ordering};
+//!
+//! struct Range;
+//!
+//! impl VTab for Range {
+//!     type BindData = i64;
+//!     type InitData = AtomicI64;
+//!
+//!     fn parameters() -> Vec<LogicalType> {
+//!         vec![LogicalType::new(ffi::DUCKDB_TYPE_DUCKDB_TYPE_BIGINT)]
+//!     }
+//!
+//!     fn bind(bind: &BindInfo) -> Result<i64, Box<dyn Error>> {
+//!         bind.add_result_column("i", LogicalType::new(ffi::DUCKDB_TYPE_DUCKDB_TYPE_BIGINT));
+//!         Ok(bind.parameter_i64(0))
+//!     }
+//!
+//!     fn init(_: &InitInfo, _: &i64) -> Result<AtomicI64, Box<dyn Error>> {
+//!         Ok(AtomicI64::new(0))
+//!     }
+//!
+//!     fn func(end: &i64, next: &AtomicI64, output: &mut DataChunk) -> Result<(), Box<dyn Error>> {
+//!         let start = next.load(Ordering::Relaxed);
+//!         let len = (*end - start).clamp(0, output.capacity() as i64) as usize;
+//!         let mut vector = output.vector_mut(0);
+//!         for (i, value) in vector.values_mut::<i64>().unwrap()[..len].iter_mut().enumerate() {
+//!             *value = start + i as i64;
+//!         }
+//!         output.set_len(len);
+//!         next.store(start + len as i64, Ordering::Relaxed);
+//!         Ok(())
+//!     }
+//! }
+//!
+//! fn sum_range(conn: &Connection) -> Result<i64> {
+//!     conn.register_table_function::<Range>("rust_range")?;
+//!     conn.query_row("SELECT sum(i) FROM rust_range(1000)", [], |r| r.get(0))
+//! }
+//! ```
+
+use std::error::Error;
+use std::ffi::{CStr, CString};
+use std::os::raw::{c_char, c_void};
+use std::panic::{self, AssertUnwindSafe};
+use std::str::FromStr;
+
+use super::ffi;
+use super::{Connection, DataChunk, Result};
+use crate::error::error_from_duckdb_code;
+use crate::types::Value;
+
+/// A table function implemented in Rust, registered with
+/// [`Connection::register_table_function`]
+///
+/// The state of a scan is typed: the bind produces the
+/// [`BindData`](VTab::BindData) of the query, the init the
+/// [`InitData`](VTab::InitData) of the scan, and both are handed to every call
+/// of [`func`](VTab::func). DuckDB owns and drops them once the query is
+/// done. An error or a panic of any of the callbacks fails the query with its
+/// message.
+pub trait VTab: 'static {
+    /// Data of a query, e.g. its parameters
+    type BindData: Send + Sync + 'static;
+
+    /// State of a scan, shared by every call of [`func`](VTab::func)
+    type InitData: Send + Sync + 'static;
+
+    /// Types of the positional parameters of the function
+    fn parameters() -> Vec<LogicalType> {
+        Vec::new()
+    }
+
+    /// Whether the function only produces the columns the query needs, see
+    /// [`InitInfo::projected_columns`]
+    fn supports_projection_pushdown() -> bool {
+        false
+    }
+
+    /// Whether the function only produces the rows that pass the filters of
+    /// the query, see [`InitInfo::filters`]
+    fn supports_filter_pushdown() -> bool {
+        false
+    }
+
+    /// Declare the result columns of the function with
+    /// [`BindInfo::add_result_column`] and read its parameters
+    fn bind(bind: &BindInfo) -> Result<Self::BindData, Box<dyn Error>>;
+
+    /// Initialize a scan
+    fn init(init: &InitInfo, bind_data: &Self::BindData) -> Result<Self::InitData, Box<dyn Error>>;
+
+    /// Write the next rows to `output`, setting their number with
+    /// [`DataChunk::set_len`]: the scan ends with a call that writes none
+    fn func(
+        bind_data: &Self::BindData,
+        init_data: &Self::InitData,
+        output: &mut DataChunk,
+    ) -> Result<(), Box<dyn Error>>;
+}
+
+/// A table function scanned by many threads at once, registered with
+/// [`Connection::register_table_function`]
+///
+/// Every thread of the scan calls [`func`](ParallelVTab::func) with the
+/// [`InitData`](ParallelVTab::InitData) shared by all of them and its own
+/// [`LocalInitData`](ParallelVTab::LocalInitData). The shared state hands out
+/// the parts of the scan to the threads, e.g. ranges of rows claimed with an
+/// atomic counter, which they then produce from their own state. The number of
+/// threads is set by [`InitInfo::set_max_threads`] in
+/// [`init`](ParallelVTab::init).
+///
+/// Every [`VTab`] is a `ParallelVTab` with no thread-local state.
+pub trait ParallelVTab: 'static {
+    /// Data of a query, e.g. its parameters
+    type BindData: Send + Sync + 'static;
+
+    /// State of a scan, shared by all its threads
+    type InitData: Send + Sync + 'static;
+
+    /// State of one thread of a scan
+    type LocalInitData: Send + 'static;
+
+    /// Types of the positional parameters of the function
+    fn parameters() -> Vec<LogicalType> {
+        Vec::new()
+    }
+
+    /// Whether the function only produces the columns the query needs, see
+    /// [`InitInfo::projected_columns`]
+    fn supports_projection_pushdown() -> bool {
+        false
+    }
+
+    /// Whether the function only produces the rows that pass the filters of
+    /// the query, see [`InitInfo::filters`]
+    fn supports_filter_pushdown() -> bool {
+        false
+    }
+
+    /// Declare the result columns of the function with
+    /// [`BindInfo::add_result_column`] and read its parameters
+    fn bind(bind: &BindInfo) -> Result<Self::BindData, Box<dyn Error>>;
+
+    /// Initialize a scan, and set the number of its threads
+    fn init(init: &InitInfo, bind_data: &Self::BindData) -> Result<Self::InitData, Box<dyn Error>>;
+
+    /// Initialize the state of a thread of a scan
+    fn init_local(init: &InitInfo, bind_data: &Self::BindData) -> Result<Self::LocalInitData, Box<dyn Error>>;
+
+    /// Write the next rows of the thread to `output`, setting their number
+    /// with [`DataChunk::set_len`]: the thread is done with a call that
+    /// writes none
+    fn func(
+        bind_data: &Self::BindData,
+        init_data: &Self::InitData,
+        local_init_data: &mut Self::LocalInitData,
+        output: &mut DataChunk,
+    ) -> Result<(), Box<dyn Error>>;
+
+    /// The percentage of the scan that is done, between 0 and 100, e.g. for
+    /// the progress bar, `None` if it is unknown
+    fn progress(_bind_data: &Self::BindData, _init_data: &Self::InitData) -> Option<f64> {
+        None
+    }
+
+    /// Whether the scan numbers the rows of the threads with
+    /// [`batch_index`](ParallelVTab::batch_index), which lets queries
+    /// preserve their order, e.g. for a `LIMIT`
+    fn supports_batch_index() -> bool {
+        false
+    }
+
+    /// The index of the batch of the rows the thread produced last
+    ///
+    /// The rows of the scan are split in batches, numbered in their order,
+    /// and the batches a thread produces are increasing.
+    fn batch_index(
+        _bind_data: &Self::BindData,
+        _init_data: &Self::InitData,
+        _local_init_data: &Self::LocalInitData,
+    ) -> usize {
+        0
+    }
+}
+
+impl<T: VTab> ParallelVTab for T {
+    type BindData = T::BindData;
+    type InitData = T::InitData;
+    type LocalInitData = ();
+
+    #[inline]
+    fn parameters() -> Vec<LogicalType> {
+        T::parameters()
+    }
+
+    #[inline]
+    fn supports_projection_pushdown() -> bool {
+        T::supports_projection_pushdown()
+    }
+
+    #[inline]
+    fn supports_filter_pushdown() -> bool {
+        T::supports_filter_pushdown()
+    }
+
+    #[inline]
+    fn bind(bind: &BindInfo) -> Result<T::BindData, Box<dyn Error>> {
+        T::bind(bind)
+    }
+
+    #[inline]
+    fn init(init: &InitInfo, bind_data: &T::BindData) -> Result<T::InitData, Box<dyn Error>> {
+        T::init(init, bind_data)
+    }
+
+    #[inline]
+    fn init_local(_: &InitInfo, _: &T::BindData) -> Result<(), Box<dyn Error>> {
+        Ok(())
+    }
+
+    #[inline]
+    fn func(
+        bind_data: &T::BindData,
+        init_data: &T::InitData,
+        _: &mut (),
+        output: &mut DataChunk,
+    ) -> Result<(), Box<dyn Error>> {
+        T::func(bind_data, init_data, output)
+    }
+}
+
+/// A DuckDB type, e.g. of a result column or a parameter of a table function
+pub struct LogicalType {
+    pub(crate) ptr: ffi::duckdb_logical_type,
+}
+
+impl LogicalType {
+    /// The type with id `type_id`, one of the `ffi::DUCKDB_TYPE_*`
+    /// constants; see [`LogicalType::decimal`] for DECIMAL
+    #[inline]
+    pub fn new(type_id: ffi::duckdb_type) -> LogicalType {
+        LogicalType {
+            ptr: unsafe { ffi::duckdb_create_logical_type(type_id) },
+        }
+    }
+
+    /// DECIMAL(`width`, `scale`)
+    #[inline]
+    pub fn decimal(width: u8, scale: u8) -> LogicalType {
+        LogicalType {
+            ptr: unsafe { ffi::duckdb_create_decimal_type(width, scale) },
+        }
+    }
+
+    /// A list of `child`
+    #[inline]
+    pub fn list(child: &LogicalType) -> LogicalType {
+        LogicalType {
+            ptr: unsafe { ffi::duckdb_create_list_type(child.ptr) },
+        }
+    }
+
+    /// The id of the type, one of the `ffi::DUCKDB_TYPE_*` constants
+    #[inline]
+    pub fn type_id(&self) -> ffi::duckdb_type {
+        unsafe { ffi::duckdb_get_type_id(self.ptr) }
+    }
+}
+
+impl Drop for LogicalType {
+    fn drop(&mut self) {
+        unsafe { ffi::duckdb_destroy_logical_type(&mut self.ptr) };
+    }
+}
+
+/// The bind of a table function, see [`VTab::bind`]
+pub struct BindInfo {
+    ptr: ffi::duckdb_bind_info,
+}
+
+impl BindInfo {
+    /// Add a result column to the output of the function
+    pub fn add_result_column(&self, name: &str, column_type: LogicalType) {
+        let c_name = CString::new(name).unwrap();
+        unsafe { ffi::duckdb_bind_add_result_column(self.ptr, c_name.as_ptr(), column_type.ptr) };
+    }
+
+    /// Number of parameters the function is called with
+    #[inline]
+    pub fn parameter_count(&self) -> usize {
+        unsafe { ffi::duckdb_bind_get_parameter_count(self.ptr) as usize }
+    }
+
+    /// The parameter at `idx` as a string
+    ///
+    /// # Panics
+    ///
+    /// Panics if `idx` is out of range.
+    pub fn parameter_string(&self, idx: usize) -> String {
+        let mut value = self.parameter(idx);
+        unsafe {
+            let c_str = ffi::duckdb_get_varchar(value);
+            let string = CStr::from_ptr(c_str).to_string_lossy().into_owned();
+            ffi::duckdb_free(c_str as *mut c_void);
+            ffi::duckdb_destroy_value(&mut value);
+            string
+        }
+    }
+
+    /// The parameter at `idx` as an integer, 0 if it isn't convertible
+    ///
+    /// # Panics
+    ///
+    /// Panics if `idx` is out of range.
+    pub fn parameter_i64(&self, idx: usize) -> i64 {
+        let mut value = self.parameter(idx);
+        unsafe {
+            let int = ffi::duckdb_get_int64(value);
+            ffi::duckdb_destroy_value(&mut value);
+            int
+        }
+    }
+
+    /// Set the estimated number of rows of the output, used by the optimizer
+    #[inline]
+    pub fn set_cardinality(&self, cardinality: usize, is_exact: bool) {
+        unsafe { ffi::duckdb_bind_set_cardinality(self.ptr, cardinality as u64, is_exact) };
+    }
+
+    fn parameter(&self, idx: usize) -> ffi::duckdb_value {
+        assert!(idx < self.parameter_count(), "parameter index {} out of range", idx);
+        unsafe { ffi::duckdb_bind_get_parameter(self.ptr, idx as u64) }
+    }
+}
+
+/// The initialization of a table function scan, see [`VTab::init`]
+pub struct InitInfo {
+    ptr: ffi::duckdb_init_info,
+}
+
+impl InitInfo {
+    /// The indexes of the result columns the query needs, in the order of the
+    /// columns of the output
+    ///
+    /// Without [projection pushdown](VTab::supports_projection_pushdown), all
+    /// the columns are.
+    pub fn projected_columns(&self) -> Vec<usize> {
+        unsafe {
+            let count = ffi::duckdb_init_get_column_count(self.ptr);
+            (0..count)
+                .map(|idx| ffi::duckdb_init_get_column_index(self.ptr, idx) as usize)
+                .collect()
+        }
+    }
+
+    /// The filters of the query on the columns of the function, by index of
+    /// the column in the [projected columns](InitInfo::projected_columns)
+    ///
+    /// With [filter pushdown](VTab::supports_filter_pushdown), DuckDB no
+    /// longer applies these filters itself: the function must only produce
+    /// the rows that pass all of them. Without it, there are none.
+    pub fn filters(&self) -> Vec<(usize, TableFilter)> {
+        unsafe {
+            let count = ffi::duckdb_init_get_filter_count(self.ptr);
+            (0..count)
+                .map(|idx| {
+                    let mut column = 0;
+                    let filter = ffi::duckdb_init_get_filter(self.ptr, idx, &mut column);
+                    (column as usize, TableFilter::from_raw(filter))
+                })
+                .collect()
+        }
+    }
+
+    /// Set the maximum number of threads calling [`VTab::func`] at once, 1
+    /// by default
+    #[inline]
+    pub fn set_max_threads(&self, max_threads: usize) {
+        unsafe { ffi::duckdb_init_set_max_threads(self.ptr, max_threads as u64) };
+    }
+}
+
+/// A filter on a column pushed down into the scan of a table function, see
+/// [`InitInfo::filters`]
+#[derive(Clone, Debug, PartialEq)]
+pub enum TableFilter {
+    /// The column compared with a constant of its type, e.g. `col > 42`
+    Compare(Comparison, Value),
+    /// `col IS NULL`
+    IsNull,
+    /// `col IS NOT NULL`
+    IsNotNull,
+    /// Any of the filters
+    Or(Vec<TableFilter>),
+    /// All of the filters
+    And(Vec<TableFilter>),
+    /// A filter this version doesn't know, e.g. of a newer DuckDB
+    ///
+    /// DuckDB doesn't apply the filters it pushes down again, so a table
+    /// function that can't apply it must fail the scan rather than produce
+    /// the rows it filters out, see [`TableFilter::is_supported`].
+    Unsupported,
+}
+
+/// The comparison of a [`TableFilter::Compare`], with the column on the left
+/// side
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+pub enum Comparison {
+    /// `=`
+    Equal,
+    /// `<>`
+    NotEqual,
+    /// `<`
+    LessThan,
+    /// `<=`
+    LessThanOrEqual,
+    /// `>`
+    GreaterThan,
+    /// `>=`
+    GreaterThanOrEqual,
+}
+
+impl TableFilter {
+    /// Whether the filter, and all the filters it combines, are known
+    pub fn is_supported(&self) -> bool {
+        match self {
+            TableFilter::Or(filters) | TableFilter::And(filters) => filters.iter().all(TableFilter::is_supported),
+            TableFilter::Unsupported => false,
+            _ => true,
+        }
+    }
+
+    pub(crate) unsafe fn from_raw(filter: ffi::duckdb_table_filter) -> TableFilter {
+        let children = || {
+            (0..ffi::duckdb_table_filter_get_child_count(filter))
+                .map(|idx| TableFilter::from_raw(ffi::duckdb_table_filter_get_child(filter, idx)))
+                .collect()
+        };
+        match ffi::duckdb_table_filter_get_type(filter) {
+            ffi::duckdb_table_filter_type_DUCKDB_TABLE_FILTER_IS_NULL => TableFilter::IsNull,
+            ffi::duckdb_table_filter_type_DUCKDB_TABLE_FILTER_IS_NOT_NULL => TableFilter::IsNotNull,
+            ffi::duckdb_table_filter_type_DUCKDB_TABLE_FILTER_CONJUNCTION_OR => TableFilter::Or(children()),
+            ffi::duckdb_table_filter_type_DUCKDB_TABLE_FILTER_CONJUNCTION_AND => TableFilter::And(children()),
+            ffi::duckdb_table_filter_type_DUCKDB_TABLE_FILTER_CONSTANT_COMPARISON => {
+                let comparison = match ffi::duckdb_table_filter_get_comparison(filter) {
+                    ffi::duckdb_comparison_type_DUCKDB_COMPARE_EQUAL => Comparison::Equal,
+                    ffi::duckdb_comparison_type_DUCKDB_COMPARE_NOT_EQUAL => Comparison::NotEqual,
+                    ffi::duckdb_comparison_type_DUCKDB_COMPARE_LESS_THAN => Comparison::LessThan,
+                    ffi::duckdb_comparison_type_DUCKDB_COMPARE_LESS_THAN_OR_EQUAL => Comparison::LessThanOrEqual,
+                    ffi::duckdb_comparison_type_DUCKDB_COMPARE_GREATER_THAN => Comparison::GreaterThan,
+                    ffi::duckdb_comparison_type_DUCKDB_COMPARE_GREATER_THAN_OR_EQUAL => Comparison::GreaterThanOrEqual,
+                    _ => return TableFilter::Unsupported,
+                };
+                let mut constant = ffi::duckdb_table_filter_get_constant(filter);
+                let value = value_from_raw(constant);
+                ffi::duckdb_destroy_value(&mut constant);
+                TableFilter::Compare(comparison, value)
+            }
+            _ => TableFilter::Unsupported,
+        }
+    }
+}
+
+// The constants of the filters have the type of their column: the text of the
+// values of the types without a lossless conversion through the C API, e.g.
+// dates, is kept.
+unsafe fn value_from_raw(value: ffi::duckdb_value) -> Value {
+    fn parse<T: FromStr>(text: String, into: fn(T) -> Value) -> Value {
+        match text.parse() {
+            Ok(parsed) => into(parsed),
+            Err(_) => Value::Text(text),
+        }
+    }
+
+    let c_str = ffi::duckdb_get_varchar(value);
+    let text = CStr::from_ptr(c_str).to_string_lossy().into_owned();
+    ffi::duckdb_free(c_str as *mut c_void);
+    let int = || ffi::duckdb_get_int64(value);
+    match ffi::duckdb_get_type_id(ffi::duckdb_get_value_type(value)) {
+        ffi::DUCKDB_TYPE_DUCKDB_TYPE_BOOLEAN => Value::Boolean(int() != 0),
+        ffi::DUCKDB_TYPE_DUCKDB_TYPE_TINYINT => Value::TinyInt(int() as i8),
+        ffi::DUCKDB_TYPE_DUCKDB_TYPE_SMALLINT => Value::SmallInt(int() as i16),
+        ffi::DUCKDB_TYPE_DUCKDB_TYPE_INTEGER => Value::Int(int() as i32),
+        ffi::DUCKDB_TYPE_DUCKDB_TYPE_BIGINT => Value::BigInt(int()),
+        ffi::DUCKDB_TYPE_DUCKDB_TYPE_UTINYINT => Value::UTinyInt(int() as u8),
+        ffi::DUCKDB_TYPE_DUCKDB_TYPE_USMALLINT => Value::USmallInt(int() as u16),
+        ffi::DUCKDB_TYPE_DUCKDB_TYPE_UINTEGER => Value::UInt(int() as u32),
+        ffi::DUCKDB_TYPE_DUCKDB_TYPE_UBIGINT => parse(text, Value::UBigInt),
+        ffi::DUCKDB_TYPE_DUCKDB_TYPE_HUGEINT => parse(text, Value::HugeInt),
+        ffi::DUCKDB_TYPE_DUCKDB_TYPE_FLOAT => parse(text, Value::Float),
+        ffi::DUCKDB_TYPE_DUCKDB_TYPE_DOUBLE => parse(text, Value::Double),
+        ffi::DUCKDB_TYPE_DUCKDB_TYPE_DECIMAL => parse(text, Value::Decimal),
+        _ => Value::Text(text),
+    }
+}
+
+impl Connection {
+    /// Register the table function `T`, a [`VTab`] or a [`ParallelVTab`],
+    /// under `name`
+    ///
+    /// See the [module documentation](crate::vtab) for an example.
+    ///
+    /// # Failure
+    ///
+    /// Will return `Err` if a function with the same name and parameters
+    /// exists
+    pub fn register_table_function<T: ParallelVTab>(&self, name: &str) -> Result<()> {
+        let c_name = CString::new(name)?;
+        unsafe {
+            let mut function = ffi::duckdb_create_table_function();
+            ffi::duckdb_table_function_set_name(function, c_name.as_ptr());
+            for parameter in T::parameters() {
+                ffi::duckdb_table_function_add_parameter(function, parameter.ptr);
+            }
+            ffi::duckdb_table_function_supports_projection_pushdown(function, T::supports_projection_pushdown());
+            ffi::duckdb_table_function_supports_filter_pushdown(function, T::supports_filter_pushdown());
+            ffi::duckdb_table_function_set_bind(function, Some(bind::<T>));
+            ffi::duckdb_table_function_set_init(function, Some(init::<T>));
+            ffi::duckdb_table_function_set_local_init(function, Some(init_local::<T>));
+            ffi::duckdb_table_function_set_function(function, Some(func::<T>));
+            ffi::duckdb_table_function_set_progress(function, Some(progress::<T>));
+            if T::supports_batch_index() {
+                ffi::duckdb_table_function_set_batch_index(function, Some(batch_index::<T>));
+            }
+            let r = ffi::duckdb_register_table_function(self.db.borrow().con, function);
+            ffi::duckdb_destroy_table_function(&mut function);
+            if r != ffi::DuckDBSuccess {
+                return error_from_duckdb_code(r, Some(format!("can't register table function {}", name)));
+            }
+        }
+        Ok(())
+    }
+}
+
+// The callbacks of a table function, which report the errors and the panics
+// of `T` to DuckDB.
+
+unsafe extern "C" fn bind<T: ParallelVTab>(info: ffi::duckdb_bind_info) {
+    let bind_info = BindInfo { ptr: info };
+    match catch_errors(|| T::bind(&bind_info)) {
+        Ok(data) => ffi::duckdb_bind_set_bind_data(info, into_raw(data), Some(drop_raw::<T::BindData>)),
+        Err(message) => set_error(message, |c_message| ffi::duckdb_bind_set_error(info, c_message)),
+    }
+}
+
+unsafe extern "C" fn init<T: ParallelVTab>(info: ffi::duckdb_init_info) {
+    let init_info = InitInfo { ptr: info };
+    let bind_data = &*(ffi::duckdb_init_get_bind_data(info) as *const T::BindData);
+    match catch_errors(|| T::init(&init_info, bind_data)) {
+        Ok(data) => ffi::duckdb_init_set_init_data(info, into_raw(data), Some(drop_raw::<T::InitData>)),
+        Err(message) => set_error(message, |c_message| ffi::duckdb_init_set_error(info, c_message)),
+    }
+}
+
+unsafe extern "C" fn init_local<T: ParallelVTab>(info: ffi::duckdb_init_info) {
+    let init_info = InitInfo { ptr: info };
+    let bind_data = &*(ffi::duckdb_init_get_bind_data(info) as *const T::BindData);
+    match catch_errors(|| T::init_local(&init_info, bind_data)) {
+        Ok(data) => ffi::duckdb_init_set_init_data(info, into_raw(data), Some(drop_raw::<T::LocalInitData>)),
+        Err(message) => set_error(message, |c_message| ffi::duckdb_init_set_error(info, c_message)),
+    }
+}
+
+unsafe extern "C" fn func<T: ParallelVTab>(info: ffi::duckdb_function_info, output: ffi::duckdb_data_chunk) {
+    let bind_data = &*(ffi::duckdb_function_get_bind_data(info) as *const T::BindData);
+    let init_data = &*(ffi::duckdb_function_get_init_data(info) as *const T::InitData);
+    // only ever used by the thread it belongs to
+    let local_init_data = &mut *(ffi::duckdb_function_get_local_init_data(info) as *mut T::LocalInitData);
+    let mut output = DataChunk::new_borrowed(output);
+    if let Err(message) = catch_errors(|| T::func(bind_data, init_data, local_init_data, &mut output)) {
+        set_error(message, |c_message| ffi::duckdb_function_set_error(info, c_message));
+    }
+}
+
+unsafe extern "C" fn progress<T: ParallelVTab>(bind_data: *mut c_void, init_data: *mut c_void) -> f64 {
+    let bind_data = &*(bind_data as *const T::BindData);
+    let init_data = &*(init_data as *const T::InitData);
+    panic::catch_unwind(AssertUnwindSafe(|| T::progress(bind_data, init_data)))
+        .ok()
+        .flatten()
+        .map_or(-1.0, |progress| progress.clamp(0.0, 100.0))
+}
+
+unsafe extern "C" fn batch_index<T: ParallelVTab>(
+    bind_data: *mut c_void,
+    init_data: *mut c_void,
+    local_init_data: *mut c_void,
+) -> ffi::idx_t {
+    let bind_data = &*(bind_data as *const T::BindData);
+    let init_data = &*(init_data as *const T::InitData);
+    let local_init_data = &*(local_init_data as *const T::LocalInitData);
+    panic::catch_unwind(AssertUnwindSafe(|| {
+        T::batch_index(bind_data, init_data, local_init_data)
+    }))
+    .unwrap_or(0) as ffi::idx_t
+}
+
+pub(crate) fn catch_errors<R>(f: impl FnOnce() -> Result<R, Box<dyn Error>>) -> Result<R, String> {
+    match panic::catch_unwind(AssertUnwindSafe(f)) {
+        Ok(Ok(result)) => Ok(result),
+        Ok(Err(err)) => Err(err.to_string()),
+        Err(_) => Err("function panicked".to_owned()),
+    }
+}
+
+pub(crate) fn set_error(message: String, set: impl FnOnce(*const c_char)) {
+    let c_message = CString::new(message.replace('\0', "")).unwrap();
+    set(c_message.as_ptr());
+}
+
+#[inline]
+pub(crate) fn into_raw<D>(data: D) -> *mut c_void {
+    Box::into_raw(Box::new(data)) as *mut c_void
+}
+
+pub(crate) unsafe extern "C" fn drop_raw<D>(data: *mut c_void) {
+    drop(Box::from_raw(data as *mut D));
+}
+
+#[cfg(test)]
+mod test {
+    use std::cmp;
+    use std::error::Error;
+    use std::sync::atomic::{AtomicUsize, Ordering};
+    use std::sync::Mutex;
+
+    use super::{BindInfo, Comparison, InitInfo, LogicalType, ParallelVTab, TableFilter, VTab};
+    use crate::types::Value;
+    use crate::{ffi, Connection, DataChunk, Result};
+
+    // Rows of (id, name, even), with a NULL name every ten rows.
+    struct People;
+
+    struct PeopleBind {
+        count: usize,
+        prefix: String,
+    }
+
+    struct PeopleInit {
+        columns: Vec<usize>,
+        next: AtomicUsize,
+    }
+
+    impl VTab for People {
+        type BindData = PeopleBind;
+        type InitData = PeopleInit;
+
+        fn parameters() -> Vec<LogicalType> {
+            vec![
+                LogicalType::new(ffi::DUCKDB_TYPE_DUCKDB_TYPE_BIGINT),
+                LogicalType::new(ffi::DUCKDB_TYPE_DUCKDB_TYPE_VARCHAR),
+            ]
+        }
+
+        fn supports_projection_pushdown() -> bool {
+            true
+        }
+
+        fn bind(bind: &BindInfo) -> Result<PeopleBind, Box<dyn Error>> {
+            let count = bind.parameter_i64(0);
+            if count < 0 {
+                return Err(format!("negative count {}", count).into());
+            }
+            bind.add_result_column("id", LogicalType::new(ffi::DUCKDB_TYPE_DUCKDB_TYPE_INTEGER));
+            bind.add_result_column("name", LogicalType::new(ffi::DUCKDB_TYPE_DUCKDB_TYPE_VARCHAR));
+            bind.add_result_column("even", LogicalType::new(ffi::DUCKDB_TYPE_DUCKDB_TYPE_BOOLEAN));
+            bind.set_cardinality(count as usize, true);
+            Ok(PeopleBind {
+                count: count as usize,
+                prefix: bind.parameter_string(1),
+            })
+        }
+
+        fn init(init: &InitInfo, _: &PeopleBind) -> Result<PeopleInit, Box<dyn Error>> {
+            Ok(PeopleInit {
+                columns: init.projected_columns(),
+                next: AtomicUsize::new(0),
+            })
+        }
+
+        fn func(bind: &PeopleBind, init: &PeopleInit, output: &mut DataChunk) -> Result<(), Box<dyn Error>> {
+            let start = init.next.load(Ordering::Relaxed);
+            let len = (bind.count - start).min(output.capacity());
+            for (idx, &column) in init.columns.iter().enumerate() {
+                let mut vector = output.vector_mut(idx);
+                for row in 0..len {
+                    let id = start + row;
+                    match column {
+                        0 => vector.values_mut::<i32>().unwrap()[row] = id as i32,
+                        1 if id % 10 == 0 => vector.set_null(row),
+                        1 => vector.set_str(row, &format!("{} {}", bind.prefix, id)),
+                        _ => vector.set_bool(row, id % 2 == 0),
+                    }
+                }
+            }
+            output.set_len(len);
+            init.next.store(start + len, Ordering::Relaxed);
+            Ok(())
+        }
+    }
+
+    #[test]
+    fn test_table_function() -> Result<()> {
+        let db = Connection::open_in_memory()?;
+        db.register_table_function::<People>("people")?;
+
+        let (count, sum, names, evens): (i64, i64, i64, i64) = db.query_row(
+            "SELECT count(*), sum(id), count(name), count(*) FILTER (WHERE even) FROM people(5000, 'person')",
+            [],
+            |r| Ok((r.get(0)?, r.get(1)?, r.get(2)?, r.get(3)?)),
+        )?;
+        assert_eq!(count, 5000);
+        assert_eq!(sum, (0..5000).sum::<i64>());
+        assert_eq!(names, 4500);
+        assert_eq!(evens, 2500);
+
+        // only the projected columns are produced, in the order of the query
+        let (name, id): (String, i32) =
+            db.query_row("SELECT name, id FROM people(100, 'p') WHERE id = 42", [], |r| {
+                Ok((r.get(0)?, r.get(1)?))
+            })?;
+        assert_eq!(name, "p 42");
+        assert_eq!(id, 42);
+
+        let count: i64 = db.query_row("SELECT count(*) FROM people(0, '')", [], |r| r.get(0))?;
+        assert_eq!(count, 0);
+
+        let err = db
+            .query_row("SELECT * FROM people(-1, '')", [], |r| r.get::<_, i32>(0))
+            .unwrap_err();
+        assert!(err.to_string().contains("negative count -1"), "{}", err);
+        Ok(())
+    }
+
+    // A single row of the parameters of the function, read at bind time.
+    struct Parameters;
+
+    struct ParametersInit {
+        done: AtomicUsize,
+    }
+
+    impl VTab for Parameters {
+        type BindData = (i64, String);
+        type InitData = ParametersInit;
+
+        fn parameters() -> Vec<LogicalType> {
+            vec![
+                LogicalType::new(ffi::DUCKDB_TYPE_DUCKDB_TYPE_BIGINT),
+                LogicalType::new(ffi::DUCKDB_TYPE_DUCKDB_TYPE_VARCHAR),
+            ]
+        }
+
+        fn bind(bind: &BindInfo) -> Result<(i64, String), Box<dyn Error>> {
+            bind.add_result_column("int", LogicalType::new(ffi::DUCKDB_TYPE_DUCKDB_TYPE_BIGINT));
+            bind.add_result_column("string", LogicalType::new(ffi::DUCKDB_TYPE_DUCKDB_TYPE_VARCHAR));
+            Ok((bind.parameter_i64(0), bind.parameter_string(1)))
+        }
+
+        fn init(_: &InitInfo, _: &(i64, String)) -> Result<ParametersInit, Box<dyn Error>> {
+            Ok(ParametersInit {
+                done: AtomicUsize::new(0),
+            })
+        }
+
+        fn func(bind: &(i64, String), init: &ParametersInit, output: &mut DataChunk) -> Result<(), Box<dyn Error>> {
+            if init.done.swap(1, Ordering::Relaxed) == 0 {
+                output.vector_mut(0).values_mut::<i64>().unwrap()[0] = bind.0;
+                output.vector_mut(1).set_str(0, &bind.1);
+                output.set_len(1);
+            } else {
+                output.set_len(0);
+            }
+            Ok(())
+        }
+    }
+
+    #[test]
+    fn test_table_function_parameters() -> Result<()> {
+        let db = Connection::open_in_memory()?;
+        db.register_table_function::<Parameters>("parameters")?;
+
+        for int in [0, -1, 42, i64::MIN, i64::MAX] {
+            let sql = format!("SELECT * FROM parameters({}, 'text {}')", int, int);
+            let row: (i64, String) = db.query_row(&sql, [], |r| Ok((r.get(0)?, r.get(1)?)))?;
+            assert_eq!(row, (int, format!("text {}", int)));
+        }
+        Ok(())
+    }
+
+    // The integers up to a count, produced by ranges of BATCH claimed by the
+    // threads of the scan.
+    struct Ranges;
+
+    const BATCH: usize = 10000;
+
+    struct RangesInit {
+        next: AtomicUsize,
+        done: AtomicUsize,
+    }
+
+    struct RangesLocal {
+        batch: usize,
+        rows: std::ops::Range<usize>,
+    }
+
+    impl ParallelVTab for Ranges {
+        type BindData = usize;
+        type InitData = RangesInit;
+        type LocalInitData = RangesLocal;
+
+        fn parameters() -> Vec<LogicalType> {
+            vec![LogicalType::new(ffi::DUCKDB_TYPE_DUCKDB_TYPE_BIGINT)]
+        }
+
+        fn bind(bind: &BindInfo) -> Result<usize, Box<dyn Error>> {
+            bind.add_result_column("i", LogicalType::new(ffi::DUCKDB_TYPE_DUCKDB_TYPE_BIGINT));
+            Ok(bind.parameter_i64(0) as usize)
+        }
+
+        fn init(init: &InitInfo, count: &usize) -> Result<RangesInit, Box<dyn Error>> {
+            init.set_max_threads(count / BATCH + 1);
+            Ok(RangesInit {
+                next: AtomicUsize::new(0),
+                done: AtomicUsize::new(0),
+            })
+        }
+
+        fn init_local(_: &InitInfo, _: &usize) -> Result<RangesLocal, Box<dyn Error>> {
+            Ok(RangesLocal { batch: 0, rows: 0..0 })
+        }
+
+        fn func(
+            count: &usize,
+            init: &RangesInit,
+            local: &mut RangesLocal,
+            output: &mut DataChunk,
+        ) -> Result<(), Box<dyn Error>> {
+            if local.rows.is_empty() {
+                let batch = init.next.fetch_add(1, Ordering::Relaxed);
+                local.batch = batch;
+                local.rows = (batch * BATCH).min(*count)..((batch + 1) * BATCH).min(*count);
+            }
+            let len = local.rows.len().min(output.capacity());
+            let mut vector = output.vector_mut(0);
+            for (value, i) in vector.values_mut::<i64>().unwrap().iter_mut().zip(local.rows.start..) {
+                *value = i as i64;
+            }
+            output.set_len(len);
+            local.rows.start += len;
+            init.done.fetch_add(len, Ordering::Relaxed);
+            Ok(())
+        }
+
+        fn progress(count: &usize, init: &RangesInit) -> Option<f64> {
+            Some(100.0 * init.done.load(Ordering::Relaxed) as f64 / (*count).max(1) as f64)
+        }
+
+        fn supports_batch_index() -> bool {
+            true
+        }
+
+        fn batch_index(_: &usize, _: &RangesInit, local: &RangesLocal) -> usize {
+            local.batch
+        }
+    }
+
+    #[test]
+    fn test_parallel_table_function() -> Result<()> {
+        let db = Connection::open_in_memory()?;
+        db.execute_batch("PRAGMA threads=4")?;
+        db.register_table_function::<Ranges>("ranges")?;
+
+        let (count, sum, distinct): (i64, i64, i64) = db.query_row(
+            "SELECT count(*), sum(i), count(DISTINCT i) FROM ranges(1000000)",
+            [],
+            |r| Ok((r.get(0)?, r.get(1)?, r.get(2)?)),
+        )?;
+        assert_eq!(count, 1000000);
+        assert_eq!(sum, (0..1000000).sum::<i64>());
+        assert_eq!(distinct, 1000000);
+
+        // the batch indexes keep the order of the rows
+        let rows: Vec<i64> = db
+            .prepare("SELECT i FROM ranges(1000000) LIMIT 3 OFFSET 654321")?
+            .query_map([], |r| r.get(0))?
+            .collect::<Result<_>>()?;
+        assert_eq!(rows, vec![654321, 654322, 654323]);
+
+        let count: i64 = db.query_row("SELECT count(*) FROM ranges(12345)", [], |r| r.get(0))?;
+        assert_eq!(count, 12345);
+        Ok(())
+    }
+
+    // Rows of (i, s), with a NULL s for odd i, which only produces the rows
+    // passing the filters of the query.
+    struct Filtered;
+
+    struct FilteredInit {
+        filters: Vec<(usize, TableFilter)>,
+        next: AtomicUsize,
+    }
+
+    static FILTERS: Mutex<Vec<(usize, TableFilter)>> = Mutex::new(Vec::new());
+
+    fn passes(filter: &TableFilter, value: &Value) -> bool {
+        match filter {
+            TableFilter::IsNull => *value == Value::Null,
+            TableFilter::IsNotNull => *value != Value::Null,
+            TableFilter::Or(filters) => filters.iter().any(|filter| passes(filter, value)),
+            TableFilter::And(filters) => filters.iter().all(|filter| passes(filter, value)),
+            TableFilter::Unsupported => unreachable!("declined by init"),
+            TableFilter::Compare(comparison, constant) => {
+                let ordering = match (value, constant) {
+                    (Value::BigInt(a), Value::BigInt(b)) => a.cmp(b),
+                    (Value::Text(a), Value::Text(b)) => a.cmp(b),
+                    _ => return false,
+                };
+                match comparison {
+                    Comparison::Equal => ordering == cmp::Ordering::Equal,
+                    Comparison::NotEqual => ordering != cmp::Ordering::Equal,
+                    Comparison::LessThan => ordering == cmp::Ordering::Less,
+                    Comparison::LessThanOrEqual => ordering != cmp::Ordering::Greater,
+                    Comparison::GreaterThan => ordering == cmp::Ordering::Greater,
+                    Comparison::GreaterThanOrEqual => ordering != cmp::Ordering::Less,
+                }
+            }
+        }
+    }
+
+    impl VTab for Filtered {
+        type BindData = usize;
+        type InitData = FilteredInit;
+
+        fn parameters() -> Vec<LogicalType> {
+            vec![LogicalType::new(ffi::DUCKDB_TYPE_DUCKDB_TYPE_BIGINT)]
+        }
+
+        fn supports_filter_pushdown() -> bool {
+            true
+        }
+
+        fn bind(bind: &BindInfo) -> Result<usize, Box<dyn Error>> {
+            bind.add_result_column("i", LogicalType::new(ffi::DUCKDB_TYPE_DUCKDB_TYPE_BIGINT));
+            bind.add_result_column("s", LogicalType::new(ffi::DUCKDB_TYPE_DUCKDB_TYPE_VARCHAR));
+            Ok(bind.parameter_i64(0) as usize)
+        }
+
+        fn init(init: &InitInfo, _: &usize) -> Result<FilteredInit, Box<dyn Error>> {
+            let filters = init.filters();
+            if let Some((_, filter)) = filters.iter().find(|(_, filter)| !filter.is_supported()) {
+                return Err(format!("unsupported filter {:?}", filter).into());
+            }
+            *FILTERS.lock().unwrap() = filters.clone();
+            Ok(FilteredInit {
+                filters,
+                next: AtomicUsize::new(0),
+            })
+        }
+
+        fn func(count: &usize, init: &FilteredInit, output: &mut DataChunk) -> Result<(), Box<dyn Error>> {
+            let mut len = 0;
+            let mut next = init.next.load(Ordering::Relaxed);
+            while len < output.capacity() && next < *count {
+                let row = [
+                    Value::BigInt(next as i64),
+                    if next % 2 == 0 {
+                        Value::Text(format!("s{}", next))
+                    } else {
+                        Value::Null
+                    },
+                ];
+                next += 1;
+                if !init
+                    .filters
+                    .iter()
+                    .all(|(column, filter)| passes(filter, &row[*column]))
+                {
+                    continue;
+                }
+                output.vector_mut(0).values_mut::<i64>().unwrap()[len] = match row[0] {
+                    Value::BigInt(i) => i,
+                    _ => unreachable!(),
+                };
+                match &row[1] {
+                    Value::Text(s) => output.vector_mut(1).set_str(len, s),
+                    _ => output.vector_mut(1).set_null(len),
+                }
+                len += 1;
+            }
+            output.set_len(len);
+            init.next.store(next, Ordering::Relaxed);
+            Ok(())
+        }
+    }
+
+    #[test]
+    fn test_table_function_filter_pushdown() -> Result<()> {
+        let db = Connection::open_in_memory()?;
+        db.register_table_function::<Filtered>("filtered")?;
+
+        let (count, sum): (i64, i64) = db.query_row(
+            "SELECT count(*), sum(i) FROM filtered(10000) WHERE i >= 10 AND i < 20",
+            [],
+            |r| Ok((r.get(0)?, r.get(1)?)),
+        )?;
+        assert_eq!((count, sum), (10, (10..20).sum::<i64>()));
+        let filters = FILTERS.lock().unwrap().clone();
+        assert_eq!(filters.len(), 1);
+        match &filters[0] {
+            (0, TableFilter::And(children)) => {
+                assert!(children.contains(&TableFilter::Compare(Comparison::GreaterThanOrEqual, Value::BigInt(10))));
+                assert!(children.contains(&TableFilter::Compare(Comparison::LessThan, Value::BigInt(20))));
+            }
+            filter => panic!("unexpected filter {:?}", filter),
+        }
+
+        let count: i64 = db.query_row(
+            "SELECT count(*) FROM filtered(10000) WHERE s IS NOT NULL AND i > 9000",
+            [],
+            |r| r.get(0),
+        )?;
+        assert_eq!(count, 499);
+        let s: String = db.query_row("SELECT s FROM filtered(10000) WHERE s = 's42'", [], |r| r.get(0))?;
+        assert_eq!(s, "s42");
+
+        // without filters, all the rows are produced
+        let count: i64 = db.query_row("SELECT count(*) FROM filtered(10000)", [], |r| r.get(0))?;
+        assert_eq!(count, 10000);
+        assert!(FILTERS.lock().unwrap().is_empty());
+        Ok(())
+    }
+
+    #[test]
+    fn test_table_filter_is_supported() {
+        let compare = TableFilter::Compare(Comparison::Equal, Value::BigInt(1));
+        assert!(TableFilter::And(vec![compare.clone(), TableFilter::IsNull]).is_supported());
+        assert!(!TableFilter::Unsupported.is_supported());
+        assert!(!TableFilter::Or(vec![compare, TableFilter::And(vec![TableFilter::Unsupported])]).is_supported());
+    }
+}